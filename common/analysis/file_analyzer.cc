@@ -90,6 +90,7 @@ util::Status FileAnalyzer::Parse(Parser* parser) {
   const util::Status status = parser->Parse();
   // Transfer syntax tree root, even if there were (recovered) syntax errors,
   // because the partial tree can still be useful to analyze.
+  MutableData().AdoptSyntaxTreeArena(parser->TakeArena());
   MutableData().MutableSyntaxTree() = parser->TakeRoot();
   if (status.ok()) {
     CHECK(SyntaxTree().get()) << "Expected syntax tree from parsing \""
@@ -40,11 +40,14 @@
 #define VERIBLE_COMMON_ANALYSIS_FILE_ANALYZER_H_
 
 #include <iosfwd>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/lexer/lexer.h"
 #include "common/parser/parse.h"
+#include "common/strings/mem_block.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 #include "common/util/status.h"
@@ -75,6 +78,19 @@ class FileAnalyzer : public TextStructure {
   explicit FileAnalyzer(absl::string_view contents, absl::string_view filename)
       : TextStructure(contents), filename_(filename), rejected_tokens_() {}
 
+  // Shares ownership of 'contents' (e.g. a memory-mapped file) without copy.
+  FileAnalyzer(std::shared_ptr<MemBlock> contents, absl::string_view filename)
+      : TextStructure(std::move(contents)),
+        filename_(filename),
+        rejected_tokens_() {}
+
+  // Analyzes only 'substring' of 'contents', in place.
+  FileAnalyzer(std::shared_ptr<MemBlock> contents, absl::string_view substring,
+               absl::string_view filename)
+      : TextStructure(std::move(contents), substring),
+        filename_(filename),
+        rejected_tokens_() {}
+
   virtual ~FileAnalyzer() {}
 
   virtual util::Status Tokenize() = 0;
@@ -23,6 +23,7 @@
 
 #include "absl/strings/string_view.h"
 #include "common/analysis/lint_rule.h"
+#include "common/strings/line_scan.h"
 
 namespace verible {
 
@@ -33,6 +34,13 @@ class LineLintRule : public LintRule {
   // Scans a single line during analysis.
   virtual void HandleLine(absl::string_view line) = 0;
 
+  // Scans a single line whose tab and trailing whitespace positions have
+  // already been computed (see ScanLines()).  Rules that only need those
+  // positions should override this to avoid rescanning the line.
+  virtual void HandleScannedLine(absl::string_view line, const LineStats&) {
+    HandleLine(line);
+  }
+
   // Analyze the final state of the rule, after the last line has been read.
   virtual void Finalize() {}
 };
@@ -14,12 +14,14 @@
 
 #include "common/analysis/line_linter.h"
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
 #include "absl/strings/string_view.h"
 #include "common/analysis/line_lint_rule.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_scan.h"
 #include "common/util/logging.h"
 
 namespace verible {
@@ -36,6 +38,20 @@ void LineLinter::Lint(const std::vector<absl::string_view>& lines) {
   }
 }
 
+void LineLinter::Lint(const std::vector<absl::string_view>& lines,
+                      const std::vector<LineStats>& stats) {
+  VLOG(1) << "LineLinter analyzing lines with " << rules_.size() << " rules.";
+  CHECK_EQ(lines.size(), stats.size());
+  for (size_t i = 0; i < lines.size(); ++i) {
+    for (const auto& rule : rules_) {
+      ABSL_DIE_IF_NULL(rule)->HandleScannedLine(lines[i], stats[i]);
+    }
+  }
+  for (const auto& rule : rules_) {
+    rule->Finalize();
+  }
+}
+
 std::vector<LintRuleStatus> LineLinter::ReportStatus() const {
   std::vector<LintRuleStatus> status;
   for (const auto& rule : rules_) {
@@ -26,6 +26,7 @@
 #include "absl/strings/string_view.h"
 #include "common/analysis/line_lint_rule.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_scan.h"
 
 namespace verible {
 
@@ -34,6 +35,11 @@ class LineLinter {
   // Analyzes a sequence of lines.
   void Lint(const std::vector<absl::string_view>& lines);
 
+  // Analyzes a sequence of lines, with their precomputed per-line 'stats'
+  // (e.g. TextStructureView::GetLineStats()).
+  void Lint(const std::vector<absl::string_view>& lines,
+            const std::vector<LineStats>& stats);
+
   // Transfers ownership of rule into this Linter
   void AddRule(std::unique_ptr<LineLintRule> rule) {
     rules_.emplace_back(std::move(rule));
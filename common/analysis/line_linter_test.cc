@@ -23,6 +23,7 @@
 #include "absl/strings/string_view.h"
 #include "common/analysis/line_lint_rule.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_scan.h"
 #include "common/text/token_info.h"
 
 namespace verible {
@@ -87,6 +88,19 @@ TEST(LineLinterTest, OneRuleRejectsLine) {
   EXPECT_THAT(statuses[0].violations, SizeIs(1));
 }
 
+// This test verifies that LineLinter forwards precomputed line stats.
+TEST(LineLinterTest, ScannedLinesUseDefaultHandler) {
+  std::vector<absl::string_view> lines;
+  std::vector<LineStats> stats;
+  ScanLines("abc\n\ndef", &lines, &stats);
+  LineLinter linter;
+  linter.AddRule(MakeBlankLineRule());
+  linter.Lint(lines, stats);
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  EXPECT_THAT(statuses, SizeIs(1));
+  EXPECT_THAT(statuses[0].violations, SizeIs(1));
+}
+
 // Mock rule that rejects empty files.
 class EmptyFileRule : public LineLintRule {
  public:
@@ -51,9 +51,11 @@ void LintStatusFormatter::FormatLintRuleStatus(std::ostream* stream,
                                                const LintRuleStatus& status,
                                                absl::string_view base,
                                                absl::string_view path) const {
+  // Violations are ordered by location.
+  LineColumnMap::Cursor line_column(line_column_map_);
   for (const auto& violation : status.violations) {
-    FormatViolation(stream, violation, base, path, status.url,
-                    status.lint_rule_name);
+    FormatViolation(stream, violation, line_column(violation.token.left(base)),
+                    path, status.url, status.lint_rule_name);
     (*stream) << std::endl;
   }
 }
@@ -83,8 +85,10 @@ void LintStatusFormatter::FormatLintRuleStatuses(
     }
   }
 
+  LineColumnMap::Cursor line_column(line_column_map_);
   for (auto violation : violations) {
-    FormatViolation(stream, *violation.violation, base, path,
+    FormatViolation(stream, *violation.violation,
+                    line_column(violation.violation->token.left(base)), path,
                     violation.status->url, violation.status->lint_rule_name);
     *stream << std::endl;
   }
@@ -98,11 +102,21 @@ void LintStatusFormatter::FormatViolation(std::ostream* stream,
                                           absl::string_view path,
                                           absl::string_view url,
                                           absl::string_view rule_name) const {
+  FormatViolation(stream, violation,
+                  line_column_map_(violation.token.left(base)), path, url,
+                  rule_name);
+}
+
+void LintStatusFormatter::FormatViolation(std::ostream* stream,
+                                          const LintViolation& violation,
+                                          const LineColumn& line_column,
+                                          absl::string_view path,
+                                          absl::string_view url,
+                                          absl::string_view rule_name) const {
   // TODO(fangism): Use the context member to print which named construct or
   // design element the violation appears in (or full stack thereof).
-  (*stream) << path << ':' << line_column_map_(violation.token.left(base))
-            << ": " << violation.reason << ' ' << url << " [" << rule_name
-            << ']';
+  (*stream) << path << ':' << line_column << ": " << violation.reason << ' '
+            << url << " [" << rule_name << ']';
 }
 
 void LintRuleStatus::WaiveViolations(
@@ -111,7 +111,18 @@ class LintStatusFormatter {
   // Constructor takes a reference to the original text in order to setup
   // line_column_map
   explicit LintStatusFormatter(absl::string_view text)
-      : line_column_map_(text) {}
+      : owned_line_column_map_(text),
+        line_column_map_(owned_line_column_map_) {}
+
+  // Shares an already computed 'line_column_map' of the original text,
+  // e.g. TextStructureView::GetLineColumnMap(), which must outlive this.
+  explicit LintStatusFormatter(const LineColumnMap& line_column_map)
+      : owned_line_column_map_(std::vector<absl::string_view>()),
+        line_column_map_(line_column_map) {}
+
+  // Do not copy: line_column_map_ may refer to owned_line_column_map_.
+  LintStatusFormatter(const LintStatusFormatter&) = delete;
+  LintStatusFormatter& operator=(const LintStatusFormatter&) = delete;
 
   // Formats and outputs status to stream.
   // Path is the file path of original file. This is needed because it is not
@@ -145,9 +156,17 @@ class LintStatusFormatter {
                        absl::string_view rule_name) const;
 
  private:
+  void FormatViolation(std::ostream* stream, const LintViolation& violation,
+                       const LineColumn& line_column, absl::string_view path,
+                       absl::string_view url,
+                       absl::string_view rule_name) const;
+
+  // Only used when constructed from text.
+  const LineColumnMap owned_line_column_map_;
+
   // Translates byte offsets, which are supplied by LintViolations via
   // locations field, to line:column
-  LineColumnMap line_column_map_;
+  const LineColumnMap& line_column_map_;
 };
 
 }  // namespace verible
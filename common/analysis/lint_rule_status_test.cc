@@ -22,6 +22,7 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "common/text/concrete_syntax_tree.h"
+#include "common/text/line_column_map.h"
 #include "common/text/token_info.h"
 #include "common/text/tree_builder_test_util.h"
 
@@ -130,6 +131,36 @@ TEST(LintRuleStatusFormatterTest, SimpleOutput) {
   RunLintStatusTest(test);
 }
 
+TEST(LintRuleStatusFormatterTest, SharedLineColumnMap) {
+  constexpr absl::string_view text(
+      "first line\n"
+      "second line\n"
+      "third line\n");
+  LintRuleStatus status;
+  status.url = "http://foobar";
+  status.lint_rule_name = "test-rule";
+  for (const auto& violation : {
+           LintViolation(TokenInfo(0, text.substr(13, 3)), "a"),
+           LintViolation(TokenInfo(0, text.substr(2, 1)), "b"),
+           LintViolation(TokenInfo(0, text.substr(28, 4)), "c"),
+       }) {
+    status.violations.insert(violation);
+  }
+
+  std::ostringstream owned_map_output;
+  LintStatusFormatter(text).FormatLintRuleStatus(&owned_map_output, status,
+                                                 text, "f.sv");
+  const LineColumnMap line_column_map(text);
+  std::ostringstream shared_map_output;
+  LintStatusFormatter(line_column_map)
+      .FormatLintRuleStatus(&shared_map_output, status, text, "f.sv");
+  EXPECT_EQ(shared_map_output.str(), owned_map_output.str());
+  EXPECT_EQ(shared_map_output.str(),
+            "f.sv:1:3: b http://foobar [test-rule]\n"
+            "f.sv:2:3: a http://foobar [test-rule]\n"
+            "f.sv:3:6: c http://foobar [test-rule]\n");
+}
+
 TEST(LintRuleStatusFormatterTest, NoOutput) {
   SymbolPtr root = Node();
   LintStatusTest test = {"cool-rule",
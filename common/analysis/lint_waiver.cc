@@ -26,7 +26,9 @@
 
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
 #include "common/strings/comment_utils.h"
+#include "common/text/line_column_map.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
@@ -41,13 +43,7 @@ void LintWaiver::WaiveOneLine(absl::string_view rule_name, size_t line_number) {
 
 void LintWaiver::WaiveLineRange(absl::string_view rule_name, size_t line_begin,
                                 size_t line_end) {
-  LineSet& line_set = waiver_map_[rule_name];
-  if (line_set.size() < line_end) {
-    line_set.resize(line_end);
-  }
-  for (size_t line = line_begin; line < line_end; ++line) {
-    line_set[line] = true;
-  }
+  waiver_map_[rule_name].Add(line_begin, line_end);
 }
 
 bool LintWaiver::RuleIsWaivedOnLine(absl::string_view rule_name,
@@ -56,6 +52,26 @@ bool LintWaiver::RuleIsWaivedOnLine(absl::string_view rule_name,
   return line_set != nullptr && LineSetContains(*line_set, line_number);
 }
 
+void LintWaiver::FilterWaivedViolations(const LineColumnMap& line_map,
+                                        absl::string_view text_base,
+                                        LintRuleStatus* status) const {
+  const auto* line_set = LookupLineSet(status->lint_rule_name);
+  if (line_set == nullptr || line_set->empty()) return;
+  LineColumnMap::Cursor line_column(line_map);
+  auto range = line_set->begin();
+  status->WaiveViolations([&](const LintViolation& violation) {
+    // Lookup the line number on which the offending token resides.
+    const size_t line = line_column(violation.token.left(text_base)).line;
+    // Skip past ranges that end before this line.  Since violations are
+    // visited in order, ranges are never revisited.
+    while (range != line_set->end() && range->second <= line) ++range;
+    const bool waived = range != line_set->end() && range->first <= line;
+    VLOG(2) << "Violation of " << status->lint_rule_name << " rule on line "
+            << line + 1 << (waived ? " is waived." : " is not waived.");
+    return waived;
+  });
+}
+
 bool LintWaiver::Empty() const {
   for (const auto& rule_waiver : waiver_map_) {
     if (!rule_waiver.second.empty()) {
@@ -21,18 +21,20 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/text/line_column_map.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_stream_view.h"
 #include "common/util/container_util.h"
+#include "common/util/interval_set.h"
 
 namespace verible {
 
 // LintWaiver maintains a set of line ranges per lint rule that should be
 // exempt from each rule.
 class LintWaiver {
-  // TODO: integer interval sets (internal representation) would be more
-  // memory-efficient, given the sparsity of sets.
-  using LineSet = std::vector<bool>;  // Needs to store O(line number) elements.
+  // Memory is O(number of waived ranges), not O(number of waived lines).
+  using LineSet = IntervalSet<size_t>;
 
  public:
   LintWaiver() {}
@@ -69,9 +71,17 @@ class LintWaiver {
 
   // Test if a particular line is included in the set.
   static bool LineSetContains(const LineSet& line_set, size_t line) {
-    return line_set.size() > line && line_set[line];
+    return line_set.Contains(line);
   }
 
+  // Removes the violations of 'status' that are on lines waived for its rule.
+  // This is a single merge pass over the violations (which are ordered by
+  // location) and the waived line ranges.  'line_map' and 'text_base'
+  // translate violation locations into line numbers.
+  void FilterWaivedViolations(const LineColumnMap& line_map,
+                              absl::string_view text_base,
+                              LintRuleStatus* status) const;
+
  private:
   // Key can be string_view because the static strings for each lint rule
   // class exist, and will outlive all LintWaiver objects.
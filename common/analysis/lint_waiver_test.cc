@@ -18,6 +18,9 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/text/line_column_map.h"
 #include "common/text/text_structure_test_utils.h"
 #include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
@@ -122,6 +125,45 @@ TEST(LintWaiverTest, WaiveFusedRangesOneRule) {
   EXPECT_FALSE(lint_waiver.RuleIsWaivedOnLine(rule_name, 11));
 }
 
+// Tests that a huge waived range is stored compactly.
+TEST(LintWaiverTest, WaiveHugeRange) {
+  LintWaiver lint_waiver;
+  auto rule_name = "zz-rule";
+  lint_waiver.WaiveLineRange(rule_name, 3, 100000000);
+  EXPECT_EQ(lint_waiver.LookupLineSet(rule_name)->size(), 1);
+  EXPECT_FALSE(lint_waiver.RuleIsWaivedOnLine(rule_name, 2));
+  EXPECT_TRUE(lint_waiver.RuleIsWaivedOnLine(rule_name, 99999999));
+  EXPECT_FALSE(lint_waiver.RuleIsWaivedOnLine(rule_name, 100000000));
+}
+
+// Tests that violations on waived lines are filtered out.
+TEST(LintWaiverTest, FilterWaivedViolations) {
+  constexpr absl::string_view text("a\nb\nc\nd\ne\nf\n");
+  const LineColumnMap line_map(text);
+  LintWaiver lint_waiver;
+  lint_waiver.WaiveOneLine("aa-rule", 1);
+  lint_waiver.WaiveLineRange("aa-rule", 3, 5);
+  lint_waiver.WaiveOneLine("bb-rule", 0);
+
+  LintRuleStatus status;
+  status.lint_rule_name = "aa-rule";
+  for (size_t line = 0; line < 6; ++line) {
+    status.violations.insert(
+        LintViolation(TokenInfo(1, text.substr(line * 2, 1)), "x"));
+  }
+  lint_waiver.FilterWaivedViolations(line_map, text, &status);
+  std::vector<absl::string_view> remaining;
+  for (const auto& violation : status.violations) {
+    remaining.push_back(violation.token.text);
+  }
+  EXPECT_EQ(remaining, (std::vector<absl::string_view>{"a", "c", "f"}));
+
+  // Rules without waivers are untouched.
+  status.lint_rule_name = "cc-rule";
+  lint_waiver.FilterWaivedViolations(line_map, text, &status);
+  EXPECT_EQ(status.violations.size(), 3);
+}
+
 // Token type enumerations.
 // For convenience, using plain int avoids static_cast-ing everywhere.
 constexpr int kSpace = 0;
@@ -0,0 +1,310 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/matcher/compiled_matcher.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/analysis/matcher/inner_match_handlers.h"
+#include "common/analysis/matcher/matcher.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/util/casts.h"
+#include "common/util/logging.h"
+
+namespace verible {
+namespace matcher {
+
+// Type of the standard inner match handlers, as stored in an
+// InnerMatchHandler.
+using InnerMatchFunction = bool (*)(const Symbol&, const std::vector<Matcher>&,
+                                    BoundSymbolManager*);
+
+CompiledMatcher::CompiledMatcher(const Matcher& matcher) {
+  program_.resize(1);
+  Compile(matcher, 0);
+  any_first_tag_ = !ComputeFirstTags(0, &first_tags_);
+  if (any_first_tag_) first_tags_.clear();
+}
+
+void CompiledMatcher::Compile(const Matcher& matcher, int index) {
+  Instruction op;
+  bool custom = false;
+
+  if (matcher.custom_predicate_) {
+    op.predicate = PredicateKind::kCustom;
+    custom = true;
+  } else if (matcher.shape_.tag.has_value()) {
+    op.predicate = PredicateKind::kTag;
+    op.tag = *matcher.shape_.tag;
+  }
+
+  if (matcher.custom_transformer_) {
+    op.transform = TransformKind::kCustom;
+    custom = true;
+  } else if (!matcher.shape_.path.empty()) {
+    op.transform = TransformKind::kPath;
+    op.path_begin = path_tags_.size();
+    path_tags_.insert(path_tags_.end(), matcher.shape_.path.begin(),
+                      matcher.shape_.path.end());
+    op.path_end = path_tags_.size();
+  }
+
+  const InnerMatchFunction* handler =
+      matcher.inner_match_handler_.target<InnerMatchFunction>();
+  if (handler != nullptr && *handler == &InnerMatchAll) {
+    op.handler = HandlerKind::kAll;
+  } else if (handler != nullptr && *handler == &InnerMatchAny) {
+    op.handler = HandlerKind::kAny;
+  } else if (handler != nullptr && *handler == &InnerMatchEachOf) {
+    op.handler = HandlerKind::kEachOf;
+  } else if (handler != nullptr && *handler == &InnerMatchUnless) {
+    op.handler = HandlerKind::kUnless;
+    CHECK_EQ(matcher.inner_matchers_.size(), 1);
+  } else {
+    op.handler = HandlerKind::kCustom;
+    custom = true;
+  }
+
+  if (custom) {
+    op.custom = custom_matchers_.size();
+    custom_matchers_.push_back(matcher);
+  }
+  if (matcher.bind_id_.has_value()) {
+    op.bind_slot = InternBindId(*matcher.bind_id_);
+  }
+
+  if (op.handler == HandlerKind::kCustom) {
+    // A custom handler is given the original inner matchers, but the
+    // symbols they bind still go to slots.
+    for (const auto& inner : matcher.inner_matchers_) InternBindIds(inner);
+  } else {
+    op.inner_begin = program_.size();
+    op.inner_end = op.inner_begin + matcher.inner_matchers_.size();
+    program_.resize(op.inner_end);
+    for (int i = op.inner_begin; i < op.inner_end; ++i) {
+      Compile(matcher.inner_matchers_[i - op.inner_begin], i);
+    }
+  }
+  program_[index] = op;
+}
+
+void CompiledMatcher::InternBindIds(const Matcher& matcher) {
+  if (matcher.bind_id_.has_value()) InternBindId(*matcher.bind_id_);
+  for (const auto& inner : matcher.inner_matchers_) InternBindIds(inner);
+}
+
+int CompiledMatcher::InternBindId(const std::string& id) {
+  const int slot = BindingSlot(id);
+  if (slot >= 0) return slot;
+  CHECK_LT(bind_ids_.size(), MatchBindings::kMaxSlots)
+      << "Too many distinct bind ids in one matcher.";
+  bind_ids_.push_back(id);
+  return bind_ids_.size() - 1;
+}
+
+// Returns true if only symbols with the collected tags can match.
+bool CompiledMatcher::ComputeFirstTags(int index,
+                                       std::vector<SymbolTag>* tags) const {
+  const Instruction& op = program_[index];
+  switch (op.predicate) {
+    case PredicateKind::kTag:
+      tags->push_back(op.tag);
+      return true;
+    case PredicateKind::kCustom:
+      return false;
+    case PredicateKind::kAlways:
+      break;
+  }
+  // Only with the identity transform do inner matchers see the same symbol.
+  if (op.transform != TransformKind::kIdentity) return false;
+  switch (op.handler) {
+    case HandlerKind::kAll:
+      // Every inner matcher must match, so any one's tags suffice.
+      for (int i = op.inner_begin; i < op.inner_end; ++i) {
+        std::vector<SymbolTag> inner_tags;
+        if (ComputeFirstTags(i, &inner_tags)) {
+          tags->insert(tags->end(), inner_tags.begin(), inner_tags.end());
+          return true;
+        }
+      }
+      return false;
+    case HandlerKind::kAny:
+    case HandlerKind::kEachOf:
+      // Some inner matcher must match.
+      for (int i = op.inner_begin; i < op.inner_end; ++i) {
+        if (!ComputeFirstTags(i, tags)) return false;
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CompiledMatcher::MayMatch(const Symbol& symbol) const {
+  return any_first_tag_ ||
+         std::find(first_tags_.begin(), first_tags_.end(), symbol.Tag()) !=
+             first_tags_.end();
+}
+
+int CompiledMatcher::BindingSlot(absl::string_view id) const {
+  const auto found = std::find(bind_ids_.begin(), bind_ids_.end(), id);
+  return found == bind_ids_.end() ? -1 : found - bind_ids_.begin();
+}
+
+bool CompiledMatcher::Matches(const Symbol& symbol,
+                              MatchBindings* bindings) const {
+  if (!MayMatch(symbol)) return false;
+  return Run(0, symbol, bindings);
+}
+
+bool CompiledMatcher::Matches(const Symbol& symbol,
+                              BoundSymbolManager* manager) const {
+  MatchBindings bindings;
+  if (!Matches(symbol, &bindings)) return false;
+  if (manager != nullptr) {
+    for (size_t slot = 0; slot < bind_ids_.size(); ++slot) {
+      const Symbol* bound = bindings.Get(slot);
+      if (bound != nullptr) manager->BindSymbol(bind_ids_[slot], bound);
+    }
+  }
+  return true;
+}
+
+// Mirrors Matcher::Matches().
+bool CompiledMatcher::Run(int index, const Symbol& symbol,
+                          MatchBindings* bindings) const {
+  const Instruction& op = program_[index];
+  switch (op.predicate) {
+    case PredicateKind::kAlways:
+      break;
+    case PredicateKind::kTag:
+      if (symbol.Tag() != op.tag) return false;
+      break;
+    case PredicateKind::kCustom:
+      if (!custom_matchers_[op.custom].predicate_(symbol)) return false;
+      break;
+  }
+
+  // Every target is tried, even after one matches, for its bindings.
+  bool any_target_matches = false;
+  switch (op.transform) {
+    case TransformKind::kIdentity:
+      return MatchTarget(op, symbol, bindings);
+    case TransformKind::kPath:
+      if (symbol.Kind() != SymbolKind::kNode) return false;
+      for (const auto& child :
+           down_cast<const SyntaxTreeNode&>(symbol).children()) {
+        if (child == nullptr) continue;
+        any_target_matches |=
+            MatchAlongPath(op, *child, op.path_begin, bindings);
+      }
+      return any_target_matches;
+    case TransformKind::kCustom:
+      for (const Symbol* target :
+           custom_matchers_[op.custom].transformer_(symbol)) {
+        if (target == nullptr) continue;
+        any_target_matches |= MatchTarget(op, *target, bindings);
+      }
+      return any_target_matches;
+  }
+  return false;
+}
+
+// Mirrors GetAllDescendantsFromPath(), without collecting the descendants.
+bool CompiledMatcher::MatchAlongPath(const Instruction& op,
+                                     const Symbol& symbol, int depth,
+                                     MatchBindings* bindings) const {
+  const SymbolTag& tag = path_tags_[depth];
+  if (depth + 1 == op.path_end) {
+    return symbol.Tag() == tag && MatchTarget(op, symbol, bindings);
+  }
+  if (symbol.Kind() != SymbolKind::kNode || symbol.Tag() != tag) return false;
+  bool any_target_matches = false;
+  for (const auto& child :
+       down_cast<const SyntaxTreeNode&>(symbol).children()) {
+    if (child == nullptr) continue;
+    any_target_matches |= MatchAlongPath(op, *child, depth + 1, bindings);
+  }
+  return any_target_matches;
+}
+
+bool CompiledMatcher::MatchTarget(const Instruction& op, const Symbol& target,
+                                  MatchBindings* bindings) const {
+  if (!MatchInner(op, target, bindings)) return false;
+  if (op.bind_slot >= 0) bindings->Bind(op.bind_slot, &target);
+  return true;
+}
+
+// Mirrors the handlers in inner_match_handlers.cc.
+bool CompiledMatcher::MatchInner(const Instruction& op, const Symbol& target,
+                                 MatchBindings* bindings) const {
+  const size_t checkpoint = bindings->Checkpoint();
+  switch (op.handler) {
+    case HandlerKind::kAll:
+      for (int i = op.inner_begin; i < op.inner_end; ++i) {
+        if (!Run(i, target, bindings)) {
+          bindings->Rollback(checkpoint);
+          return false;
+        }
+      }
+      return true;
+    case HandlerKind::kAny:
+      for (int i = op.inner_begin; i < op.inner_end; ++i) {
+        if (Run(i, target, bindings)) return true;
+        bindings->Rollback(checkpoint);
+      }
+      return false;
+    case HandlerKind::kEachOf: {
+      bool some_inner_matched = false;
+      for (int i = op.inner_begin; i < op.inner_end; ++i) {
+        const size_t inner_checkpoint = bindings->Checkpoint();
+        if (Run(i, target, bindings)) {
+          some_inner_matched = true;
+        } else {
+          bindings->Rollback(inner_checkpoint);
+        }
+      }
+      return some_inner_matched;
+    }
+    case HandlerKind::kUnless: {
+      // Bindings of the inner matcher are discarded either way.
+      const bool inner_matched = Run(op.inner_begin, target, bindings);
+      bindings->Rollback(checkpoint);
+      return !inner_matched;
+    }
+    case HandlerKind::kCustom: {
+      const Matcher& matcher = custom_matchers_[op.custom];
+      BoundSymbolManager manager;
+      if (!matcher.inner_match_handler_(target, matcher.inner_matchers_,
+                                        &manager)) {
+        return false;
+      }
+      for (const auto& bound : manager.GetBoundMap()) {
+        // Only ids of matchers have slots.
+        const int slot = BindingSlot(bound.first);
+        if (slot >= 0) bindings->Bind(slot, bound.second);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace matcher
+}  // namespace verible
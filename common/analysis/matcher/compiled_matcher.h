@@ -0,0 +1,168 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_ANALYSIS_MATCHER_COMPILED_MATCHER_H_
+#define VERIBLE_COMMON_ANALYSIS_MATCHER_COMPILED_MATCHER_H_
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/analysis/matcher/matcher.h"
+#include "common/text/symbol.h"
+#include "common/util/casts.h"
+
+namespace verible {
+namespace matcher {
+
+// MatchBindings holds the symbols bound by a CompiledMatcher, in slots
+// numbered by CompiledMatcher::BindingSlot().
+// Bindings are undone by truncating a log, so backtracking never copies.
+class MatchBindings {
+ public:
+  // Maximum number of distinct bind ids in one CompiledMatcher.
+  static constexpr int kMaxSlots = 16;
+
+  MatchBindings() { slots_.fill(nullptr); }
+
+  // Returns the symbol bound to slot, or nullptr.
+  const Symbol* Get(int slot) const {
+    return slot < 0 ? nullptr : slots_[slot];
+  }
+
+  template <typename T>
+  const T* GetAs(int slot) const {
+    return down_cast<const T*>(Get(slot));
+  }
+
+  void Bind(int slot, const Symbol* symbol) {
+    undo_log_.emplace_back(slot, slots_[slot]);
+    slots_[slot] = symbol;
+  }
+
+  // Returns a point to which Rollback() can return.
+  size_t Checkpoint() const { return undo_log_.size(); }
+
+  // Undoes all Bind()s made since checkpoint.
+  void Rollback(size_t checkpoint) {
+    while (undo_log_.size() > checkpoint) {
+      slots_[undo_log_.back().first] = undo_log_.back().second;
+      undo_log_.pop_back();
+    }
+  }
+
+  void Clear() {
+    slots_.fill(nullptr);
+    undo_log_.clear();
+  }
+
+ private:
+  std::array<const Symbol*, kMaxSlots> slots_;
+
+  // Previous contents of the slots, most recent last.
+  absl::InlinedVector<std::pair<int, const Symbol*>, kMaxSlots> undo_log_;
+};
+
+// CompiledMatcher is a Matcher lowered into a flat program, which matches
+// exactly like the Matcher, but without calling through std::function for
+// the standard matchers (core_matchers.h, matcher_builders.h) and without
+// copying bindings to backtrack.  Symbols whose tags rule out a match are
+// rejected up front.
+//
+// Usage:
+//   const CompiledMatcher matcher(NodekFoo(PathkBar().Bind("bar")));
+//   const int bar_slot = matcher.BindingSlot("bar");
+//   MatchBindings bindings;
+//   if (matcher.Matches(symbol, &bindings)) {
+//     ... bindings.Get(bar_slot) ...
+//   }
+//
+// Matchers built from arbitrary functions are supported, but those
+// functions are called as they are.
+class CompiledMatcher {
+ public:
+  explicit CompiledMatcher(const Matcher& matcher);
+
+  // Returns true if the matcher matches symbol, and adds the symbols it binds
+  // to bindings.  On mismatch, bindings is left unchanged.
+  bool Matches(const Symbol& symbol, MatchBindings* bindings) const;
+
+  // Same as Matcher::Matches().
+  // The manager is only modified (and thus allocated) on a match.
+  bool Matches(const Symbol& symbol, BoundSymbolManager* manager) const;
+
+  // Returns the binding slot of id, or -1 if nothing binds to id.
+  int BindingSlot(absl::string_view id) const;
+
+  // Returns false if symbol's tag alone rules out a match.
+  bool MayMatch(const Symbol& symbol) const;
+
+ private:
+  enum class PredicateKind { kAlways, kTag, kCustom };
+  enum class TransformKind { kIdentity, kPath, kCustom };
+  enum class HandlerKind { kAll, kAny, kEachOf, kUnless, kCustom };
+
+  // One Matcher, whose inner matchers are program_[inner_begin, inner_end).
+  struct Instruction {
+    PredicateKind predicate = PredicateKind::kAlways;
+    SymbolTag tag;  // for PredicateKind::kTag
+    TransformKind transform = TransformKind::kIdentity;
+    int path_begin = 0;  // path_tags_[path_begin, path_end) for kPath
+    int path_end = 0;
+    HandlerKind handler = HandlerKind::kAll;
+    int custom = -1;  // index into custom_matchers_ for kCustom parts
+    int bind_slot = -1;
+    int inner_begin = 0;
+    int inner_end = 0;
+  };
+
+  void Compile(const Matcher& matcher, int index);
+  void InternBindIds(const Matcher& matcher);
+  int InternBindId(const std::string& id);
+  bool ComputeFirstTags(int index, std::vector<SymbolTag>* tags) const;
+
+  bool Run(int index, const Symbol& symbol, MatchBindings* bindings) const;
+  bool MatchAlongPath(const Instruction& op, const Symbol& symbol, int depth,
+                      MatchBindings* bindings) const;
+  bool MatchTarget(const Instruction& op, const Symbol& target,
+                   MatchBindings* bindings) const;
+  bool MatchInner(const Instruction& op, const Symbol& target,
+                  MatchBindings* bindings) const;
+
+  // Instructions, starting with the outermost matcher.
+  std::vector<Instruction> program_;
+
+  // Concatenation of the paths of all path matchers.
+  std::vector<SymbolTag> path_tags_;
+
+  // Original matchers whose functions are called as-is.
+  std::vector<Matcher> custom_matchers_;
+
+  // Bind ids, indexed by slot.
+  std::vector<std::string> bind_ids_;
+
+  // Tags of all symbols that may match, unless any_first_tag_.
+  bool any_first_tag_ = true;
+  std::vector<SymbolTag> first_tags_;
+};
+
+}  // namespace matcher
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_ANALYSIS_MATCHER_COMPILED_MATCHER_H_
@@ -0,0 +1,219 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/matcher/compiled_matcher.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/analysis/matcher/core_matchers.h"
+#include "common/analysis/matcher/inner_match_handlers.h"
+#include "common/analysis/matcher/matcher.h"
+#include "common/analysis/matcher/matcher_builders.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/tree_builder_test_util.h"
+#include "common/text/tree_utils.h"
+
+namespace verible {
+namespace matcher {
+namespace {
+
+const TagMatchBuilder<SymbolKind::kNode, int, 5> Node5;
+const TagMatchBuilder<SymbolKind::kNode, int, 1> Node1;
+const TagMatchBuilder<SymbolKind::kLeaf, int, 1> Leaf1;
+const auto PathNode1 = MakePathMatcher({NodeTag(1)});
+const auto PathLeaf1 = MakePathMatcher({LeafTag(1)});
+const auto PathLeaf2 = MakePathMatcher({LeafTag(2)});
+const auto Path12 = MakePathMatcher({NodeTag(1), LeafTag(2)});
+
+// Returns a variety of trees to match against.
+std::vector<SymbolPtr> MakeTrees() {
+  std::vector<SymbolPtr> trees;
+  trees.push_back(TNode(5));
+  trees.push_back(TNode(6));
+  trees.push_back(XLeaf(1));
+  trees.push_back(TNode(5, XLeaf(1)));
+  trees.push_back(TNode(5, TNode(1)));
+  trees.push_back(TNode(5, TNode(1), XLeaf(1)));
+  trees.push_back(TNode(5, XLeaf(2), nullptr, XLeaf(1)));
+  trees.push_back(TNode(5, TNode(1, XLeaf(2)), TNode(1, XLeaf(3))));
+  trees.push_back(TNode(5, TNode(1, XLeaf(3)), TNode(1, XLeaf(2), XLeaf(2))));
+  trees.push_back(TNode(1, TNode(1, XLeaf(2)), XLeaf(1)));
+  return trees;
+}
+
+// Expects compiled matching to give the same results and bindings as the
+// original Matcher on all trees.
+void ExpectSameAsMatcher(const Matcher& matcher) {
+  const CompiledMatcher compiled(matcher);
+  const auto trees = MakeTrees();
+  for (size_t i = 0; i < trees.size(); ++i) {
+    BoundSymbolManager expected;
+    BoundSymbolManager actual;
+    EXPECT_EQ(compiled.Matches(*trees[i], &actual),
+              matcher.Matches(*trees[i], &expected))
+        << "tree [" << i << "]";
+    EXPECT_EQ(actual.GetBoundMap(), expected.GetBoundMap())
+        << "tree [" << i << "]";
+  }
+}
+
+TEST(CompiledMatcherTest, TagMatchers) {
+  ExpectSameAsMatcher(Node5());
+  ExpectSameAsMatcher(Node5().Bind("n"));
+  ExpectSameAsMatcher(Leaf1().Bind("l"));
+  ExpectSameAsMatcher(Node5(Node5()));
+}
+
+TEST(CompiledMatcherTest, PathMatchers) {
+  ExpectSameAsMatcher(PathLeaf1().Bind("leaf"));
+  ExpectSameAsMatcher(Node5(PathNode1().Bind("node")));
+  // Multiple descendants along the path, each bound in turn.
+  ExpectSameAsMatcher(Node5(Path12().Bind("leaf")));
+  ExpectSameAsMatcher(Node5(PathNode1(PathLeaf2().Bind("leaf")).Bind("node")));
+}
+
+TEST(CompiledMatcherTest, CoreMatchers) {
+  ExpectSameAsMatcher(Node5(AllOf(PathLeaf1().Bind("l"), PathNode1())));
+  ExpectSameAsMatcher(
+      Node5(AnyOf(PathLeaf1().Bind("l"), PathNode1().Bind("n"))));
+  ExpectSameAsMatcher(
+      Node5(EachOf(PathLeaf1().Bind("l"), PathNode1().Bind("n"))));
+  ExpectSameAsMatcher(Node5(Unless(PathNode1().Bind("n"))));
+  // Backtracking out of partially matched inner matchers.
+  ExpectSameAsMatcher(Node5(AnyOf(AllOf(PathNode1().Bind("a"), PathLeaf2()),
+                                  PathLeaf1().Bind("b")))
+                          .Bind("root"));
+  ExpectSameAsMatcher(
+      Node5(PathNode1(AllOf(PathLeaf2().Bind("two"), Unless(PathLeaf2())))
+                .Bind("node")));
+}
+
+TEST(CompiledMatcherTest, CustomFunctions) {
+  const SymbolPredicate is_node = [](const Symbol& symbol) {
+    return symbol.Kind() == SymbolKind::kNode;
+  };
+  const SymbolTransformer last_child = [](const Symbol& symbol) {
+    std::vector<const Symbol*> targets;
+    if (symbol.Kind() == SymbolKind::kNode) {
+      const auto& children = SymbolCastToNode(symbol).children();
+      if (!children.empty()) targets.push_back(children.back().get());
+    }
+    return targets;
+  };
+  const InnerMatchHandler none_match =
+      [](const Symbol& symbol, const std::vector<Matcher>& inner_matchers,
+         BoundSymbolManager* manager) {
+        for (const auto& matcher : inner_matchers) {
+          BoundSymbolManager unused;
+          if (matcher.Matches(symbol, &unused)) return false;
+        }
+        return true;
+      };
+
+  ExpectSameAsMatcher(Matcher(is_node, InnerMatchAll));
+  Matcher with_transformer(is_node, InnerMatchAll, last_child);
+  with_transformer.AddMatchers(Leaf1().Bind("leaf"));
+  ExpectSameAsMatcher(with_transformer);
+  Matcher with_handler(is_node, none_match);
+  with_handler.AddMatchers(PathNode1());
+  ExpectSameAsMatcher(Node5(PathLeaf1().Bind("l"), with_handler));
+  BindableMatcher binding_handler(is_node, InnerMatchAny);
+  binding_handler.AddMatchers(PathLeaf1().Bind("l"));
+  ExpectSameAsMatcher(Node5(binding_handler.Bind("b")));
+}
+
+TEST(CompiledMatcherTest, BindingSlots) {
+  const CompiledMatcher matcher(
+      Node5(EachOf(PathLeaf1().Bind("leaf"), PathNode1().Bind("node")))
+          .Bind("root"));
+  const int leaf_slot = matcher.BindingSlot("leaf");
+  const int node_slot = matcher.BindingSlot("node");
+  const int root_slot = matcher.BindingSlot("root");
+  EXPECT_GE(leaf_slot, 0);
+  EXPECT_GE(node_slot, 0);
+  EXPECT_GE(root_slot, 0);
+  EXPECT_NE(leaf_slot, node_slot);
+  EXPECT_EQ(matcher.BindingSlot("unknown"), -1);
+
+  const auto tree = TNode(5, XLeaf(1));
+  MatchBindings bindings;
+  EXPECT_TRUE(matcher.Matches(*tree, &bindings));
+  EXPECT_EQ(bindings.Get(root_slot), tree.get());
+  EXPECT_EQ(bindings.Get(leaf_slot), SymbolCastToNode(*tree)[0].get());
+  EXPECT_EQ(bindings.Get(node_slot), nullptr);
+  EXPECT_EQ(bindings.Get(-1), nullptr);
+
+  // A mismatch leaves bindings unchanged.
+  const size_t checkpoint = bindings.Checkpoint();
+  EXPECT_FALSE(matcher.Matches(*TNode(5, XLeaf(2)), &bindings));
+  EXPECT_EQ(bindings.Checkpoint(), checkpoint);
+  EXPECT_EQ(bindings.Get(root_slot), tree.get());
+}
+
+TEST(MatchBindingsTest, Rollback) {
+  const auto a = XLeaf(1);
+  const auto b = XLeaf(2);
+  MatchBindings bindings;
+  bindings.Bind(0, a.get());
+  const size_t checkpoint = bindings.Checkpoint();
+  bindings.Bind(0, b.get());
+  bindings.Bind(1, b.get());
+  EXPECT_EQ(bindings.Get(0), b.get());
+  EXPECT_EQ(bindings.GetAs<SyntaxTreeLeaf>(1), b.get());
+  bindings.Rollback(checkpoint);
+  EXPECT_EQ(bindings.Get(0), a.get());
+  EXPECT_EQ(bindings.Get(1), nullptr);
+  bindings.Clear();
+  EXPECT_EQ(bindings.Get(0), nullptr);
+}
+
+TEST(CompiledMatcherTest, MayMatchFirstTags) {
+  const auto node5 = TNode(5);
+  const auto node1 = TNode(1);
+  const auto leaf1 = XLeaf(1);
+  {
+    const CompiledMatcher matcher(Node5(PathLeaf1()));
+    EXPECT_TRUE(matcher.MayMatch(*node5));
+    EXPECT_FALSE(matcher.MayMatch(*node1));
+    EXPECT_FALSE(matcher.MayMatch(*leaf1));
+  }
+  {
+    const CompiledMatcher matcher(AnyOf(Node5(), Leaf1()));
+    EXPECT_TRUE(matcher.MayMatch(*node5));
+    EXPECT_FALSE(matcher.MayMatch(*node1));
+    EXPECT_TRUE(matcher.MayMatch(*leaf1));
+  }
+  {
+    const CompiledMatcher matcher(AllOf(Unless(Node1()), Node1()));
+    EXPECT_FALSE(matcher.MayMatch(*node5));
+    EXPECT_TRUE(matcher.MayMatch(*node1));
+  }
+  {
+    // Nothing is known about the symbols that path matchers start from.
+    const CompiledMatcher matcher(PathNode1());
+    EXPECT_TRUE(matcher.MayMatch(*node5));
+    EXPECT_TRUE(matcher.MayMatch(*leaf1));
+  }
+  {
+    const CompiledMatcher matcher(AnyOf(Node5(), Unless(Node1())));
+    EXPECT_TRUE(matcher.MayMatch(*node1));
+  }
+}
+
+}  // namespace
+}  // namespace matcher
+}  // namespace verible
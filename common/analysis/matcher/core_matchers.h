@@ -49,9 +49,7 @@ Matcher AllOf(Args&&... args) {
                 "AllOf requires at least one inner matcher");
 
   // AllOf matcher's behavior is completely determined by its inner_matchers
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchAll);
+  Matcher matcher(MatcherShape(), InnerMatchAll);
 
   matcher.AddMatchers(std::forward<Args>(args)...);
 
@@ -85,9 +83,7 @@ Matcher AnyOf(Args&&... args) {
                 "AnyOf requires at least one inner matcher");
 
   // AnyOf matcher's behavior is completely determined by its inner_matchers
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchAny);
+  Matcher matcher(MatcherShape(), InnerMatchAny);
 
   matcher.AddMatchers(std::forward<Args>(args)...);
 
@@ -120,9 +116,7 @@ Matcher EachOf(Args&&... args) {
                 "EachOf requires at least one inner matcher");
 
   // EachOf matcher's behavior is completely determined by its inner_matchers
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchEachOf);
+  Matcher matcher(MatcherShape(), InnerMatchEachOf);
 
   matcher.AddMatchers(std::forward<Args>(args)...);
 
@@ -148,9 +142,7 @@ Matcher EachOf(Args&&... args) {
 template <typename... Args>
 Matcher Unless(const Matcher& inner_matcher) {
   // Unless matcher's behavior is completely determined by its inner_matchers
-  auto predicate = [](const Symbol& symbol) { return true; };
-
-  Matcher matcher(predicate, InnerMatchUnless);
+  Matcher matcher(MatcherShape(), InnerMatchUnless);
 
   matcher.AddMatchers(inner_matcher);
 
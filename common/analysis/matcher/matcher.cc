@@ -19,11 +19,28 @@
 #include <vector>
 
 #include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/analysis/matcher/descent_path.h"
 #include "common/text/symbol.h"
 
 namespace verible {
 namespace matcher {
 
+Matcher::Matcher(const MatcherShape& shape, const InnerMatchHandler& handler)
+    : inner_match_handler_(handler), shape_(shape) {
+  if (shape.tag.has_value()) {
+    const SymbolTag tag = *shape.tag;
+    predicate_ = [tag](const Symbol& symbol) { return symbol.Tag() == tag; };
+  } else {
+    predicate_ = [](const Symbol&) { return true; };
+  }
+  if (!shape.path.empty()) {
+    const DescentPath path = shape.path;
+    transformer_ = [path](const Symbol& symbol) {
+      return GetAllDescendantsFromPath(symbol, path);
+    };
+  }
+}
+
 bool Matcher::Matches(const Symbol& symbol, BoundSymbolManager* manager) const {
   if (predicate_(symbol)) {
     // If this matcher matches (as in, predicate succeeds), test inner matchers
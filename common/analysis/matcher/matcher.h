@@ -22,6 +22,7 @@
 
 #include "absl/types/optional.h"
 #include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/analysis/matcher/descent_path.h"
 #include "common/text/symbol.h"
 
 namespace verible {
@@ -39,6 +40,18 @@ using InnerMatchHandler = std::function<bool(
     const Symbol& symbol, const std::vector<Matcher>& inner_matchers,
     BoundSymbolManager* manager)>;
 
+// MatcherShape describes a predicate and a transformer that are built from
+// standard parts, which CompiledMatcher can evaluate directly.
+struct MatcherShape {
+  // If set, the predicate accepts only symbols with this tag.
+  // Otherwise, it accepts every symbol.
+  absl::optional<SymbolTag> tag;
+
+  // If non-empty, the transformer yields GetAllDescendantsFromPath(path).
+  // Otherwise, it yields the symbol itself.
+  DescentPath path;
+};
+
 // Matcher provides an interface for creating nested tree pattern matchers.
 //
 // Usage:
@@ -55,11 +68,18 @@ using InnerMatchHandler = std::function<bool(
 class Matcher {
  public:
   Matcher(const SymbolPredicate& p, const InnerMatchHandler& handler)
-      : predicate_(p), inner_match_handler_(handler) {}
+      : predicate_(p), inner_match_handler_(handler), custom_predicate_(true) {}
 
   Matcher(const SymbolPredicate& p, const InnerMatchHandler& handler,
           const SymbolTransformer& t)
-      : predicate_(p), inner_match_handler_(handler), transformer_(t) {}
+      : predicate_(p),
+        inner_match_handler_(handler),
+        transformer_(t),
+        custom_predicate_(true),
+        custom_transformer_(true) {}
+
+  // Builds the predicate and the transformer that are described by shape.
+  Matcher(const MatcherShape& shape, const InnerMatchHandler& handler);
 
   // Returns true if this and all submatchers match on symbol.
   // Returns false otherwise.
@@ -79,6 +99,9 @@ class Matcher {
   }
 
  private:
+  // CompiledMatcher translates the structure of Matchers.
+  friend class CompiledMatcher;
+
   // Contains all inner matchers.
   std::vector<Matcher> inner_matchers_;
 
@@ -100,6 +123,12 @@ class Matcher {
   // If present when Matches is called, symbol will be bound to its value
   // If null_opt, then symbol will not be
   absl::optional<std::string> bind_id_ = absl::nullopt;
+
+  // Describes predicate_ and transformer_, unless they were given as
+  // arbitrary functions.
+  MatcherShape shape_;
+  bool custom_predicate_ = false;
+  bool custom_transformer_ = false;
 };
 
 // BindableMatcher is a subclass of matcher that enables setting
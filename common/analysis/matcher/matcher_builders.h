@@ -71,25 +71,16 @@ class PathMatchBuilder {
 
   template <typename... Args>
   BindableMatcher operator()(Args... args) const {
-    // Make a local reference so that lambda can perform a copy
-    // This avoids lifetime issue if returned Matcher is passed outside scope
-    // of this builder object.
-    DescentPath local_path;
-    for (auto symbol_tag : path_) local_path.push_back(symbol_tag);
-
     // As long as one of the inner_matchers matches against discovered
     // descendants, PathMatchBuilder also matches.
-    auto predicate = [](const Symbol& symbol) { return true; };
-
-    // The transformation that is performed on the symbol before it passed
-    // off to the InnerMatchHandler.
-    // Each descendant in returned vector is matched seperately.
+    // The symbol is transformed into its descendants along the path before
+    // it is passed off to the InnerMatchHandler.
+    // Each descendant is matched seperately.
     // TODO(jeremycs): describe match branching behavior here
-    auto transformer = [local_path](const Symbol& symbol) {
-      return GetAllDescendantsFromPath(symbol, local_path);
-    };
+    MatcherShape shape;
+    shape.path.assign(path_.begin(), path_.end());
 
-    BindableMatcher matcher(predicate, InnerMatchAll, transformer);
+    BindableMatcher matcher(shape, InnerMatchAll);
     matcher.AddMatchers(std::forward<Args>(args)...);
     return matcher;
   }
@@ -129,8 +120,9 @@ class TagMatchBuilder {
 
   template <typename... Args>
   BindableMatcher operator()(Args... args) const {
-    BindableMatcher matcher(EqualTagPredicate<Kind, EnumType, Tag>,
-                            InnerMatchAll);
+    MatcherShape shape;
+    shape.tag = SymbolTag{Kind, static_cast<int>(Tag)};
+    BindableMatcher matcher(shape, InnerMatchAll);
     matcher.AddMatchers(std::forward<Args>(args)...);
     return matcher;
   }
@@ -15,6 +15,8 @@
 #ifndef VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_LINT_RULE_H_
 #define VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_LINT_RULE_H_
 
+#include <vector>
+
 #include "common/analysis/lint_rule.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
@@ -26,7 +28,8 @@ namespace verible {
 // SyntaxTreeLintRule is a base class for analyzing syntax trees for lint
 // violations.  Subclasses of this can be added to a SyntaxTreeLinter and can
 // expect to have their HandleLeaf and HandleNode methods called on every
-// leaf/node in the tree that the linter is run on.
+// leaf/node in the tree that the linter is run on, unless they narrow that
+// down with HandledTags().
 //
 // For usage, see linter.h
 //
@@ -37,6 +40,12 @@ class SyntaxTreeLintRule : public LintRule {
  public:
   ~SyntaxTreeLintRule() override {}
 
+  // Returns the tags of the only nodes and leaves that this rule needs to
+  // handle.  The linter will skip calling the Handle* methods on all other
+  // symbols, which saves most of the work for rules that only look for
+  // one or two kinds of node.  An empty set (default) means every symbol.
+  virtual std::vector<SymbolTag> HandledTags() const { return {}; }
+
   virtual void HandleLeaf(const SyntaxTreeLeaf& leaf,
                           const SyntaxTreeContext& context) {}
   virtual void HandleNode(const SyntaxTreeNode& node,
@@ -14,7 +14,9 @@
 
 #include "common/analysis/syntax_tree_linter.h"
 
+#include <cstddef>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "common/analysis/lint_rule_status.h"
@@ -27,6 +29,25 @@
 
 namespace verible {
 
+void SyntaxTreeLinter::AddRule(std::unique_ptr<SyntaxTreeLintRule> rule) {
+  SyntaxTreeLintRule* const rule_ptr = ABSL_DIE_IF_NULL(rule).get();
+  const std::vector<SymbolTag> tags(rule->HandledTags());
+  if (tags.empty()) {
+    catch_all_rules_.push_back(rule_ptr);
+  }
+  for (const auto& tag : tags) {
+    CHECK_GE(tag.tag, 0);
+    auto& table = tag.kind == SymbolKind::kNode ? node_rules_ : leaf_rules_;
+    const size_t index = tag.tag;
+    if (index >= table.size()) table.resize(index + 1);
+    // Tolerate duplicate tags: handle each symbol at most once per rule.
+    if (table[index].empty() || table[index].back() != rule_ptr) {
+      table[index].push_back(rule_ptr);
+    }
+  }
+  rules_.emplace_back(std::move(rule));
+}
+
 void SyntaxTreeLinter::Lint(const Symbol& root) {
   VLOG(1) << "SyntaxTreeLinter analyzing syntax tree with " << rules_.size()
           << " rules.";
@@ -41,23 +62,39 @@ std::vector<LintRuleStatus> SyntaxTreeLinter::ReportStatus() const {
   return status;
 }
 
-// Visits a leaf. Every held rule handles that leaf.
+// Returns the rules registered for 'tag', or an empty list.
+const SyntaxTreeLinter::RuleList& SyntaxTreeLinter::RulesForTag(
+    const std::vector<RuleList>& table, int tag) {
+  static const RuleList* const kNoRules = new RuleList();
+  const size_t index = tag;
+  return (tag >= 0 && index < table.size()) ? table[index] : *kNoRules;
+}
+
+// Visits a leaf. Every rule that handles this kind of leaf handles it.
 void SyntaxTreeLinter::Visit(const SyntaxTreeLeaf& leaf) {
-  for (const auto& rule : rules_) {
-    // Have rule handle the leaf as both a leaf and a symbol.
-    ABSL_DIE_IF_NULL(rule)->HandleLeaf(leaf, Context());
-    rule->HandleSymbol(leaf, Context());
+  const RuleList* const rule_lists[] = {
+      &RulesForTag(leaf_rules_, leaf.get().token_enum), &catch_all_rules_};
+  for (const RuleList* rules : rule_lists) {
+    for (auto* rule : *rules) {
+      // Have rule handle the leaf as both a leaf and a symbol.
+      rule->HandleLeaf(leaf, Context());
+      rule->HandleSymbol(leaf, Context());
+    }
   }
 }
 
-// Visits a node. First, linter has every rule handle that node
-// Second, linter recurses on every non-null child of that node in order
-// to visit the entire tree
+// Visits a node. First, linter has every rule that handles this kind of node
+// handle it.  Second, linter recurses on every non-null child of that node
+// in order to visit the entire tree.
 void SyntaxTreeLinter::Visit(const SyntaxTreeNode& node) {
-  for (const auto& rule : rules_) {
-    // Have rule handle the node as both a node and a symbol.
-    ABSL_DIE_IF_NULL(rule)->HandleNode(node, Context());
-    rule->HandleSymbol(node, Context());
+  const RuleList* const rule_lists[] = {
+      &RulesForTag(node_rules_, node.Tag().tag), &catch_all_rules_};
+  for (const RuleList* rules : rule_lists) {
+    for (auto* rule : *rules) {
+      // Have rule handle the node as both a node and a symbol.
+      rule->HandleNode(node, Context());
+      rule->HandleSymbol(node, Context());
+    }
   }
 
   // Visit subtree children.
@@ -49,15 +49,14 @@ namespace verible {
 //
 class SyntaxTreeLinter : public TreeContextVisitor {
  public:
-  SyntaxTreeLinter() : rules_() {}
+  SyntaxTreeLinter() : rules_(), catch_all_rules_() {}
 
   void Visit(const SyntaxTreeLeaf& leaf) override;
   void Visit(const SyntaxTreeNode& node) override;
 
   // Transfers ownership of rule into Linter
-  void AddRule(std::unique_ptr<SyntaxTreeLintRule> rule) {
-    rules_.emplace_back(std::move(rule));
-  }
+  // Its HandledTags() determine which symbols it will be applied to.
+  void AddRule(std::unique_ptr<SyntaxTreeLintRule> rule);
 
   // Aggregates results of each held LintRule
   std::vector<LintRuleStatus> ReportStatus() const;
@@ -69,6 +68,19 @@ class SyntaxTreeLinter : public TreeContextVisitor {
   // List of rules that the linter is using. Rules are responsible for tracking
   // their own internal state.
   std::vector<std::unique_ptr<SyntaxTreeLintRule>> rules_;
+
+  // Dispatch tables: rules indexed by the node tag or leaf token enum that
+  // they handle.  Not-owned, point into rules_.
+  using RuleList = std::vector<SyntaxTreeLintRule*>;
+  std::vector<RuleList> node_rules_;
+  std::vector<RuleList> leaf_rules_;
+
+  // Rules that handle every symbol.  Not-owned, point into rules_.
+  RuleList catch_all_rules_;
+
+  // Returns the entry of table for 'tag', or an empty list.
+  static const RuleList& RulesForTag(const std::vector<RuleList>& table,
+                                     int tag);
 };
 
 }  // namespace verible
@@ -15,6 +15,7 @@
 #include "common/analysis/syntax_tree_linter.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -275,5 +276,57 @@ TEST(SyntaxTreeLinterTest, DepthSuccess) {
   EXPECT_EQ(statuses[0].violations.size(), 0);
 }
 
+// Testing rule that flags every symbol it is given, and only subscribes to
+// the given tags.
+class FlagHandledSymbols : public SyntaxTreeLintRule {
+ public:
+  explicit FlagHandledSymbols(std::vector<SymbolTag> tags)
+      : tags_(std::move(tags)) {}
+
+  std::vector<SymbolTag> HandledTags() const override { return tags_; }
+
+  void HandleLeaf(const SyntaxTreeLeaf& leaf,
+                  const SyntaxTreeContext& context) override {
+    violations_.insert(LintViolation(leaf.get(), "leaf", context));
+  }
+
+  void HandleNode(const SyntaxTreeNode& node,
+                  const SyntaxTreeContext& context) override {
+    ++nodes_handled_;
+  }
+
+  LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
+
+  int NodesHandled() const { return nodes_handled_; }
+
+ private:
+  const std::vector<SymbolTag> tags_;
+  std::set<LintViolation> violations_;
+  int nodes_handled_ = 0;
+};
+
+TEST(SyntaxTreeLinterTest, DispatchOnlyToHandledTags) {
+  constexpr absl::string_view text("abcde");
+  SymbolPtr root =
+      TNode(5, Leaf(1, text.substr(0, 1)), Leaf(3, text.substr(1, 1)),
+            TNode(6, Leaf(3, text.substr(2, 1)), Leaf(10, text.substr(3, 1))),
+            TNode(5, Leaf(1000, text.substr(4, 1))));
+  auto* const subscribed =
+      new FlagHandledSymbols({NodeTag(5), LeafTag(3), LeafTag(3)});
+  auto* const catch_all = new FlagHandledSymbols({});
+  SyntaxTreeLinter linter;
+  linter.AddRule(std::unique_ptr<SyntaxTreeLintRule>(subscribed));
+  linter.AddRule(std::unique_ptr<SyntaxTreeLintRule>(catch_all));
+  ASSERT_NE(root.get(), nullptr);
+  linter.Lint(*root.get());
+
+  EXPECT_EQ(subscribed->NodesHandled(), 2);
+  EXPECT_EQ(catch_all->NodesHandled(), 3);
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  ASSERT_EQ(statuses.size(), 2);
+  EXPECT_EQ(statuses[0].violations.size(), 2);  // duplicate tag ignored
+  EXPECT_EQ(statuses[1].violations.size(), 5);
+}
+
 }  // namespace
 }  // namespace verible
@@ -18,7 +18,7 @@
 #include <memory>
 #include <vector>
 
-#include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
@@ -29,7 +29,8 @@
 namespace verible {
 namespace {
 
-using matcher::BoundSymbolManager;
+using matcher::CompiledMatcher;
+using matcher::MatchBindings;
 
 // SyntaxTreeSearcher collects node that match specified criteria
 // from a syntax tree.  Prefer to use the SearchSyntaxTree() function
@@ -51,19 +52,23 @@ class SyntaxTreeSearcher : public TreeContextVisitor {
   void Visit(const SyntaxTreeNode& node) override;
 
   // Main matcher that finds a particular type of tree node.
-  const verible::matcher::Matcher matcher_;
+  const CompiledMatcher matcher_;
 
   // Predicate that further qualifies the matches of interest.
   const std::function<bool(const SyntaxTreeContext&)> context_predicate_;
 
   // Accumulated set of matches.
   std::vector<TreeSearchMatch> matches_;
+
+  // Reused for every symbol, to avoid allocating for each one.
+  MatchBindings bindings_;
 };
 
 // Checks if leaf matches critera.
 void SyntaxTreeSearcher::CheckSymbol(const Symbol& symbol) {
-  BoundSymbolManager manager;
-  if (matcher_.Matches(symbol, &manager)) {
+  // Bound symbols are not reported.
+  bindings_.Clear();
+  if (matcher_.Matches(symbol, &bindings_)) {
     if (context_predicate_(Context())) {
       matches_.push_back(TreeSearchMatch{&symbol, Context()});
     }
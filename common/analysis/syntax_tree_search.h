@@ -21,17 +21,10 @@
 #include "common/analysis/matcher/matcher.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
+#include "common/text/tree_search_match.h"
 
 namespace verible {
 
-// General match structure for searching a syntax tree.
-struct TreeSearchMatch {
-  // Note: The syntax tree to which the matching node belongs must outlive
-  // this pointer.
-  const Symbol* match;
-  SyntaxTreeContext context;
-};
-
 // SearchSyntaxTree collects nodes that match the specified criteria into a
 // vector.  This is useful for analyses that need to look at a collection
 // of related nodes together, rather than as each one is encountered.
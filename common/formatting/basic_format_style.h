@@ -34,6 +34,18 @@ struct BasicFormatStyle {
   // exceeding the column limit.  Additional penalty of 1 is incurred for each
   // character over the limit.
   int over_column_limit_penalty = 100;
+
+  // Calls visitor(name, field) for each of the fields above, where 'style'
+  // is a (const or mutable) BasicFormatStyle or derived style.  This is the
+  // one list of fields that serialization and parsing of styles rely on,
+  // so every field added above must be added here too.
+  template <typename Style, typename Visitor>
+  static void ForEachField(Style& style, Visitor&& visitor) {
+    visitor("indentation_spaces", style.indentation_spaces);
+    visitor("wrap_spaces", style.wrap_spaces);
+    visitor("column_limit", style.column_limit);
+    visitor("over_column_limit_penalty", style.over_column_limit_penalty);
+  }
 };
 
 }  // namespace verible
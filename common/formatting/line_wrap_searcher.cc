@@ -14,8 +14,10 @@
 
 #include "common/formatting/line_wrap_searcher.h"
 
-#include <memory>
+#include <cstddef>
+#include <functional>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -30,23 +32,62 @@
 namespace verible {
 namespace {
 
-// Wrapped class around StateNode for the sake of adapting to a
-// std::priority_queue interface.
-// TODO(fangism): if performance of memory allocations is an issue,
-// use some sort of pool-allocator.
+// Priority queue entry for a StateNode.  The cost is copied out of the state
+// so that heap operations do not need to dereference states.
 struct SearchState {
-  std::shared_ptr<const StateNode> state;
+  int cumulative_cost;
+  const StateNode* state;
 
-  explicit SearchState(const std::shared_ptr<const StateNode>& s) : state(s) {}
+  explicit SearchState(const StateNode* s)
+      : cumulative_cost(s->cumulative_cost), state(s) {}
 
   // Inverted to min-heap: *lowest* penalty has the highest search priority.
-  bool operator<(const SearchState& r) const { return *r.state < *state; }
+  bool operator<(const SearchState& r) const {
+    return r.cumulative_cost < cumulative_cost;
+  }
+};
+
+// Everything that the remainder of a search from a state depends on.
+// States with equal keys lead to identical sets of completions, with costs
+// that differ only by the costs of the states themselves.
+struct EquivalenceKey {
+  const PreFormatToken* current_token;
+  int current_column;
+  SpacingDecision spacing_choice;
+  WrapColumnStack wrap_column_positions;
+
+  explicit EquivalenceKey(const StateNode& s)
+      : current_token(&s.GetCurrentToken()),
+        current_column(s.current_column),
+        spacing_choice(s.spacing_choice),
+        wrap_column_positions(s.wrap_column_positions) {}
+
+  bool operator==(const EquivalenceKey& r) const {
+    return current_token == r.current_token &&
+           current_column == r.current_column &&
+           spacing_choice == r.spacing_choice &&
+           wrap_column_positions == r.wrap_column_positions;
+  }
+
+  struct Hasher {
+    size_t operator()(const EquivalenceKey& k) const {
+      size_t h = std::hash<const PreFormatToken*>()(k.current_token);
+      for (const int value :
+           {k.current_column, static_cast<int>(k.spacing_choice),
+            static_cast<int>(k.wrap_column_positions.size()),
+            k.wrap_column_positions.top()}) {
+        h = h * 31 + std::hash<int>()(value);
+      }
+      return h;
+    }
+  };
 };
 }  // namespace
 
 std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
                                               const BasicFormatStyle& style,
-                                              int max_search_states) {
+                                              int max_search_states,
+                                              LineWrapSearchStats* stats) {
   // Dijkstra's algorithm for now: prioritize searching minimum penalty path
   // until destination is reached.
 
@@ -62,19 +103,53 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
   // important, consider switching to a std::map.
   std::priority_queue<SearchState> worklist;
 
+  // Owns every state explored in this search.
+  StateNodePool pool;
+
+  // Lowest cost at which each class of equivalent (unfinished) states has
+  // been reached.  Only the cheapest state of each class is explored, and
+  // among equally cheap ones, only the first.
+  std::unordered_map<EquivalenceKey, int, EquivalenceKey::Hasher> best_costs;
+  int pruned_count = 0;
+
+  // Adds a state to the worklist, unless it is no better than an equivalent
+  // one that was already added.
+  const auto push_state = [&](const StateNode* state) {
+    if (!state->Done()) {
+      const auto inserted =
+          best_costs.emplace(EquivalenceKey(*state), state->cumulative_cost);
+      if (!inserted.second) {
+        if (inserted.first->second <= state->cumulative_cost) {
+          ++pruned_count;
+          return;
+        }
+        inserted.first->second = state->cumulative_cost;
+      }
+    }
+    worklist.push(SearchState(state));
+  };
+
   // Seed worklist with a NodeState that should have 0 penalty.
-  SearchState seed(std::make_shared<StateNode>(uwline, style));
-  worklist.push(seed);
+  push_state(pool.Create(uwline, style));
 
   bool aborted_search = false;
-  std::vector<std::shared_ptr<const StateNode>> winning_paths;
+  std::vector<const StateNode*> winning_paths;
   int state_count = 0;
   while (!worklist.empty()) {
-    ++state_count;
-
-    SearchState next(worklist.top());
+    const SearchState next(worklist.top());
     worklist.pop();
 
+    // Skip states that were superseded by a cheaper equivalent state after
+    // they were added.
+    if (!next.state->Done() &&
+        best_costs.find(EquivalenceKey(*next.state))->second <
+            next.cumulative_cost) {
+      ++pruned_count;
+      continue;
+    }
+
+    ++state_count;
+
     VLOG(4) << "\n---- line wrapping search state " << state_count << " ----"
             << "\ncurrent cost: " << next.state->cumulative_cost
             << "\ncurrent column: " << next.state->current_column;
@@ -104,7 +179,7 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
     if (state_count >= max_search_states) {
       // Search limit exceeded, abandon search.
       // Greedily finish formatting this partition, and return it.
-      winning_paths.push_back(StateNode::QuickFinish(next.state, style));
+      winning_paths.push_back(StateNode::QuickFinish(next.state, style, &pool));
       aborted_search = true;
       break;
     }
@@ -115,29 +190,27 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
     const auto& token = next.state->GetNextToken();
     if (token.before.break_decision == SpacingOptions::Preserve) {
       VLOG(4) << "preserving spaces before \'" << token.token->text << '\'';
-      SearchState preserved(std::make_shared<StateNode>(
-          next.state, style, SpacingDecision::Preserve));
-      worklist.push(preserved);
+      push_state(pool.Create(next.state, style, SpacingDecision::Preserve));
     } else {
       // Remaining options are: Undecided, MustWrap, MustAppend
       // Explore one or both: SpacingDecision::Wrap/Append
       if (token.before.break_decision != SpacingOptions::MustWrap) {
         VLOG(4) << "considering appending \'" << token.token->text << '\'';
         // Consider cost of appending token to current line.
-        SearchState appended(std::make_shared<StateNode>(
-            next.state, style, SpacingDecision::Append));
-        worklist.push(appended);
-        VLOG(4) << "  cost: " << appended.state->cumulative_cost;
-        VLOG(4) << "  column: " << appended.state->current_column;
+        const StateNode* appended =
+            pool.Create(next.state, style, SpacingDecision::Append);
+        VLOG(4) << "  cost: " << appended->cumulative_cost;
+        VLOG(4) << "  column: " << appended->current_column;
+        push_state(appended);
       }
       if (token.before.break_decision != SpacingOptions::MustAppend) {
         VLOG(4) << "considering wrapping \'" << token.token->text << '\'';
         // Consider cost of line wrapping here.
-        SearchState wrapped(std::make_shared<StateNode>(next.state, style,
-                                                        SpacingDecision::Wrap));
-        worklist.push(wrapped);
-        VLOG(4) << "  cost: " << wrapped.state->cumulative_cost;
-        VLOG(4) << "  column: " << wrapped.state->current_column;
+        const StateNode* wrapped =
+            pool.Create(next.state, style, SpacingDecision::Wrap);
+        VLOG(4) << "  cost: " << wrapped->cumulative_cost;
+        VLOG(4) << "  column: " << wrapped->current_column;
+        push_state(wrapped);
       }
     }
 
@@ -148,6 +221,11 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
   }  // while (!worklist.empty())
 
   CHECK_GE(winning_paths.size(), 1);
+  VLOG(2) << "explored " << state_count << " states, pruned " << pruned_count;
+  if (stats != nullptr) {
+    stats->states_explored = state_count;
+    stats->states_pruned = pruned_count;
+  }
 
   // Reconstruct the unwrapped_line to reflect the decisions made to reach the
   // winning_paths.  Return a modified copy of the original UnwrappedLine.
@@ -188,7 +266,8 @@ bool FitsOnLine(const UnwrappedLine& uwline, const BasicFormatStyle& style) {
 
   // Initialize on first token.
   // This accounts for space consumed by left-indentation.
-  auto state = std::make_shared<const StateNode>(uwline, style);
+  StateNodePool pool;
+  const StateNode* state = pool.Create(uwline, style);
 
   while (!state->Done()) {
     const auto& token = state->GetNextToken();
@@ -198,7 +277,7 @@ bool FitsOnLine(const UnwrappedLine& uwline, const BasicFormatStyle& style) {
     }
 
     // Append token onto same line while it fits.
-    state = std::make_shared<StateNode>(state, style, SpacingDecision::Append);
+    state = pool.Create(state, style, SpacingDecision::Append);
     if (state->current_column > style.column_limit) {
       return false;
     }
@@ -23,6 +23,16 @@
 
 namespace verible {
 
+// Statistics about one SearchLineWraps() call, for diagnostics.
+struct LineWrapSearchStats {
+  // Number of states taken off the worklist and expanded.
+  int states_explored = 0;
+
+  // Number of states discarded because an equivalent state of lower or equal
+  // cost had already been found.
+  int states_pruned = 0;
+};
+
 // SearchLineWraps takes an UnwrappedLine with formatting annotations,
 // and a style structure, and returns equally-good FormattedExcerpts with
 // formatting decisions (wraps, spaces) committed.
@@ -33,9 +43,14 @@ namespace verible {
 // returning a greedily formatted result (which can still be rendered)
 // that will be marked as !CompletedFormatting().
 // This is guaranteed to return at least one result.
-std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
-                                              const BasicFormatStyle& style,
-                                              int max_search_states);
+// Partial layouts that are equivalent for the remainder of the search (same
+// token, column, spacing decision and wrap columns) are explored only once,
+// via the cheapest such layout.  Consequently, equally optimal solutions that
+// differ only before such a point are not all returned.
+// If 'stats' is non-null, it is filled with search statistics.
+std::vector<FormattedExcerpt> SearchLineWraps(
+    const UnwrappedLine& uwline, const BasicFormatStyle& style,
+    int max_search_states, LineWrapSearchStats* stats = nullptr);
 
 // Diagnostic helper for displaying when multiple optimal wrappings are found
 // by SearchLineWraps.  This aids in development around wrap penalty tuning.
@@ -359,6 +359,31 @@ TEST_F(SearchLineWrapsTestFixture, DisplayEquallyOptimalWrappings) {
   EXPECT_TRUE(absl::StrContains(stream.str(), "============"));
 }
 
+// Test that equivalent partial layouts are explored only once.
+TEST_F(SearchLineWrapsTestFixture, PrunesEquivalentStates) {
+  const std::vector<TokenInfo> tokens(16, {0, "xxxx"});
+  CreateTokenInfos(tokens);
+  UnwrappedLine uwline_in(LevelsToSpaces(0), pre_format_tokens_.begin());
+  AddFormatTokens(&uwline_in);
+  for (auto& ftoken : pre_format_tokens_) {
+    ftoken.before.break_penalty = 1;
+    ftoken.before.spaces_required = 1;
+  }
+  LineWrapSearchStats stats;
+  const auto formatted_lines =
+      verible::SearchLineWraps(uwline_in, style_, 1000, &stats);
+  const FormattedExcerpt& formatted_line = formatted_lines.front();
+  EXPECT_TRUE(formatted_line.CompletedFormatting());
+  EXPECT_EQ(formatted_line.Render(),
+            "xxxx xxxx xxxx xxxx\n"
+            "      xxxx xxxx xxxx\n"
+            "      xxxx xxxx xxxx\n"
+            "      xxxx xxxx xxxx\n"
+            "      xxxx xxxx xxxx");
+  EXPECT_GT(stats.states_pruned, 0);
+  EXPECT_LT(stats.states_explored, 1000);
+}
+
 TEST_F(SearchLineWrapsTestFixture, FitsOnLine) {
   const std::vector<TokenInfo> tokens = {
       {0, "aaaaaa"},
@@ -16,8 +16,8 @@
 
 #include <cstddef>
 #include <iterator>
+#include <algorithm>
 #include <memory>
-#include <stack>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -45,7 +45,8 @@ StateNode::StateNode(const UnwrappedLine& uwline, const BasicFormatStyle& style)
       wrap_column_positions() {
   // The starting column is relative to the current indentation level.
   VLOG(4) << "initial column position: " << current_column;
-  wrap_column_positions.push(current_column + style.wrap_spaces);
+  wrap_column_positions.push(&pushed_wrap_column_,
+                             current_column + style.wrap_spaces);
   if (!uwline.TokensRange().empty()) {
     VLOG(4) << "token.text: \'" << undecided_path.front().token->text << '\'';
     // Point undecided_path past the first token.
@@ -58,8 +59,7 @@ StateNode::StateNode(const UnwrappedLine& uwline, const BasicFormatStyle& style)
   VLOG(4) << "root: " << *this;
 }
 
-StateNode::StateNode(const std::shared_ptr<const StateNode>& parent,
-                     const BasicFormatStyle& style,
+StateNode::StateNode(const StateNode* parent, const BasicFormatStyle& style,
                      SpacingDecision spacing_choice)
     : prev_state(ABSL_DIE_IF_NULL(parent)),
       undecided_path(prev_state->undecided_path.begin() + 1,  // pop_front()
@@ -217,12 +217,14 @@ void StateNode::_OpenGroupBalance(const BasicFormatStyle& style) {
       switch (spacing_choice) {
         case SpacingDecision::Wrap:
           VLOG(4) << "current token is wrapped";
-          wrap_column_positions.push(prev_state->wrap_column_positions.top() +
-                                     style.wrap_spaces);
+          wrap_column_positions.push(
+              &pushed_wrap_column_,
+              prev_state->wrap_column_positions.top() + style.wrap_spaces);
           break;
         case SpacingDecision::Append:
           VLOG(4) << "current token is appended";
-          wrap_column_positions.push(prev_state->current_column);
+          wrap_column_positions.push(&pushed_wrap_column_,
+                                     prev_state->current_column);
           break;
         case SpacingDecision::Preserve:
           // TODO(b/134711965): calculate column position using original spaces
@@ -248,35 +250,27 @@ void StateNode::_CloseGroupBalance() {
   //     ) <-- aligned with (
 }
 
-std::shared_ptr<const StateNode> StateNode::AppendIfItFits(
-    const std::shared_ptr<const StateNode>& current_state,
-    const verible::BasicFormatStyle& style) {
+const StateNode* StateNode::AppendIfItFits(
+    const StateNode* current_state, const verible::BasicFormatStyle& style,
+    StateNodePool* pool) {
   if (current_state->Done()) return current_state;
   const auto& token = current_state->GetNextToken();
-  // It seems little wasteful to always create both states when only one is
-  // returned, but compiler optimization should be able to leverage this.
-  // In any case, this is not a critical path operation, so we're not going to
-  // worry about it.
-  const auto wrapped =
-      std::make_shared<StateNode>(current_state, style, SpacingDecision::Wrap);
-  const auto appended = std::make_shared<StateNode>(current_state, style,
-                                                    SpacingDecision::Append);
-  if (token.before.break_decision == SpacingOptions::MustWrap ||
-      appended->current_column > style.column_limit) {
-    return wrapped;
-  } else {
-    return appended;
+  if (token.before.break_decision != SpacingOptions::MustWrap) {
+    const StateNode* appended =
+        pool->Create(current_state, style, SpacingDecision::Append);
+    if (appended->current_column <= style.column_limit) return appended;
   }
+  return pool->Create(current_state, style, SpacingDecision::Wrap);
 }
 
-std::shared_ptr<const StateNode> StateNode::QuickFinish(
-    const std::shared_ptr<const StateNode>& current_state,
-    const verible::BasicFormatStyle& style) {
-  std::shared_ptr<const StateNode> latest(current_state);
-  // Construct a chain of reference-counted states where the returned pointer
-  // "holds on" to all of its ancestors like a singly-linked-list.
+const StateNode* StateNode::QuickFinish(const StateNode* current_state,
+                                        const verible::BasicFormatStyle& style,
+                                        StateNodePool* pool) {
+  const StateNode* latest = current_state;
+  // Construct a chain of states, each of which points to its predecessor
+  // like a singly-linked-list, all owned by the pool.
   while (!latest->Done()) {
-    latest = AppendIfItFits(latest, style);
+    latest = AppendIfItFits(latest, style, pool);
   }
   return latest;
 }
@@ -312,6 +306,17 @@ void StateNode::ReconstructFormatDecisions(FormattedExcerpt* result) const {
   }
 }
 
+void StateNodePool::NewBlock() {
+  // Grow geometrically, so that small searches stay small, while large ones
+  // need few blocks.
+  static constexpr size_t kMinBlockCapacity = 64;
+  static constexpr size_t kMaxBlockCapacity = 4096;
+  block_capacity_ = std::min(std::max(2 * block_capacity_, kMinBlockCapacity),
+                             kMaxBlockCapacity);
+  blocks_.emplace_back(new Slot[block_capacity_]);
+  used_in_block_ = 0;
+}
+
 std::ostream& operator<<(std::ostream& stream, const StateNode& state) {
   // Omit information about remaining decisions and parent state.
   CHECK(!state.wrap_column_positions.empty());
@@ -19,7 +19,9 @@
 #include <iosfwd>
 #include <iterator>
 #include <memory>
-#include <stack>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "common/formatting/basic_format_style.h"
@@ -29,19 +31,67 @@
 
 namespace verible {
 
+class StateNodePool;
+
+// WrapColumnStack is a persistent (immutable, shared-tail) stack of column
+// positions.  Copying one is O(1), and pushing links a new frame on top of
+// the shared remainder, so a search state can extend its parent's stack
+// without copying it.  Frames are not owned by the stack: push() is given
+// storage that must outlive every stack that refers to it.
+class WrapColumnStack {
+ public:
+  struct Frame {
+    int column;
+    // Number of frames in the stack, including this one.
+    int depth;
+    const Frame* below;
+  };
+
+  bool empty() const { return top_ == nullptr; }
+
+  size_t size() const { return top_ == nullptr ? 0 : top_->depth; }
+
+  int top() const { return top_->column; }
+
+  // Places 'column' on top of the stack, using 'storage' for the new frame.
+  void push(Frame* storage, int column) {
+    *storage = {column, static_cast<int>(size()) + 1, top_};
+    top_ = storage;
+  }
+
+  void pop() { top_ = top_->below; }
+
+  // Returns true if both stacks hold the same columns.  This stops as soon as
+  // the stacks share a frame.
+  bool operator==(const WrapColumnStack& other) const {
+    if (size() != other.size()) return false;
+    for (const Frame *a = top_, *b = other.top_; a != b;
+         a = a->below, b = b->below) {
+      if (a->column != b->column) return false;
+    }
+    return true;
+  }
+
+ private:
+  const Frame* top_ = nullptr;
+};
+
 // A StateNode is used to keep a formatting state as the tokens of an
 // UnwrappedLine are searched left to right.  Each StateNode represents one
 // formatting decision: wrap or not-wrap.  Each StateNode maintains a pointer
 // to its parent state, which is used for backtracking once a solution
 // is reached.  StateNode is language-agnostic.
 // StateNode is purely an implementation detail of line_wrap_searcher.cc.
+//
+// StateNodes do not own their ancestors; all states of a search are owned by
+// a StateNodePool (below), which releases them all at once.
 struct StateNode {
   typedef std::vector<PreFormatToken> path_type;
   typedef container_iterator_range<path_type::const_iterator> range_type;
 
   // The StateNode that has an edge to this StateNode, to backtrack once a final
-  // state is reached.
-  std::shared_ptr<const StateNode> prev_state;
+  // state is reached.  This must outlive this StateNode.
+  const StateNode* prev_state;
 
   // Iterator range marking the unexplored decisions beyond the current token.
   // TODO(fangism): make the iterator type a template parameter.  Might help
@@ -65,9 +115,8 @@ struct StateNode {
   // These column positions correspond to either the current indentation level
   // plus wrapping or the column position of the nearest group-opening
   // delimiter.
-  // TODO(b/135730018): re-implement to minimize copying of stacks.
-  // For example, use pointer or iterator to previous stack update.
-  std::stack<int> wrap_column_positions;
+  // This shares all but its top frame with prev_state's stack.
+  WrapColumnStack wrap_column_positions;
 
   // Constructor for the root node of the search path, with no parent.
   // This automatically places the first token at the beginning of a new line
@@ -80,10 +129,13 @@ struct StateNode {
   // Constructor for nodes that represent new wrap decision trees to explore.
   // 'spacing_choice' reflects the decision being explored, e.g. append, wrap,
   // preserve.
-  StateNode(const std::shared_ptr<const StateNode>& parent,
-            const verible::BasicFormatStyle& style,
+  StateNode(const StateNode* parent, const verible::BasicFormatStyle& style,
             SpacingDecision spacing_choice);
 
+  // The wrap_column_positions of other states may refer to this one's frame.
+  StateNode(const StateNode&) = delete;
+  StateNode& operator=(const StateNode&) = delete;
+
   // Returns true when the undecided_path is empty.
   // The search is over when there are no more decisions to explore.
   bool Done() const { return undecided_path.begin() == undecided_path.end(); }
@@ -103,7 +155,7 @@ struct StateNode {
 
   // Returns pointer to previous state before this decision node.
   // This functions as a forward-iterator going up the state ancestry chain.
-  const StateNode* next() const { return prev_state.get(); }
+  const StateNode* next() const { return prev_state; }
 
   // Returns true if this state was initialized with an unwrapped line and
   // has no parent state.
@@ -116,22 +168,23 @@ struct StateNode {
     const auto* iter = this;
     while (!iter->IsRootState()) {
       ++depth;
-      iter = iter->prev_state.get();
+      iter = iter->prev_state;
     }
     return depth;
   }
 
   // Produce next state by appending a token if the result stays under the
   // column limit, or breaking onto a new line if required.
-  static std::shared_ptr<const StateNode> AppendIfItFits(
-      const std::shared_ptr<const StateNode>& current_state,
-      const verible::BasicFormatStyle& style);
+  // New states are allocated from 'pool'.
+  static const StateNode* AppendIfItFits(const StateNode* current_state,
+                                         const verible::BasicFormatStyle& style,
+                                         StateNodePool* pool);
 
   // Repeatedly apply AppendIfItFits() until Done() with formatting.
   // TODO(b/134711965): We may want a variant that preserves spaces too.
-  static std::shared_ptr<const StateNode> QuickFinish(
-      const std::shared_ptr<const StateNode>& current_state,
-      const verible::BasicFormatStyle& style);
+  static const StateNode* QuickFinish(const StateNode* current_state,
+                                      const verible::BasicFormatStyle& style,
+                                      StateNodePool* pool);
 
   // Comparator provides an ordering of which paths should be explored
   // when maintained in a priority queue.  For Dijsktra-style algorithms,
@@ -154,6 +207,48 @@ struct StateNode {
   void _UpdateCumulativeCost(const verible::BasicFormatStyle&);
   void _OpenGroupBalance(const verible::BasicFormatStyle&);
   void _CloseGroupBalance();
+
+  // Storage for the (at most one) frame this state pushes onto
+  // wrap_column_positions.
+  WrapColumnStack::Frame pushed_wrap_column_{};
+};
+
+// StateNodePool owns the StateNodes of one search, allocating them from
+// large blocks and destroying them all at once.  This avoids one heap
+// allocation (and reference count) per explored decision.
+class StateNodePool {
+ public:
+  StateNodePool() = default;
+
+  StateNodePool(const StateNodePool&) = delete;
+  StateNodePool& operator=(const StateNodePool&) = delete;
+
+  // Constructs a StateNode with 'args', which lives as long as this pool.
+  template <typename... Args>
+  const StateNode* Create(Args&&... args) {
+    if (used_in_block_ == block_capacity_) NewBlock();
+    void* slot = &blocks_.back()[used_in_block_++];
+    ++size_;
+    return new (slot) StateNode(std::forward<Args>(args)...);
+  }
+
+  // Returns the number of states created.
+  size_t size() const { return size_; }
+
+ private:
+  // StateNodes are never destroyed individually.
+  static_assert(std::is_trivially_destructible<StateNode>::value,
+                "StateNode must be trivially destructible");
+
+  using Slot = typename std::aligned_storage<sizeof(StateNode),
+                                             alignof(StateNode)>::type;
+
+  void NewBlock();
+
+  std::vector<std::unique_ptr<Slot[]>> blocks_;
+  size_t block_capacity_ = 0;
+  size_t used_in_block_ = 0;
+  size_t size_ = 0;
 };
 
 // Human-readable representation for debugging only.
@@ -15,7 +15,6 @@
 #include "common/formatting/state_node.h"
 
 #include <memory>
-#include <stack>
 #include <string>
 #include <vector>
 
@@ -31,6 +30,29 @@
 namespace verible {
 namespace {
 
+// Tests that pushing onto a copy leaves the original stack intact.
+TEST(WrapColumnStackTest, SharedTail) {
+  WrapColumnStack::Frame frames[3];
+  WrapColumnStack base;
+  EXPECT_TRUE(base.empty());
+  base.push(&frames[0], 4);
+  WrapColumnStack left(base), right(base);
+  left.push(&frames[1], 10);
+  right.push(&frames[2], 20);
+  EXPECT_EQ(base.size(), 1);
+  EXPECT_EQ(base.top(), 4);
+  EXPECT_EQ(left.size(), 2);
+  EXPECT_EQ(left.top(), 10);
+  EXPECT_EQ(right.size(), 2);
+  EXPECT_EQ(right.top(), 20);
+  right.pop();
+  EXPECT_EQ(right.size(), 1);
+  EXPECT_EQ(right.top(), 4);
+  right.pop();
+  EXPECT_TRUE(right.empty());
+  EXPECT_EQ(left.top(), 10);
+}
+
 std::string RenderFormattedText(const StateNode& path,
                                 const UnwrappedLine& uwline) {
   FormattedExcerpt formatted_line(uwline);
@@ -70,6 +92,7 @@ struct StateNodeTestFixture : public UnwrappedLineMemoryHandler,
 
   BasicFormatStyle style;
   std::unique_ptr<UnwrappedLine> uwline;
+  StateNodePool pool;
 };
 
 // Tests that root StateNode of search can be initialized with full
@@ -119,7 +142,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevState) {
   ftokens[0].before.spaces_required = 1;
   ftokens[1].before.spaces_required = 1;
   ftokens[1].before.break_penalty = 5;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());
@@ -132,9 +155,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevState) {
   const auto& child_state = parent_state;
   {
     // Second token, also appended to same line as first:
-    auto child2_state = std::make_shared<StateNode>(child_state, style,
-                                                    SpacingDecision::Append);
-    EXPECT_EQ(child2_state->next(), child_state.get());
+    auto child2_state =
+        pool.Create(child_state, style, SpacingDecision::Append);
+    EXPECT_EQ(child2_state->next(), child_state);
     EXPECT_EQ(child2_state->current_column,
               child_state->current_column +            // 8 +
                   ftokens[1].before.spaces_required +  // 1 +
@@ -147,8 +170,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevState) {
   {
     // Second token, but wrapped onto next line:
     auto child2_state =
-        std::make_shared<StateNode>(child_state, style, SpacingDecision::Wrap);
-    EXPECT_EQ(child2_state->next(), child_state.get());
+        pool.Create(child_state, style, SpacingDecision::Wrap);
+    EXPECT_EQ(child2_state->next(), child_state);
     EXPECT_EQ(child2_state->current_column,
               initial_column +             // 2 +
                   style.wrap_spaces +      // 4 +
@@ -174,7 +197,7 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateNoGap) {
   ftokens[1].before.spaces_required = 4;  // ignored because of preserving
   ftokens[1].before.preserved_space_start = ftokens[0].Text().end();
   ftokens[1].before.break_penalty = 5;  // ignored because of preserving
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());  // 2 + 3
@@ -182,9 +205,9 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateNoGap) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Appended with preserved spaces from original text.
-  auto child_state = std::make_shared<StateNode>(parent_state, style,
-                                                 SpacingDecision::Preserve);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  auto child_state =
+      pool.Create(parent_state, style, SpacingDecision::Preserve);
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             parent_state->current_column +  // 5 +
                 tokens[1].text.length()     // 3
@@ -208,7 +231,7 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateSpaces) {
   ftokens[1].before.preserved_space_start = ftokens[0].Text().end();
   ftokens[1].before.break_penalty = 5;  // ignored because of preserving
 
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());  // 2 + 3
@@ -216,9 +239,9 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateSpaces) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Appended with preserved spaces from original text.
-  auto child_state = std::make_shared<StateNode>(parent_state, style,
-                                                 SpacingDecision::Preserve);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  auto child_state =
+      pool.Create(parent_state, style, SpacingDecision::Preserve);
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             parent_state->current_column +  // 5 +
                 4 +                         // spaces
@@ -242,7 +265,7 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateNewline) {
   ftokens[1].before.preserved_space_start = ftokens[0].Text().end();
   ftokens[1].before.break_penalty = 5;  // ignored because of preserving
 
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());  // 2 + 3
@@ -250,9 +273,9 @@ TEST_F(StateNodeTestFixture, ConstructionPreserveSpacesFromPrevStateNewline) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Appended with preserved spaces from original text.
-  auto child_state = std::make_shared<StateNode>(parent_state, style,
-                                                 SpacingDecision::Preserve);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  auto child_state =
+      pool.Create(parent_state, style, SpacingDecision::Preserve);
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             1 +                          // space after last newline
                 tokens[1].text.length()  // 3
@@ -279,7 +302,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
   ftokens[3].balancing = verible::GroupBalancing::Close;
   ftokens[3].before.spaces_required = 1;
   ftokens[3].before.break_penalty = 3;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());
@@ -294,9 +317,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
     // Second token, also appended to same line as first:
     // > function_caller (
     // >     ^-- next wrap should be here
-    auto child2_state = std::make_shared<StateNode>(child_state, style,
-                                                    SpacingDecision::Append);
-    EXPECT_EQ(child2_state->next(), child_state.get());
+    auto child2_state =
+        pool.Create(child_state, style, SpacingDecision::Append);
+    EXPECT_EQ(child2_state->next(), child_state);
     EXPECT_EQ(child2_state->current_column,
               child_state->current_column +            // 17 +
                   ftokens[1].before.spaces_required +  // 1 +
@@ -311,9 +334,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // Third token, also appended to same line:
       // > function_caller ( 11
       // >                  ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
-                                                      SpacingDecision::Append);
-      EXPECT_EQ(child3_state->next(), child2_state.get());
+      auto child3_state =
+          pool.Create(child2_state, style, SpacingDecision::Append);
+      EXPECT_EQ(child3_state->next(), child2_state);
       EXPECT_EQ(child3_state->current_column,
                 child2_state->current_column +           // 19 +
                     ftokens[2].before.spaces_required +  // 1 +
@@ -328,9 +351,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // Fourth token, also appended to same line:
         // > function_caller ( 11 )
         // >     ^-- next wrap should be here, after closing balance group
-        auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Append);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 22 +
                       ftokens[3].before.spaces_required +  // 1 +
@@ -351,9 +374,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >                 )  // aligned with open-group
         // As-is, it is not because we pop the column stack on close-group
         // first, which is not an unreasonable choice.
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Wrap);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   child2_state->wrap_column_positions
                           .top() +  // not a typo: child2_state
@@ -373,9 +396,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // > function_caller (
       // >     11
       // >         ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
-                                                      SpacingDecision::Wrap);
-      EXPECT_EQ(child3_state->next(), child2_state.get());
+      auto child3_state =
+          pool.Create(child2_state, style, SpacingDecision::Wrap);
+      EXPECT_EQ(child3_state->next(), child2_state);
       EXPECT_EQ(child3_state->current_column,
                 initial_column + style.wrap_spaces + tokens[2].text.length());
       EXPECT_EQ(child3_state->cumulative_cost, ftokens[2].before.break_penalty);
@@ -390,9 +413,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // > function_caller (
         // >     11 )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Append);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 8
                       ftokens[3].before.spaces_required +  // 1
@@ -412,9 +435,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >     11
         // >     )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Wrap);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   initial_column + style.wrap_spaces + tokens[3].text.length());
         EXPECT_EQ(
@@ -436,8 +459,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
     // >     (
     // >     ^-- next wrap should be here
     auto child2_state =
-        std::make_shared<StateNode>(child_state, style, SpacingDecision::Wrap);
-    EXPECT_EQ(child2_state->next(), child_state.get());
+        pool.Create(child_state, style, SpacingDecision::Wrap);
+    EXPECT_EQ(child2_state->next(), child_state);
     EXPECT_EQ(child2_state->current_column,
               initial_column +             // 2 +
                   style.wrap_spaces +      // 4 +
@@ -456,9 +479,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // > function_caller
       // >     ( 11
       // >     ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
-                                                      SpacingDecision::Append);
-      EXPECT_EQ(child3_state->next(), child2_state.get());
+      auto child3_state =
+          pool.Create(child2_state, style, SpacingDecision::Append);
+      EXPECT_EQ(child3_state->next(), child2_state);
       EXPECT_EQ(child3_state->current_column,
                 child2_state->current_column +           // 7
                     ftokens[2].before.spaces_required +  // 1
@@ -476,9 +499,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // > function_caller
         // >     ( 11 )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Append);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 10
                       ftokens[3].before.spaces_required +  // 1
@@ -498,9 +521,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >     ( 11
         // >     )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Wrap);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   child2_state->wrap_column_positions.top() +
                       tokens[3].text.length()  // 1: ")"
@@ -523,9 +546,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
       // >     (
       // >         11
       // >         ^-- next wrap should be here
-      auto child3_state = std::make_shared<StateNode>(child2_state, style,
-                                                      SpacingDecision::Wrap);
-      EXPECT_EQ(child3_state->next(), child2_state.get());
+      auto child3_state =
+          pool.Create(child2_state, style, SpacingDecision::Wrap);
+      EXPECT_EQ(child3_state->next(), child2_state);
       EXPECT_EQ(child3_state->current_column,
                 initial_column + (style.wrap_spaces * 2) +  // 10
                     tokens[2].text.length()                 // 2: "11"
@@ -546,9 +569,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >     (
         // >         11 )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(
-            child3_state, style, SpacingDecision::Append);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Append);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   child3_state->current_column +           // 10
                       ftokens[3].before.spaces_required +  // 1
@@ -570,9 +593,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateWithGroupBalancing) {
         // >         11
         // >     )
         // >     ^-- next wrap should be here
-        auto child4_state = std::make_shared<StateNode>(child3_state, style,
-                                                        SpacingDecision::Wrap);
-        EXPECT_EQ(child4_state->next(), child3_state.get());
+        auto child4_state =
+            pool.Create(child3_state, style, SpacingDecision::Wrap);
+        EXPECT_EQ(child4_state->next(), child3_state);
         EXPECT_EQ(child4_state->current_column,
                   child_state->wrap_column_positions.top() +
                       tokens[3].text.length()  // 1: ")"
@@ -606,7 +629,7 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateOverflow) {
   ftokens[1].before.break_penalty = 8;
 
   // First token on line:
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());
@@ -616,9 +639,9 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateOverflow) {
 
   {
     // Second token, also appended to same line as first:
-    auto child2_state = std::make_shared<StateNode>(child_state, style,
-                                                    SpacingDecision::Append);
-    EXPECT_EQ(child2_state->next(), child_state.get());
+    auto child2_state =
+        pool.Create(child_state, style, SpacingDecision::Append);
+    EXPECT_EQ(child2_state->next(), child_state);
     EXPECT_EQ(child2_state->current_column,
               child_state->current_column +            // 8 +
                   ftokens[1].before.spaces_required +  // 1 +
@@ -631,8 +654,8 @@ TEST_F(StateNodeTestFixture, ConstructionAppendingPrevStateOverflow) {
   {
     // Second token, but wrapped onto a new line:
     auto child2_state =
-        std::make_shared<StateNode>(child_state, style, SpacingDecision::Wrap);
-    EXPECT_EQ(child2_state->next(), child_state.get());
+        pool.Create(child_state, style, SpacingDecision::Wrap);
+    EXPECT_EQ(child2_state->next(), child_state);
     EXPECT_EQ(child2_state->current_column,
               initial_column +         // 2 +
                   style.wrap_spaces +  // 4 +
@@ -649,7 +672,7 @@ TEST_F(StateNodeTestFixture, ConstructionWrappingLinePrevState) {
   Initialize(kInitialIndent, tokens);
   auto& ftokens = pre_format_tokens_;
   ftokens[1].before.break_penalty = 7;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());
@@ -657,8 +680,8 @@ TEST_F(StateNodeTestFixture, ConstructionWrappingLinePrevState) {
 
   // Wrap the next token onto a new line.
   auto child_state =
-      std::make_shared<StateNode>(parent_state, style, SpacingDecision::Wrap);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+      pool.Create(parent_state, style, SpacingDecision::Wrap);
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             initial_column + style.wrap_spaces + tokens[1].text.length());
   EXPECT_EQ(child_state->cumulative_cost, ftokens[1].before.break_penalty);
@@ -682,7 +705,7 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsTryToAppend) {
   ftokens[0].before.spaces_required = 1;
   ftokens[1].before.spaces_required = 1;
   ftokens[2].before.spaces_required = 1;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());
@@ -692,9 +715,9 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsTryToAppend) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Second token, also appended to same line as first:
-  auto child_state = StateNode::AppendIfItFits(parent_state, style);
+  auto child_state = StateNode::AppendIfItFits(parent_state, style, &pool);
   EXPECT_EQ(child_state->spacing_choice, SpacingDecision::Append);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             parent_state->current_column +           // 12 +
                 ftokens[1].before.spaces_required +  // 1 +
@@ -703,9 +726,9 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsTryToAppend) {
   EXPECT_FALSE(child_state->IsRootState());
 
   // Third token, doesn't fit, and will be wrapped.
-  auto child2_state = StateNode::AppendIfItFits(child_state, style);
+  auto child2_state = StateNode::AppendIfItFits(child_state, style, &pool);
   EXPECT_EQ(child2_state->spacing_choice, SpacingDecision::Wrap);
-  EXPECT_EQ(child2_state->next(), child_state.get());
+  EXPECT_EQ(child2_state->next(), child_state);
   EXPECT_EQ(child2_state->current_column,
             initial_column + style.wrap_spaces + tokens[2].text.length());
 }
@@ -723,7 +746,7 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsForcedWrap) {
   ftokens[1].before.spaces_required = 1;
   // Tokens stay under column limit, but here, we force a wrap.
   ftokens[1].before.break_decision = SpacingOptions::MustWrap;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());
@@ -733,9 +756,9 @@ TEST_F(StateNodeTestFixture, AppendIfItFitsForcedWrap) {
   EXPECT_TRUE(parent_state->IsRootState());
 
   // Second token, forced to wrap onto new line.
-  auto child_state = StateNode::AppendIfItFits(parent_state, style);
+  auto child_state = StateNode::AppendIfItFits(parent_state, style, &pool);
   EXPECT_EQ(child_state->spacing_choice, SpacingDecision::Wrap);
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  EXPECT_EQ(child_state->next(), parent_state);
   EXPECT_EQ(child_state->current_column,
             initial_column + style.wrap_spaces + tokens[0].text.length());
   EXPECT_FALSE(child_state->IsRootState());
@@ -755,7 +778,7 @@ TEST_F(StateNodeTestFixture, QuickFinish) {
   ftokens[0].before.spaces_required = 1;
   ftokens[1].before.spaces_required = 1;
   ftokens[2].before.spaces_required = 1;
-  auto parent_state = std::make_shared<StateNode>(*uwline, style);
+  auto parent_state = pool.Create(*uwline, style);
   const int initial_column = kInitialIndent * style.indentation_spaces;  // 2
   EXPECT_EQ(ABSL_DIE_IF_NULL(parent_state)->current_column,
             initial_column + tokens[0].text.length());
@@ -764,7 +787,7 @@ TEST_F(StateNodeTestFixture, QuickFinish) {
             initial_column + style.wrap_spaces);
   EXPECT_TRUE(parent_state->IsRootState());
 
-  auto final_state = StateNode::QuickFinish(parent_state, style);
+  auto final_state = StateNode::QuickFinish(parent_state, style, &pool);
 
   // Checking up the ancestry chain of previous states
   // Third token, doesn't fit, and will be wrapped.
@@ -775,7 +798,7 @@ TEST_F(StateNodeTestFixture, QuickFinish) {
   EXPECT_EQ(child_state->spacing_choice, SpacingDecision::Append);
 
   // Second state is decended from initial state.
-  EXPECT_EQ(child_state->next(), parent_state.get());
+  EXPECT_EQ(child_state->next(), parent_state);
 }
 
 // Tests that equal cumulative penalty does not count as less.
@@ -807,11 +830,26 @@ TEST_F(StateNodeTestFixture, Stringify) {
   s.spacing_choice = SpacingDecision::Wrap;
   s.current_column = 7;
   s.cumulative_cost = 11;
-  s.wrap_column_positions.top() = 3;
+  WrapColumnStack::Frame frame;
+  s.wrap_column_positions.pop();
+  s.wrap_column_positions.push(&frame, 3);
   std::ostringstream stream;
   stream << s;
   EXPECT_EQ(stream.str(), "spacing:wrap, col@7, cost=11, [...3]");
 }
 
+// Tests that a pool keeps many states alive across blocks.
+TEST_F(StateNodeTestFixture, PoolOwnsLongChains) {
+  const int kNumTokens = 1000;
+  std::vector<TokenInfo> tokens;
+  for (int i = 0; i < kNumTokens; ++i) tokens.push_back({i, "x"});
+  Initialize(1, tokens);
+  const StateNode* state =
+      StateNode::QuickFinish(pool.Create(*uwline, style), style, &pool);
+  EXPECT_TRUE(state->Done());
+  EXPECT_EQ(state->Depth(), kNumTokens);
+  EXPECT_GE(pool.size(), kNumTokens);
+}
+
 }  // namespace
 }  // namespace verible
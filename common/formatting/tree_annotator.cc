@@ -34,17 +34,28 @@ class TreeAnnotator : public TreeContextVisitor {
   TreeAnnotator(const Symbol* syntax_tree_root, const TokenInfo& eof_token,
                 std::vector<PreFormatToken>::iterator tokens_begin,
                 std::vector<PreFormatToken>::iterator tokens_end,
-                const ContextTokenAnnotatorFunction& annotator)
+                const ContextTokenAnnotatorFunction& annotator,
+                SyntaxContextListener* listener)
       : eof_token_(eof_token),
         syntax_tree_root_(syntax_tree_root),
         token_annotator_(annotator),
+        context_listener_(listener),
         next_filtered_token_(tokens_begin),
         end_filtered_token_(tokens_end) {}
 
   void Annotate();
 
  private:                           // methods
-  using TreeContextVisitor::Visit;  // for SyntaxTreeNode
+  void Visit(const SyntaxTreeNode& node) override {
+    if (context_listener_ == nullptr) {
+      TreeContextVisitor::Visit(node);
+      return;
+    }
+    context_listener_->Push(node);
+    TreeContextVisitor::Visit(node);
+    context_listener_->Pop();
+  }
+
   void Visit(const SyntaxTreeLeaf& leaf) override {
     CatchUpToCurrentLeaf(leaf.get());
   }
@@ -68,6 +79,9 @@ class TreeAnnotator : public TreeContextVisitor {
   // Function used to annotate the PreFormatTokens.
   ContextTokenAnnotatorFunction token_annotator_;
 
+  // Optional observer of context pushes and pops (not owned).
+  SyntaxContextListener* context_listener_ = nullptr;
+
   // Pointer to last token that was visited.
   // This gets passed to the first parameter (left token) of the
   // token_annotator_ function.
@@ -116,9 +130,10 @@ void AnnotateFormatTokensUsingSyntaxContext(
     const Symbol* syntax_tree_root, const TokenInfo& eof_token,
     std::vector<PreFormatToken>::iterator tokens_begin,
     std::vector<PreFormatToken>::iterator tokens_end,
-    const ContextTokenAnnotatorFunction& annotator) {
+    const ContextTokenAnnotatorFunction& annotator,
+    SyntaxContextListener* listener) {
   TreeAnnotator t(syntax_tree_root, eof_token, tokens_begin, tokens_end,
-                  annotator);
+                  annotator, listener);
   t.Annotate();
 }
 
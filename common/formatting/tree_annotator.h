@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "common/formatting/format_token.h"
+#include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "common/text/token_info.h"
@@ -29,13 +30,29 @@ namespace verible {
 using ContextTokenAnnotatorFunction = std::function<void(
     const PreFormatToken&, PreFormatToken*, const SyntaxTreeContext&)>;
 
+// Receives notifications in step with pushes and pops of the syntax tree
+// context, so that annotators can maintain context-derived state
+// incrementally, instead of searching the whole context at every token.
+class SyntaxContextListener {
+ public:
+  virtual ~SyntaxContextListener() = default;
+
+  // Called when 'node' is about to be pushed onto the context.
+  virtual void Push(const SyntaxTreeNode& node) = 0;
+
+  // Called when the most recently pushed node has been popped.
+  virtual void Pop() = 0;
+};
+
 // Applies inter-token formatting annotations, using syntactic context
 // at every token.
+// If 'listener' is non-null, it is notified of every context push and pop.
 void AnnotateFormatTokensUsingSyntaxContext(
     const Symbol* syntax_tree_root, const TokenInfo& eof_token,
     std::vector<PreFormatToken>::iterator tokens_begin,
     std::vector<PreFormatToken>::iterator tokens_end,
-    const ContextTokenAnnotatorFunction& annotator);
+    const ContextTokenAnnotatorFunction& annotator,
+    SyntaxContextListener* listener = nullptr);
 
 }  // namespace verible
 
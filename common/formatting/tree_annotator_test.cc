@@ -128,5 +128,54 @@ TEST(AnnotateFormatTokensUsingSyntaxContextTest, UsingContext) {
   EXPECT_EQ(ftokens[2].before.spaces_required, kForcedSpaces);
 }
 
+// Tracks the depth of the context through listener notifications.
+class DepthListener : public SyntaxContextListener {
+ public:
+  void Push(const SyntaxTreeNode& node) override {
+    tags_.push_back(node.Tag().tag);
+  }
+  void Pop() override { tags_.pop_back(); }
+
+  const std::vector<int>& Tags() const { return tags_; }
+
+ private:
+  std::vector<int> tags_;
+};
+
+TEST(AnnotateFormatTokensUsingSyntaxContextTest, ListenerFollowsContext) {
+  const absl::string_view text("abc");
+  const TokenInfo tokens[] = {
+      {4, text.substr(0, 1)},
+      {5, text.substr(1, 1)},
+      {6, text.substr(2, 1)},
+      {verible::TK_EOF, text.substr(3, 0)},  // EOF
+  };
+  std::vector<PreFormatToken> ftokens;
+  for (const auto& t : tokens) {
+    ftokens.emplace_back(&t);
+  }
+  const auto tree = TNode(6,                                     //
+                          TNode(7, Leaf(tokens[0])),             //
+                          TNode(8, TNode(10, Leaf(tokens[1]))),  //
+                          TNode(9, Leaf(tokens[2]))              //
+  );
+  DepthListener listener;
+  int annotations = 0;
+  AnnotateFormatTokensUsingSyntaxContext(
+      &*tree, tokens[3], ftokens.begin(), ftokens.end(),
+      [&](const PreFormatToken&, PreFormatToken*,
+          const SyntaxTreeContext& context) {
+        ++annotations;
+        ASSERT_EQ(listener.Tags().size(), context.size());
+        auto tag_iter = listener.Tags().begin();
+        for (const auto* node : context) {
+          EXPECT_EQ(*tag_iter++, node->Tag().tag);
+        }
+      },
+      &listener);
+  EXPECT_EQ(annotations, 3);
+  EXPECT_TRUE(listener.Tags().empty());
+}
+
 }  // namespace
 }  // namespace verible
@@ -32,6 +32,7 @@
 #ifndef VERIBLE_COMMON_LEXER_FLEX_LEXER_ADAPTER_H_
 #define VERIBLE_COMMON_LEXER_FLEX_LEXER_ADAPTER_H_
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
@@ -51,12 +52,10 @@ namespace verible {
 // ordered before "L" in FlexLexerAdaptor's base classes.
 class CodeStreamHolder {
  protected:
-  // The stream object conforms to the FlexLexer input interface.
-  // Even though scanning is done on the stream's internal copy of the input
-  // string, the byte offsets being tracked can be used to construct
-  // string_views based on the original string's start address.
-  // Using the standard istream interface also lets us switch buffers, e.g.
-  // during preprocessing.
+  // The stream object conforms to the FlexLexer input interface, which
+  // requires a stream for construction and yyrestart().
+  // It is always empty: input is never read through it, because
+  // FlexLexerAdapter::LexerInput() reads directly from the caller's buffer.
   std::istringstream code_stream_;
 };
 
@@ -67,11 +66,9 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
   explicit FlexLexerAdapter(absl::string_view code)
       : L(&code_stream_),
         code_(code),
+        unread_code_(code),
         // last_token_ points to the beginning of the code_ buffer
-        last_token_(0 /* enum doesn't matter */, code_.substr(0, 0)) {
-    code_stream_.str(std::string(code));
-    // istringstream copies text into its own internal buffer.
-  }
+        last_token_(0 /* enum doesn't matter */, code_.substr(0, 0)) {}
 
   // Returns the token associated with the last UpdateLocation() call.
   const TokenInfo& GetLastToken() const override { return last_token_; }
@@ -90,7 +87,7 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
   // Restart lexer by pointing to new input stream, and reset all state.
   void Restart(absl::string_view code) override {
     code_ = code;
-    code_stream_.str(std::string(code_));
+    unread_code_ = code;
     last_token_ = TokenInfo(0, code_.substr(0, 0));
 
     // Reset buffer stack.
@@ -107,6 +104,20 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
     }
   }
 
+  // Overrides yyFlexLexer's implementation to feed flex's scan buffer
+  // directly from code_, without an intermediate copy of the whole text or
+  // the overhead of the istream interface.
+  // (Flex's C++ scanners have no equivalent of yy_scan_buffer(), so reading
+  // chunks straight from the original memory is the closest alternative.)
+  // Returns the number of bytes copied into 'buf', 0 at end-of-input.
+  int LexerInput(char* buf, int max_size) override {
+    const size_t size =
+        std::min(static_cast<size_t>(max_size), unread_code_.size());
+    std::copy_n(unread_code_.data(), size, buf);
+    unread_code_.remove_prefix(size);
+    return size;
+  }
+
   // Overrides yyFlexLexer's implementation to handle unrecognized chars.
   virtual void LexerOutput(const char* buf, int size) {
     VLOG(1) << "LexerOutput: rejected text: \"" << std::string(buf, size)
@@ -131,6 +142,9 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
   // A read-only view of the entire text to be scanned.
   absl::string_view code_;
 
+  // The suffix of code_ that has not yet been handed to flex's buffer.
+  absl::string_view unread_code_;
+
   // Contains the enumeration and the substring slice of the last lexed token.
   TokenInfo last_token_;
 };
@@ -25,12 +25,14 @@
 #define VERIBLE_COMMON_PARSER_BISON_PARSER_ADAPTER_H_
 
 #include <cstddef>  // for size_t
+#include <memory>
 #include <vector>
 
 #include "common/lexer/token_generator.h"
 #include "common/parser/parse.h"
 #include "common/parser/parser_param.h"
 #include "common/text/concrete_syntax_tree.h"
+#include "common/text/syntax_tree_arena.h"
 #include "common/text/token_info.h"
 #include "common/util/status.h"
 
@@ -40,11 +42,18 @@ namespace verible {
 template <int (*ParseFunc)(ParserParam*)>
 class BisonParserAdapter : public Parser {
  public:
-  explicit BisonParserAdapter(TokenGenerator* token_generator)
-      : Parser(), param_(token_generator) {}
+  // If 'use_arena' is true, the syntax tree is built in an arena, which
+  // must be taken along with the tree (TakeArena()).
+  explicit BisonParserAdapter(TokenGenerator* token_generator,
+                              bool use_arena = false)
+      : Parser(), param_(token_generator, use_arena) {}
 
   util::Status Parse() override {
-    int result = ParseFunc(&param_);
+    int result;
+    {
+      ScopedSyntaxTreeArena arena_scope(param_.Arena());
+      result = ParseFunc(&param_);
+    }
     // Results of parsing are stored in param_.
     VLOG(3) << "max_used_stack_size : " << MaxUsedStackSize();
     if (result == 0 && param_.RecoveredSyntaxErrors().empty()) {
@@ -69,6 +78,10 @@ class BisonParserAdapter : public Parser {
 
   ConcreteSyntaxTree TakeRoot() override { return param_.TakeRoot(); }
 
+  std::shared_ptr<SyntaxTreeArena> TakeArena() override {
+    return param_.TakeArena();
+  }
+
   size_t MaxUsedStackSize() const { return param_.MaxUsedStackSize(); }
 
  private:
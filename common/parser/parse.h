@@ -17,9 +17,11 @@
 #ifndef VERIBLE_COMMON_PARSER_PARSE_H_
 #define VERIBLE_COMMON_PARSER_PARSE_H_
 
+#include <memory>
 #include <vector>
 
 #include "common/text/concrete_syntax_tree.h"
+#include "common/text/syntax_tree_arena.h"
 #include "common/text/token_info.h"
 #include "common/util/status.h"
 
@@ -37,6 +39,10 @@ class Parser {
   // Transfer ownership of tree root.
   virtual ConcreteSyntaxTree TakeRoot() = 0;
 
+  // Transfer ownership of the arena that holds the tree's memory, if any.
+  // The arena must be kept alive at least as long as the tree.
+  virtual std::shared_ptr<SyntaxTreeArena> TakeArena() = 0;
+
   // Return the location of the first error token.
   virtual const TokenInfo& GetLastToken() const = 0;
 
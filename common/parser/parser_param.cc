@@ -18,20 +18,23 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "common/lexer/token_generator.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
+#include "common/text/syntax_tree_arena.h"
 #include "common/text/token_info.h"
 #include "common/util/logging.h"
 
 namespace verible {
 
-ParserParam::ParserParam(TokenGenerator* token_stream)
+ParserParam::ParserParam(TokenGenerator* token_stream, bool use_arena)
     : token_stream_(token_stream),
       last_token_(TokenInfo::EOFToken()),
+      arena_(use_arena ? std::make_shared<SyntaxTreeArena>() : nullptr),
       root_(),
       state_stack_(),
       value_stack_(),
@@ -21,11 +21,13 @@
 
 #include <cstddef>  // for size_t
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "common/lexer/token_generator.h"
 #include "common/text/concrete_syntax_tree.h"
+#include "common/text/syntax_tree_arena.h"
 #include "common/text/token_info.h"
 
 namespace verible {
@@ -40,7 +42,9 @@ class ParserParam {
   using ValueStack = std::vector<SymbolPtr>;
 
  public:
-  explicit ParserParam(TokenGenerator* token_stream);
+  // If 'use_arena' is true, the syntax tree built during parsing is allocated
+  // from an arena owned by this object (see Arena()).
+  explicit ParserParam(TokenGenerator* token_stream, bool use_arena = false);
 
   ~ParserParam();
 
@@ -75,6 +79,14 @@ class ParserParam {
   // Takes ownership of syntax tree.
   void SetRoot(ConcreteSyntaxTree r) { root_ = std::move(r); }
 
+  // Arena in which to allocate syntax tree symbols, or nullptr to use the
+  // heap.  Install this with a ScopedSyntaxTreeArena while parsing.
+  SyntaxTreeArena* Arena() const { return arena_.get(); }
+
+  // Relinquishes ownership of the arena.  The arena must outlive the tree
+  // that was built in it, so callers of TakeRoot() should take both.
+  std::shared_ptr<SyntaxTreeArena> TakeArena() { return std::move(arena_); }
+
  private:
   // Container of syntax-rejected tokens.
   // TODO(fangism): Pair this with recovery token, the point at which
@@ -83,6 +95,10 @@ class ParserParam {
 
   TokenGenerator* token_stream_;
   TokenInfo last_token_;
+
+  // Backing memory for symbols, must outlive root_ and value_stack_.
+  std::shared_ptr<SyntaxTreeArena> arena_;
+
   ConcreteSyntaxTree root_;
 
   // Overflow storage for parser's internal symbol and value stack.
@@ -0,0 +1,205 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/strings/line_scan.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace verible {
+namespace {
+
+constexpr int kBlockSize = 32;
+
+// Bit i of each mask describes byte i of a block.
+struct BlockMasks {
+  uint32_t newline;
+  uint32_t tab;
+  uint32_t non_space;  // not one of " \t\n\v\f\r"
+};
+
+#if defined(__AVX2__)
+BlockMasks ClassifyBlock(const char* p) {
+  const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  const __m256i newline = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'));
+  const __m256i tab = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'));
+  const __m256i space = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+  // '\t' through '\r' are contiguous: [9, 13].
+  const __m256i ctrl = _mm256_cmpeq_epi8(
+      _mm256_max_epu8(_mm256_sub_epi8(bytes, _mm256_set1_epi8('\t')),
+                      _mm256_set1_epi8('\r' - '\t')),
+      _mm256_set1_epi8('\r' - '\t'));
+  BlockMasks masks;
+  masks.newline = _mm256_movemask_epi8(newline);
+  masks.tab = _mm256_movemask_epi8(tab);
+  masks.non_space = ~static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_or_si256(space, ctrl)));
+  return masks;
+}
+#elif defined(__SSE2__)
+BlockMasks ClassifyHalfBlock(const char* p) {
+  const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  const __m128i newline = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'));
+  const __m128i tab = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'));
+  const __m128i space = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+  // '\t' through '\r' are contiguous: [9, 13].
+  const __m128i ctrl =
+      _mm_cmpeq_epi8(_mm_max_epu8(_mm_sub_epi8(bytes, _mm_set1_epi8('\t')),
+                                  _mm_set1_epi8('\r' - '\t')),
+                     _mm_set1_epi8('\r' - '\t'));
+  BlockMasks masks;
+  masks.newline = _mm_movemask_epi8(newline);
+  masks.tab = _mm_movemask_epi8(tab);
+  masks.non_space = ~_mm_movemask_epi8(_mm_or_si128(space, ctrl)) & 0xFFFF;
+  return masks;
+}
+
+BlockMasks ClassifyBlock(const char* p) {
+  const BlockMasks lo = ClassifyHalfBlock(p);
+  const BlockMasks hi = ClassifyHalfBlock(p + 16);
+  return {lo.newline | hi.newline << 16, lo.tab | hi.tab << 16,
+          lo.non_space | hi.non_space << 16};
+}
+#else
+BlockMasks ClassifyBlock(const char* p) {
+  BlockMasks masks = {0, 0, 0};
+  for (int i = 0; i < kBlockSize; ++i) {
+    const char c = p[i];
+    const uint32_t bit = uint32_t{1} << i;
+    if (c == '\n') masks.newline |= bit;
+    if (c == '\t') masks.tab |= bit;
+    if (c != ' ' && (c < '\t' || c > '\r')) masks.non_space |= bit;
+  }
+  return masks;
+}
+#endif
+
+int LowestBit(uint32_t mask) { return __builtin_ctz(mask); }
+
+int HighestBit(uint32_t mask) { return 31 - __builtin_clz(mask); }
+
+// Accumulates the state of the line that is currently being scanned.
+class LineScanner {
+ public:
+  LineScanner(absl::string_view text, std::vector<absl::string_view>* lines,
+              std::vector<LineStats>* stats)
+      : text_(text), lines_(lines), stats_(stats) {}
+
+  // Consumes the classified bytes [offset, offset + width) of text_.
+  void ConsumeBlock(int offset, int width, BlockMasks masks) {
+    const uint32_t valid =
+        width == kBlockSize ? ~uint32_t{0} : (uint32_t{1} << width) - 1;
+    masks.newline &= valid;
+    masks.tab &= valid;
+    masks.non_space &= valid;
+    uint32_t remaining = valid;
+    while (remaining != 0) {
+      // Bits of the current line segment within this block.
+      uint32_t segment = remaining;
+      if (masks.newline != 0) {
+        const uint32_t newline_bit = masks.newline & -masks.newline;
+        segment &= newline_bit - 1;
+        masks.newline &= ~newline_bit;
+        ConsumeSegment(offset, masks, segment);
+        EndLine(offset + LowestBit(newline_bit));
+        remaining &= ~(segment | newline_bit);
+      } else {
+        ConsumeSegment(offset, masks, segment);
+        remaining = 0;
+      }
+    }
+  }
+
+  void Finish() { EndLine(text_.length()); }
+
+ private:
+  void ConsumeSegment(int offset, const BlockMasks& masks, uint32_t segment) {
+    const uint32_t tabs = masks.tab & segment;
+    if (first_tab_ < 0 && tabs != 0) {
+      first_tab_ = offset + LowestBit(tabs);
+    }
+    const uint32_t non_space = masks.non_space & segment;
+    if (non_space != 0) {
+      content_end_ = offset + HighestBit(non_space) + 1;
+    }
+  }
+
+  // Terminates the line that ends at 'end' (the offset of its '\n').
+  void EndLine(int end) {
+    lines_->push_back(text_.substr(line_begin_, end - line_begin_));
+    if (stats_ != nullptr) {
+      LineStats line_stats;
+      line_stats.first_tab = first_tab_ < 0 ? -1 : first_tab_ - line_begin_;
+      line_stats.trailing_space = content_end_ - line_begin_;
+      stats_->push_back(line_stats);
+    }
+    line_begin_ = end + 1;
+    first_tab_ = -1;
+    content_end_ = line_begin_;
+  }
+
+  const absl::string_view text_;
+  std::vector<absl::string_view>* const lines_;
+  std::vector<LineStats>* const stats_;
+
+  // Offset of the first byte of the current line.
+  int line_begin_ = 0;
+
+  // Offset of the first tab on the current line, or -1.
+  int first_tab_ = -1;
+
+  // Offset following the last non-space byte on the current line.
+  int content_end_ = 0;
+};
+
+}  // namespace
+
+void ScanLines(absl::string_view text, std::vector<absl::string_view>* lines,
+               std::vector<LineStats>* stats) {
+  lines->clear();
+  if (stats != nullptr) stats->clear();
+  LineScanner scanner(text, lines, stats);
+  const int length = text.length();
+  int offset = 0;
+  for (; offset + kBlockSize <= length; offset += kBlockSize) {
+    scanner.ConsumeBlock(offset, kBlockSize, ClassifyBlock(text.data() + offset));
+  }
+  if (offset < length) {
+    // Copy the tail into a full block; padding is masked off by width.
+    char block[kBlockSize] = {};
+    std::memcpy(block, text.data() + offset, length - offset);
+    scanner.ConsumeBlock(offset, length - offset, ClassifyBlock(block));
+  }
+  scanner.Finish();
+}
+
+LineStats ScanLine(absl::string_view line) {
+  LineStats stats;
+  const auto tab = line.find('\t');
+  if (tab != absl::string_view::npos) stats.first_tab = tab;
+  const auto last = line.find_last_not_of(" \t\n\v\f\r");
+  stats.trailing_space = last == absl::string_view::npos ? 0 : last + 1;
+  return stats;
+}
+
+}  // namespace verible
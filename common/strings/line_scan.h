@@ -0,0 +1,58 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ScanLines splits text into lines and, in the same pass over the bytes,
+// records where each line's first tab and trailing whitespace are.
+// This saves line-oriented consumers (line splitting, line/column maps,
+// tab and trailing-space lint rules) from each rescanning the same text.
+//
+// Bytes are classified 32 at a time with AVX2 or SSE2 when available,
+// otherwise with a portable scalar loop.
+
+#ifndef VERIBLE_COMMON_STRINGS_LINE_SCAN_H_
+#define VERIBLE_COMMON_STRINGS_LINE_SCAN_H_
+
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace verible {
+
+// Per-line byte classification results.  Columns are 0-based byte offsets
+// from the start of the line.
+struct LineStats {
+  // Column of the first '\t', or -1 if there is none.
+  int first_tab = -1;
+
+  // Column where trailing whitespace (as in std::isspace) begins.
+  // Equals the length of the line if there is no trailing whitespace.
+  int trailing_space = 0;
+
+  bool operator==(const LineStats& r) const {
+    return first_tab == r.first_tab && trailing_space == r.trailing_space;
+  }
+};
+
+// Splits 'text' on '\n' like absl::StrSplit(text, '\n') (lines exclude the
+// newline, and text that ends with '\n' yields a final empty line), and
+// computes the LineStats of every line.  'stats' may be nullptr.
+void ScanLines(absl::string_view text, std::vector<absl::string_view>* lines,
+               std::vector<LineStats>* stats);
+
+// Computes the LineStats of a single line (that contains no '\n').
+LineStats ScanLine(absl::string_view line);
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_STRINGS_LINE_SCAN_H_
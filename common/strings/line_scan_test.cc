@@ -0,0 +1,118 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/strings/line_scan.h"
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+
+namespace verible {
+namespace {
+
+// Straightforward reference implementation.
+LineStats NaiveLineStats(absl::string_view line) {
+  LineStats stats;
+  for (size_t i = 0; i < line.length(); ++i) {
+    if (line[i] == '\t') {
+      stats.first_tab = i;
+      break;
+    }
+  }
+  stats.trailing_space = line.length();
+  while (stats.trailing_space > 0 &&
+         std::isspace(
+             static_cast<unsigned char>(line[stats.trailing_space - 1]))) {
+    --stats.trailing_space;
+  }
+  return stats;
+}
+
+void ExpectScanMatchesReference(absl::string_view text) {
+  std::vector<absl::string_view> lines;
+  std::vector<LineStats> stats;
+  ScanLines(text, &lines, &stats);
+  const std::vector<absl::string_view> expected_lines =
+      absl::StrSplit(text, '\n');
+  ASSERT_EQ(lines.size(), expected_lines.size()) << '"' << text << '"';
+  ASSERT_EQ(stats.size(), lines.size());
+  for (size_t i = 0; i < lines.size(); ++i) {
+    // Compare ranges, not just contents.
+    EXPECT_EQ(lines[i].data(), expected_lines[i].data()) << "line " << i;
+    EXPECT_EQ(lines[i].length(), expected_lines[i].length()) << "line " << i;
+    const LineStats expected = NaiveLineStats(lines[i]);
+    EXPECT_EQ(stats[i].first_tab, expected.first_tab) << "line " << i;
+    EXPECT_EQ(stats[i].trailing_space, expected.trailing_space)
+        << "line " << i;
+    EXPECT_EQ(ScanLine(lines[i]), expected) << "line " << i;
+  }
+}
+
+TEST(ScanLinesTest, Empty) { ExpectScanMatchesReference(""); }
+
+TEST(ScanLinesTest, Short) {
+  for (const char* text :
+       {"a", "\n", "\n\n", "a\n", "\na", "a \n", "\tb", " \t ", "a\tb\tc \n",
+        "x\r\n", "no newline at end  ", "\v\f"}) {
+    ExpectScanMatchesReference(text);
+  }
+}
+
+TEST(ScanLinesTest, Stats) {
+  std::vector<absl::string_view> lines;
+  std::vector<LineStats> stats;
+  ScanLines("ab\tc  \n\n  x", &lines, &stats);
+  ASSERT_EQ(stats.size(), 3);
+  EXPECT_EQ(stats[0].first_tab, 2);
+  EXPECT_EQ(stats[0].trailing_space, 4);
+  EXPECT_EQ(stats[1].first_tab, -1);
+  EXPECT_EQ(stats[1].trailing_space, 0);
+  EXPECT_EQ(stats[2].first_tab, -1);
+  EXPECT_EQ(stats[2].trailing_space, 3);
+}
+
+TEST(ScanLinesTest, NullStats) {
+  std::vector<absl::string_view> lines;
+  ScanLines("a\nb", &lines, nullptr);
+  EXPECT_EQ(lines, (std::vector<absl::string_view>{"a", "b"}));
+}
+
+// Lines and whitespace runs that straddle block boundaries.
+TEST(ScanLinesTest, LongLines) {
+  ExpectScanMatchesReference(std::string(100, ' '));
+  ExpectScanMatchesReference(std::string(31, 'x') + "\t" + std::string(40, ' ') +
+                             "\n" + std::string(64, '\n'));
+  ExpectScanMatchesReference(std::string(33, 'y') + std::string(33, ' ') +
+                             "z\t\n");
+}
+
+TEST(ScanLinesTest, Random) {
+  const char alphabet[] = {'a', ' ', '\t', '\n', '\r', '\v', '\f', '\0',
+                           '\x80', '\xff', '\x08', '\x0e'};
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> pick(0, sizeof(alphabet) - 1);
+  for (int trial = 0; trial < 200; ++trial) {
+    std::string text(trial * 3, 'a');
+    for (auto& c : text) c = alphabet[pick(rng)];
+    ExpectScanMatchesReference(text);
+  }
+}
+
+}  // namespace
+}  // namespace verible
@@ -0,0 +1,64 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_STRINGS_MEM_BLOCK_H_
+#define VERIBLE_COMMON_STRINGS_MEM_BLOCK_H_
+
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
+namespace verible {
+
+// MemBlock owns a contiguous block of read-only text.
+// Holders of a MemBlock (e.g. TextStructure) only need its string_view,
+// regardless of where the memory came from: a std::string, a memory-mapped
+// file, etc.  The memory remains valid for the lifetime of the MemBlock.
+class MemBlock {
+ public:
+  virtual ~MemBlock() = default;
+
+  MemBlock(const MemBlock&) = delete;
+  MemBlock& operator=(const MemBlock&) = delete;
+
+  // Returns a view of the entire owned text.
+  virtual absl::string_view AsStringView() const = 0;
+
+ protected:
+  MemBlock() = default;
+};
+
+// StringMemBlock owns its text in a std::string.
+class StringMemBlock final : public MemBlock {
+ public:
+  StringMemBlock() = default;
+
+  // Takes ownership of 'content'; pass an rvalue to avoid copying.
+  explicit StringMemBlock(std::string content)
+      : content_(std::move(content)) {}
+
+  absl::string_view AsStringView() const override { return content_; }
+
+  // Direct access to the owned string, e.g. for reading data into it.
+  // Must not be modified once string_views into it have been handed out.
+  std::string* mutable_content() { return &content_; }
+
+ private:
+  std::string content_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_STRINGS_MEM_BLOCK_H_
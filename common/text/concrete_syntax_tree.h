@@ -44,6 +44,7 @@
 
 #include "common/text/constants.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_arena.h"
 #include "common/text/tree_compare.h"
 #include "common/text/visitors.h"
 #include "common/util/casts.h"
@@ -72,10 +73,13 @@ struct ForwardChildren {
 // used by various language front-ends.
 class SyntaxTreeNode : public Symbol {
  public:
+  // Children are stored alongside their parent when it is arena-allocated.
+  using ChildContainer = std::vector<SymbolPtr, SyntaxTreeAllocator<SymbolPtr>>;
+
   explicit SyntaxTreeNode(const int tag = kUntagged) : tag_(tag), children_() {}
 
-  const std::vector<SymbolPtr>& children() const { return children_; }
-  std::vector<SymbolPtr>& mutable_children() { return children_; }
+  const ChildContainer& children() const { return children_; }
+  ChildContainer& mutable_children() { return children_; }
 
   // Transfer ownership of argument to this object.
   // Call MakeNode or ExtendNode instead of calling this directly.
@@ -163,7 +167,7 @@ class SyntaxTreeNode : public Symbol {
   int tag_;
 
   // Sequence of pointers to subtrees and nodes.
-  std::vector<SymbolPtr> children_;
+  ChildContainer children_;
 };
 
 // The following functions are intended for use in semantic action blocks
@@ -175,6 +179,8 @@ class SyntaxTreeNode : public Symbol {
 template <typename... Args>
 SymbolPtr MakeNode(Args&&... args) {
   std::unique_ptr<SyntaxTreeNode> node_pointer(new SyntaxTreeNode);
+  // Avoid growing (and abandoning) arena-allocated child arrays.
+  node_pointer->mutable_children().reserve(sizeof...(Args));
   node_pointer->Append(std::forward<Args>(args)...);
   return std::move(node_pointer);
 }
@@ -188,6 +194,7 @@ template <typename Enum, typename... Args>
 SymbolPtr MakeTaggedNode(const Enum tag, Args&&... args) {
   std::unique_ptr<SyntaxTreeNode> node_pointer(
       new SyntaxTreeNode(static_cast<int>(tag)));
+  node_pointer->mutable_children().reserve(sizeof...(Args));
   node_pointer->Append(std::forward<Args>(args)...);
   return std::move(node_pointer);
 }
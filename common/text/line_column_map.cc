@@ -71,4 +71,26 @@ LineColumn LineColumnMap::operator()(int offset) const {
   return LineColumn{line_number, column};
 }
 
+LineColumn LineColumnMap::Cursor::operator()(int offset) {
+  const auto& offsets = map_.beginning_of_line_offsets_;
+  if (offsets.empty()) return LineColumn{0, offset};
+  if (offset < offsets[line_]) {
+    // Went backwards, restart from the beginning.
+    line_ = 0;
+    if (offset < offsets[0]) return LineColumn{0, offset - offsets[0]};
+  }
+  // Gallop forward to bracket the line that contains offset, then binary
+  // search within the bracket: [line_, line_ + step).
+  size_t step = 1;
+  while (line_ + step < offsets.size() && offsets[line_ + step] <= offset) {
+    line_ += step;
+    step *= 2;
+  }
+  const auto begin = offsets.begin() + line_;
+  const auto end = offsets.begin() + std::min(line_ + step, offsets.size());
+  line_ = std::distance(offsets.begin(), std::upper_bound(begin, end, offset));
+  --line_;
+  return LineColumn{static_cast<int>(line_), offset - offsets[line_]};
+}
+
 }  // namespace verible
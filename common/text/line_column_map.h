@@ -70,6 +70,25 @@ class LineColumnMap {
     return beginning_of_line_offsets_;
   }
 
+  // Cursor translates a (mostly) non-decreasing series of byte offsets, such
+  // as the locations of sorted diagnostics, by searching forward from the
+  // previous result instead of over all lines.  Translating v sorted offsets
+  // costs O(v log(n/v)) instead of O(v log n), and never more than one pass
+  // over the n line offsets.  Decreasing offsets restart the search.
+  // The map must outlive the cursor.
+  class Cursor {
+   public:
+    explicit Cursor(const LineColumnMap& map) : map_(map) {}
+
+    LineColumn operator()(int bytes_offset);
+
+   private:
+    const LineColumnMap& map_;
+
+    // Line number of the previous result.
+    size_t line_ = 0;
+  };
+
  private:
   // Index: line number, Value: byte offset that starts the line.
   // The first value will always be 0 because the beginning of the first line
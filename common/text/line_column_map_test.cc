@@ -17,6 +17,7 @@
 #include "common/text/line_column_map.h"
 
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -125,5 +126,34 @@ TEST(LineColumnMapTest, Lookup) {
   }
 }
 
+// This test verifies that a Cursor agrees with random-access lookup, for
+// increasing, repeated and decreasing offsets.
+TEST(LineColumnMapTest, CursorLookup) {
+  for (const auto& test_case : map_test_data) {
+    const LineColumnMap line_map(test_case.text);
+    LineColumnMap::Cursor cursor(line_map);
+    const int length = absl::string_view(test_case.text).length();
+    for (int offset = 0; offset <= length; ++offset) {
+      EXPECT_EQ(cursor(offset), line_map(offset))
+          << "Text: \"" << test_case.text << "\", offset " << offset;
+      EXPECT_EQ(cursor(offset), line_map(offset));  // repeated
+    }
+    for (int offset = length; offset >= 0; --offset) {
+      EXPECT_EQ(cursor(offset), line_map(offset))
+          << "Text: \"" << test_case.text << "\", offset " << offset;
+    }
+  }
+}
+
+// This test verifies that a Cursor can skip over many lines at once.
+TEST(LineColumnMapTest, CursorSkipsLines) {
+  const std::string text(1000, '\n');
+  const LineColumnMap line_map(text);
+  LineColumnMap::Cursor cursor(line_map);
+  for (int offset : {3, 4, 500, 998, 1000}) {
+    EXPECT_EQ(cursor(offset), (LineColumn{offset, 0}));
+  }
+}
+
 }  // namespace
 }  // namespace verible
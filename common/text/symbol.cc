@@ -14,8 +14,11 @@
 
 #include "common/text/symbol.h"
 
+#include <cstddef>
 #include <iostream>
 
+#include "common/text/syntax_tree_arena.h"
+
 namespace verible {
 
 std::ostream& operator<<(std::ostream& stream, SymbolKind kind) {
@@ -28,4 +31,10 @@ std::ostream& operator<<(std::ostream& stream, SymbolKind kind) {
   return stream << "SymbolKind::UNKNOWN";
 }
 
+void* Symbol::operator new(size_t size) {
+  return AllocateSyntaxTreeMemory(size);
+}
+
+void Symbol::operator delete(void* p) { DeallocateSyntaxTreeMemory(p); }
+
 }  // namespace verible
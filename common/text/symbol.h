@@ -18,6 +18,7 @@
 #ifndef VERIBLE_COMMON_TEXT_SYMBOL_H__
 #define VERIBLE_COMMON_TEXT_SYMBOL_H__
 
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <memory>
@@ -82,6 +83,11 @@ class Symbol {
   virtual SymbolKind Kind() const = 0;
   virtual SymbolTag Tag() const = 0;
 
+  // Symbols are allocated from the current thread's SyntaxTreeArena, if one
+  // is active (see syntax_tree_arena.h), and from the heap otherwise.
+  static void *operator new(size_t size);
+  static void operator delete(void *p);
+
  protected:
   Symbol() {}
 };
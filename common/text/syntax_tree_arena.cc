@@ -0,0 +1,89 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/text/syntax_tree_arena.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace verible {
+
+static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+static size_t RoundUpToAlignment(size_t bytes) {
+  return (bytes + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+SyntaxTreeArena::SyntaxTreeArena(size_t block_size)
+    : block_size_(RoundUpToAlignment(block_size)) {}
+
+SyntaxTreeArena::~SyntaxTreeArena() {}
+
+void* SyntaxTreeArena::Allocate(size_t bytes) {
+  bytes = RoundUpToAlignment(bytes);
+  bytes_allocated_ += bytes;
+  if (bytes > block_size_) {
+    // Oversized request: give it a dedicated block, and keep bumping
+    // through the current one.
+    blocks_.emplace_back(new char[bytes]);
+    return blocks_.back().get();
+  }
+  if (static_cast<size_t>(end_ - next_) < bytes) {
+    blocks_.emplace_back(new char[block_size_]);
+    next_ = blocks_.back().get();
+    end_ = next_ + block_size_;
+  }
+  char* result = next_;
+  next_ += bytes;
+  return result;
+}
+
+static thread_local SyntaxTreeArena* current_arena = nullptr;
+
+ScopedSyntaxTreeArena::ScopedSyntaxTreeArena(SyntaxTreeArena* arena)
+    : previous_(current_arena) {
+  current_arena = arena;
+}
+
+ScopedSyntaxTreeArena::~ScopedSyntaxTreeArena() { current_arena = previous_; }
+
+SyntaxTreeArena* CurrentSyntaxTreeArena() { return current_arena; }
+
+namespace {
+// Precedes every allocation, recording where it came from, so that
+// deallocation works regardless of which (if any) arena is current.
+// Its size preserves the alignment of the memory that follows it.
+struct alignas(kAlignment) AllocationHeader {
+  bool from_arena;
+};
+}  // namespace
+
+void* AllocateSyntaxTreeMemory(size_t bytes) {
+  const size_t total = sizeof(AllocationHeader) + bytes;
+  void* block = current_arena != nullptr ? current_arena->Allocate(total)
+                                         : ::operator new(total);
+  auto* header = static_cast<AllocationHeader*>(block);
+  header->from_arena = current_arena != nullptr;
+  return header + 1;
+}
+
+void DeallocateSyntaxTreeMemory(void* p) {
+  if (p == nullptr) return;
+  AllocationHeader* header = static_cast<AllocationHeader*>(p) - 1;
+  // Arena memory is reclaimed all at once when its arena is destroyed.
+  if (!header->from_arena) ::operator delete(header);
+}
+
+}  // namespace verible
@@ -0,0 +1,129 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// SyntaxTreeArena is a bump allocator for syntax tree memory (symbols and
+// their child arrays).  While a ScopedSyntaxTreeArena is active on a thread,
+// every Symbol created on that thread is carved out of the arena, so that
+// a freshly parsed tree is laid out (mostly) contiguously, and its memory is
+// returned in a handful of block deallocations instead of one per symbol.
+//
+// Symbols still have their destructors run when their owning SymbolPtr is
+// destroyed, but releasing arena memory is a no-op; the arena's blocks are
+// freed when the arena itself is destroyed.  Symbols allocated from an arena
+// must therefore not outlive it.  Owners of trees (e.g. TextStructureView)
+// keep the arenas of their trees alive.
+//
+// Sample usage:
+//   auto arena = std::make_shared<SyntaxTreeArena>();
+//   {
+//     ScopedSyntaxTreeArena scope(arena.get());
+//     tree = MakeTaggedNode(...);  // allocated in *arena
+//   }
+
+#ifndef VERIBLE_COMMON_TEXT_SYNTAX_TREE_ARENA_H_
+#define VERIBLE_COMMON_TEXT_SYNTAX_TREE_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace verible {
+
+class SyntaxTreeArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+  explicit SyntaxTreeArena(size_t block_size = kDefaultBlockSize);
+
+  SyntaxTreeArena(const SyntaxTreeArena&) = delete;
+  SyntaxTreeArena& operator=(const SyntaxTreeArena&) = delete;
+
+  // Frees all blocks at once.
+  ~SyntaxTreeArena();
+
+  // Returns 'bytes' of uninitialized memory, aligned for any scalar type.
+  // Requests larger than the block size get their own block.
+  void* Allocate(size_t bytes);
+
+  // Total number of bytes handed out by Allocate().
+  size_t BytesAllocated() const { return bytes_allocated_; }
+
+  // Number of blocks reserved from the heap.
+  size_t NumBlocks() const { return blocks_.size(); }
+
+ private:
+  const size_t block_size_;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+
+  // Unused portion of the most recent block: [next_, end_).
+  char* next_ = nullptr;
+  char* end_ = nullptr;
+
+  size_t bytes_allocated_ = 0;
+};
+
+// Directs syntax tree allocations on the current thread to an arena for the
+// lifetime of this object.  Scopes may be nested; a null arena directs
+// allocations back to the heap.
+class ScopedSyntaxTreeArena {
+ public:
+  explicit ScopedSyntaxTreeArena(SyntaxTreeArena* arena);
+
+  ScopedSyntaxTreeArena(const ScopedSyntaxTreeArena&) = delete;
+  ScopedSyntaxTreeArena& operator=(const ScopedSyntaxTreeArena&) = delete;
+
+  ~ScopedSyntaxTreeArena();
+
+ private:
+  SyntaxTreeArena* const previous_;
+};
+
+// Returns the arena active on the current thread, or nullptr.
+SyntaxTreeArena* CurrentSyntaxTreeArena();
+
+// Allocates from the current thread's arena, or the heap if there is none.
+// Memory must be released with DeallocateSyntaxTreeMemory(), which does
+// not need to know where it came from, nor run on the same thread.
+void* AllocateSyntaxTreeMemory(size_t bytes);
+void DeallocateSyntaxTreeMemory(void* p);
+
+// Standard allocator over AllocateSyntaxTreeMemory(), for containers owned
+// by syntax tree nodes.  All instances are interchangeable.
+template <typename T>
+struct SyntaxTreeAllocator {
+  using value_type = T;
+
+  SyntaxTreeAllocator() = default;
+  template <typename U>
+  SyntaxTreeAllocator(const SyntaxTreeAllocator<U>&) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(AllocateSyntaxTreeMemory(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t) { DeallocateSyntaxTreeMemory(p); }
+
+  template <typename U>
+  bool operator==(const SyntaxTreeAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const SyntaxTreeAllocator<U>&) const {
+    return false;
+  }
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_TEXT_SYNTAX_TREE_ARENA_H_
@@ -0,0 +1,150 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/text/syntax_tree_arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/util/casts.h"
+
+namespace verible {
+namespace {
+
+static bool IsAligned(const void* p) {
+  return reinterpret_cast<uintptr_t>(p) % alignof(std::max_align_t) == 0;
+}
+
+static SymbolPtr Leaf(int token_enum) {
+  return SymbolPtr(new SyntaxTreeLeaf(token_enum, "x"));
+}
+
+TEST(SyntaxTreeArenaTest, AllocationsAreAligned) {
+  SyntaxTreeArena arena;
+  for (size_t bytes : {1, 3, 8, 17, 100}) {
+    EXPECT_TRUE(IsAligned(arena.Allocate(bytes))) << bytes;
+  }
+  EXPECT_EQ(arena.NumBlocks(), 1);
+}
+
+TEST(SyntaxTreeArenaTest, BumpsWithinBlocks) {
+  SyntaxTreeArena arena(256);
+  char* first = static_cast<char*>(arena.Allocate(64));
+  char* second = static_cast<char*>(arena.Allocate(64));
+  EXPECT_EQ(second, first + 64);
+  EXPECT_EQ(arena.NumBlocks(), 1);
+  arena.Allocate(200);  // does not fit in the rest of the first block
+  EXPECT_EQ(arena.NumBlocks(), 2);
+  EXPECT_EQ(arena.BytesAllocated(), 64 + 64 + 208);
+}
+
+TEST(SyntaxTreeArenaTest, OversizedAllocationGetsOwnBlock) {
+  SyntaxTreeArena arena(256);
+  char* first = static_cast<char*>(arena.Allocate(16));
+  arena.Allocate(1000);
+  char* second = static_cast<char*>(arena.Allocate(16));
+  // Bumping continues in the original block.
+  EXPECT_EQ(second, first + 16);
+  EXPECT_EQ(arena.NumBlocks(), 2);
+}
+
+TEST(ScopedSyntaxTreeArenaTest, NestedScopesRestore) {
+  EXPECT_EQ(CurrentSyntaxTreeArena(), nullptr);
+  SyntaxTreeArena outer, inner;
+  {
+    ScopedSyntaxTreeArena outer_scope(&outer);
+    EXPECT_EQ(CurrentSyntaxTreeArena(), &outer);
+    {
+      ScopedSyntaxTreeArena inner_scope(&inner);
+      EXPECT_EQ(CurrentSyntaxTreeArena(), &inner);
+      {
+        ScopedSyntaxTreeArena heap_scope(nullptr);
+        EXPECT_EQ(CurrentSyntaxTreeArena(), nullptr);
+      }
+      EXPECT_EQ(CurrentSyntaxTreeArena(), &inner);
+    }
+    EXPECT_EQ(CurrentSyntaxTreeArena(), &outer);
+  }
+  EXPECT_EQ(CurrentSyntaxTreeArena(), nullptr);
+}
+
+TEST(SyntaxTreeArenaTest, SymbolsAllocatedInScope) {
+  SyntaxTreeArena arena;
+  SymbolPtr tree;
+  {
+    ScopedSyntaxTreeArena scope(&arena);
+    tree = MakeTaggedNode(1, Leaf(2), MakeTaggedNode(3, Leaf(4), Leaf(5)));
+  }
+  // Nodes, leaves, and child arrays.
+  EXPECT_GT(arena.BytesAllocated(), 5 * sizeof(SyntaxTreeLeaf));
+  const size_t bytes = arena.BytesAllocated();
+  // Allocations outside the scope go to the heap.
+  auto* node = down_cast<SyntaxTreeNode*>(tree.get());
+  node->AppendChild(Leaf(6));
+  EXPECT_EQ(arena.BytesAllocated(), bytes);
+  EXPECT_EQ(node->children().size(), 3);
+  // Destroying the tree (outside of any scope) is fine while arena lives.
+  tree = nullptr;
+}
+
+TEST(SyntaxTreeArenaTest, MixedArenaAndHeapSymbols) {
+  SymbolPtr heap_tree = MakeTaggedNode(1, Leaf(2));
+  {
+    SyntaxTreeArena arena;
+    {
+      ScopedSyntaxTreeArena scope(&arena);
+      SymbolPtr arena_tree = MakeTaggedNode(3, Leaf(4));
+      // Heap subtree inside an arena tree.
+      arena_tree = ExtendNode(arena_tree, MakeTaggedNode(5, Leaf(6)));
+      down_cast<SyntaxTreeNode*>(arena_tree.get())
+          ->AppendChild(std::move(heap_tree));
+      EXPECT_EQ(heap_tree.get(), nullptr);
+    }
+    // arena_tree is destroyed before arena.
+  }
+  // Arena subtree inside a heap tree.
+  SyntaxTreeArena arena;
+  SymbolPtr tree = MakeTaggedNode(7);
+  {
+    ScopedSyntaxTreeArena scope(&arena);
+    down_cast<SyntaxTreeNode*>(tree.get())
+        ->AppendChild(MakeTaggedNode(8, Leaf(9)));
+  }
+  tree = nullptr;
+}
+
+TEST(SyntaxTreeAllocatorTest, ContainersUseCurrentArena) {
+  SyntaxTreeArena arena;
+  std::vector<int, SyntaxTreeAllocator<int>> numbers;
+  {
+    ScopedSyntaxTreeArena scope(&arena);
+    numbers.reserve(16);
+  }
+  EXPECT_GE(arena.BytesAllocated(), 16 * sizeof(int));
+  const size_t bytes = arena.BytesAllocated();
+  // Growing outside of the scope moves contents to the heap.
+  numbers.assign(100, 1);
+  EXPECT_EQ(arena.BytesAllocated(), bytes);
+  EXPECT_EQ(numbers.size(), 100);
+}
+
+}  // namespace
+}  // namespace verible
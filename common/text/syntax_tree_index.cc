@@ -0,0 +1,114 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/text/syntax_tree_index.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/syntax_tree_context.h"
+#include "common/text/tree_search_match.h"
+#include "common/text/visitors.h"
+#include "common/util/casts.h"
+
+namespace verible {
+
+// Records every symbol of a tree into a SyntaxTreeIndex, in one pass.
+class SyntaxTreeIndexBuilder : public SymbolVisitor {
+ public:
+  explicit SyntaxTreeIndexBuilder(SyntaxTreeIndex* index) : index_(index) {}
+
+  void Visit(const SyntaxTreeLeaf& leaf) override {
+    Record(leaf, &index_->leaf_positions_);
+  }
+
+  void Visit(const SyntaxTreeNode& node) override {
+    const int position = Record(node, &index_->node_positions_);
+    const int saved_parent = parent_;
+    parent_ = position;
+    for (const auto& child : node.children()) {
+      if (child) child->Accept(this);
+    }
+    parent_ = saved_parent;
+  }
+
+ private:
+  int Record(const Symbol& symbol, std::vector<std::vector<int>>* table) {
+    const int position = index_->symbols_.size();
+    index_->symbols_.push_back({&symbol, parent_});
+    const int tag = symbol.Tag().tag;
+    if (tag >= 0) {
+      const size_t index = tag;
+      if (index >= table->size()) table->resize(index + 1);
+      (*table)[index].push_back(position);
+    }
+    return position;
+  }
+
+  SyntaxTreeIndex* const index_;
+
+  // Position of the node whose children are being visited.
+  int parent_ = -1;
+};
+
+namespace {
+// Exposes SyntaxTreeContext::Push for reconstructing contexts.
+class ContextBuilder : public SyntaxTreeContext {
+ public:
+  using SyntaxTreeContext::Push;
+};
+}  // namespace
+
+SyntaxTreeIndex::SyntaxTreeIndex(const Symbol* root) {
+  if (root == nullptr) return;
+  SyntaxTreeIndexBuilder builder(this);
+  root->Accept(&builder);
+}
+
+const std::vector<int>& SyntaxTreeIndex::PositionsOf(SymbolTag tag) const {
+  static const std::vector<int>* const kEmpty = new std::vector<int>();
+  const auto& table =
+      tag.kind == SymbolKind::kNode ? node_positions_ : leaf_positions_;
+  const size_t index = tag.tag;
+  return (tag.tag >= 0 && index < table.size()) ? table[index] : *kEmpty;
+}
+
+SyntaxTreeContext SyntaxTreeIndex::ContextOf(int position) const {
+  std::vector<const SyntaxTreeNode*> ancestors;
+  for (int parent = symbols_[position].parent; parent >= 0;
+       parent = symbols_[parent].parent) {
+    ancestors.push_back(
+        down_cast<const SyntaxTreeNode*>(symbols_[parent].symbol));
+  }
+  ContextBuilder context;
+  for (auto iter = ancestors.rbegin(); iter != ancestors.rend(); ++iter) {
+    context.Push(**iter);
+  }
+  return context;
+}
+
+std::vector<TreeSearchMatch> SyntaxTreeIndex::FindAll(SymbolTag tag) const {
+  const auto& positions = PositionsOf(tag);
+  std::vector<TreeSearchMatch> matches;
+  matches.reserve(positions.size());
+  for (const int position : positions) {
+    matches.push_back({symbols_[position].symbol, ContextOf(position)});
+  }
+  return matches;
+}
+
+}  // namespace verible
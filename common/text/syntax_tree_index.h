@@ -0,0 +1,79 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// SyntaxTreeIndex maps symbol tags to all symbols in a tree with that tag.
+// It is built in a single traversal, after which finding all nodes of a
+// kind (e.g. all module declarations) no longer requires walking the
+// whole tree.  TextStructureView keeps one for its syntax tree, which is
+// shared by all analyses of that structure.
+
+#ifndef VERIBLE_COMMON_TEXT_SYNTAX_TREE_INDEX_H_
+#define VERIBLE_COMMON_TEXT_SYNTAX_TREE_INDEX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "common/text/symbol.h"
+#include "common/text/syntax_tree_context.h"
+#include "common/text/tree_search_match.h"
+
+namespace verible {
+
+class SyntaxTreeIndex {
+ public:
+  // Indexes every node and leaf under 'root' (inclusive), which may be null.
+  // The tree must outlive this object, and must not be modified while it is
+  // in use.
+  explicit SyntaxTreeIndex(const Symbol* root);
+
+  SyntaxTreeIndex(const SyntaxTreeIndex&) = delete;
+  SyntaxTreeIndex& operator=(const SyntaxTreeIndex&) = delete;
+
+  // Returns all symbols with the given tag, along with their ancestry
+  // (relative to the indexed root), in pre-order.  This is equivalent to
+  // SearchSyntaxTree(root, <tag matcher>), without searching.
+  std::vector<TreeSearchMatch> FindAll(SymbolTag tag) const;
+
+  // Returns the number of symbols with the given tag.
+  size_t Count(SymbolTag tag) const { return PositionsOf(tag).size(); }
+
+  // Returns the total number of indexed symbols.
+  size_t size() const { return symbols_.size(); }
+
+ private:
+  struct IndexedSymbol {
+    const Symbol* symbol;
+    // Position of parent node in symbols_, or -1 for the root.
+    int parent;
+  };
+
+  // Returns the positions in symbols_ of all symbols with 'tag'.
+  const std::vector<int>& PositionsOf(SymbolTag tag) const;
+
+  // Reconstructs the context (ancestors) of the symbol at 'position'.
+  SyntaxTreeContext ContextOf(int position) const;
+
+  // All symbols, in pre-order.
+  std::vector<IndexedSymbol> symbols_;
+
+  // Positions of symbols, indexed by node tag or leaf token enum.
+  std::vector<std::vector<int>> node_positions_;
+  std::vector<std::vector<int>> leaf_positions_;
+
+  friend class SyntaxTreeIndexBuilder;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_TEXT_SYNTAX_TREE_INDEX_H_
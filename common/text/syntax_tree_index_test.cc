@@ -0,0 +1,91 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/text/syntax_tree_index.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/tree_builder_test_util.h"
+#include "common/text/tree_search_match.h"
+
+namespace verible {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Returns the tags of a context, from the root down.
+std::vector<int> ContextTags(const SyntaxTreeContext& context) {
+  std::vector<int> tags;
+  for (const auto* node : context) tags.push_back(node->Tag().tag);
+  return tags;
+}
+
+TEST(SyntaxTreeIndexTest, NullTree) {
+  const SyntaxTreeIndex index(nullptr);
+  EXPECT_EQ(index.size(), 0);
+  EXPECT_TRUE(index.FindAll(NodeTag(1)).empty());
+  EXPECT_EQ(index.Count(LeafTag(1)), 0);
+}
+
+TEST(SyntaxTreeIndexTest, RootOnly) {
+  const SymbolPtr root = TNode(3);
+  const SyntaxTreeIndex index(root.get());
+  EXPECT_EQ(index.size(), 1);
+  const auto matches = index.FindAll(NodeTag(3));
+  ASSERT_EQ(matches.size(), 1);
+  EXPECT_EQ(matches[0].match, root.get());
+  EXPECT_TRUE(matches[0].context.empty());
+}
+
+TEST(SyntaxTreeIndexTest, NodesAndLeavesWithContexts) {
+  const SymbolPtr root = TNode(1,                         //
+                               XLeaf(7),                  //
+                               TNode(2,                   //
+                                     TNode(1, XLeaf(8)),  //
+                                     nullptr,             //
+                                     XLeaf(7)),           //
+                               TNode(3));
+  const SyntaxTreeIndex index(root.get());
+  EXPECT_EQ(index.size(), 7);  // null children are not indexed
+
+  const auto ones = index.FindAll(NodeTag(1));
+  ASSERT_EQ(ones.size(), 2);
+  EXPECT_EQ(ones[0].match, root.get());
+  EXPECT_THAT(ContextTags(ones[0].context), ElementsAre());
+  EXPECT_THAT(ContextTags(ones[1].context), ElementsAre(1, 2));
+
+  const auto sevens = index.FindAll(LeafTag(7));
+  ASSERT_EQ(sevens.size(), 2);
+  EXPECT_THAT(ContextTags(sevens[0].context), ElementsAre(1));
+  EXPECT_THAT(ContextTags(sevens[1].context), ElementsAre(1, 2));
+
+  const auto eights = index.FindAll(LeafTag(8));
+  ASSERT_EQ(eights.size(), 1);
+  EXPECT_THAT(ContextTags(eights[0].context), ElementsAre(1, 2, 1));
+
+  EXPECT_EQ(index.Count(NodeTag(3)), 1);
+  // Node and leaf tags are distinct.
+  EXPECT_EQ(index.Count(LeafTag(1)), 0);
+  EXPECT_EQ(index.Count(NodeTag(7)), 0);
+  // Unknown tags.
+  EXPECT_EQ(index.Count(NodeTag(100)), 0);
+  EXPECT_EQ(index.Count(NodeTag(-1)), 0);
+}
+
+}  // namespace
+}  // namespace verible
@@ -20,18 +20,22 @@
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <mutex>  // IWYU pragma: keep
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
-#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "common/strings/line_scan.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/line_column_map.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_arena.h"
 #include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
 #include "common/text/tree_utils.h"
@@ -44,9 +48,9 @@
 namespace verible {
 
 TextStructureView::TextStructureView(absl::string_view contents)
-    : contents_(contents),
-      lines_(absl::StrSplit(contents_, '\n')),  // SplitLines()
-      line_column_map_(lines_) {
+    : contents_(contents), line_column_map_(std::vector<absl::string_view>()) {
+  SplitLines();
+  RecalculateLineColumnMap();
   // more than sufficient memory as number-of-tokens <= bytes-in-file,
   // push_back() should never re-alloc because size <= initial capacity.
   tokens_.reserve(contents.length());
@@ -64,13 +68,35 @@ TextStructureView::~TextStructureView() {
 }
 
 void TextStructureView::Clear() {
+  InvalidateSyntaxTreeIndex();
   syntax_tree_ = nullptr;
+  syntax_tree_arenas_.clear();
   line_column_map_.Clear();
   line_token_map_.clear();
   tokens_view_.clear();
   tokens_.clear();
   contents_ = contents_.substr(0, 0);  // clear
   lines_.clear();
+  line_stats_.clear();
+}
+
+const SyntaxTreeIndex& TextStructureView::GetSyntaxTreeIndex() const {
+  std::lock_guard<std::mutex> lock(syntax_tree_index_mutex_);
+  if (syntax_tree_index_ == nullptr) {
+    syntax_tree_index_ =
+        absl::make_unique<SyntaxTreeIndex>(syntax_tree_.get());
+  }
+  return *syntax_tree_index_;
+}
+
+void TextStructureView::InvalidateSyntaxTreeIndex() {
+  std::lock_guard<std::mutex> lock(syntax_tree_index_mutex_);
+  syntax_tree_index_ = nullptr;
+}
+
+void TextStructureView::AdoptSyntaxTreeArena(
+    std::shared_ptr<SyntaxTreeArena> arena) {
+  if (arena != nullptr) syntax_tree_arenas_.push_back(std::move(arena));
 }
 
 static bool TokenLocationLess(const TokenInfo& token, const char* offset) {
@@ -179,6 +205,7 @@ void TextStructureView::TrimSyntaxTree(int first_token_offset,
                                        int last_token_offset) {
   const absl::string_view text_range(Contents().substr(
       first_token_offset, last_token_offset - first_token_offset));
+  InvalidateSyntaxTreeIndex();
   verible::TrimSyntaxTree(&syntax_tree_, text_range);
 }
 
@@ -230,7 +257,7 @@ void TextStructureView::TrimContents(int left_offset, int length) {
 }
 
 void TextStructureView::SplitLines() {
-  lines_ = absl::StrSplit(contents_, '\n');
+  ScanLines(contents_, &lines_, &line_stats_);
 }
 
 void TextStructureView::RebaseTokensToSuperstring(absl::string_view superstring,
@@ -420,11 +447,16 @@ void TextStructureView::ConsumeDeferredExpansion(
   std::unique_ptr<TextStructure>& subanalysis = expansion->subanalysis;
   TextStructureView& sub_data = ABSL_DIE_IF_NULL(subanalysis)->MutableData();
   const absl::string_view sub_data_text(sub_data.Contents());
-  CHECK(!IsSubRange(sub_data_text, contents_));
   CHECK_EQ(sub_data_text, absl::string_view(offset, sub_data_text.length()));
   CHECK_GE(offset, contents_.begin());
-  sub_data.RebaseTokensToSuperstring(contents_, sub_data_text,
-                                     std::distance(contents_.begin(), offset));
+  if (IsSubRange(sub_data_text, contents_)) {
+    // Substring was analyzed in place, its tokens already point into
+    // contents_.
+    CHECK(sub_data_text.begin() == offset);
+  } else {
+    sub_data.RebaseTokensToSuperstring(
+        contents_, sub_data_text, std::distance(contents_.begin(), offset));
+  }
 
   // Translate token_view's iterators into array indices.
   if (!sub_data.tokens_.empty() && sub_data.tokens_.back().isEOF()) {
@@ -437,6 +469,10 @@ void TextStructureView::ConsumeDeferredExpansion(
 
   // Transfer ownership of transformed syntax tree to this object's tree.
   *expansion->expansion_point = std::move(sub_data.MutableSyntaxTree());
+  for (auto& arena : sub_data.syntax_tree_arenas_) {
+    AdoptSyntaxTreeArena(std::move(arena));
+  }
+  sub_data.syntax_tree_arenas_.clear();
   subanalysis->MutableData().Clear();
 
   // Advance one past expansion point to skip over expanded token.
@@ -445,7 +481,14 @@ void TextStructureView::ConsumeDeferredExpansion(
 }
 
 TextStructure::TextStructure(absl::string_view contents)
-    : owned_contents_(contents), data_(owned_contents_) {
+    : TextStructure(std::make_shared<StringMemBlock>(std::string(contents))) {}
+
+TextStructure::TextStructure(std::shared_ptr<MemBlock> contents)
+    : TextStructure(contents, contents->AsStringView()) {}
+
+TextStructure::TextStructure(std::shared_ptr<MemBlock> contents,
+                             absl::string_view substring)
+    : owned_contents_(std::move(contents)), data_(substring) {
   // Internal string_view must point to memory owned by owned_contents_.
   const util::Status status = InternalConsistencyCheck();
   CHECK(status.ok()) << status.message() << " (in ctor)";
@@ -457,6 +500,7 @@ TextStructure::~TextStructure() {
 }
 
 void TextStructureView::ExpandSubtrees(NodeExpansionMap* expansions) {
+  InvalidateSyntaxTreeIndex();
   TokenSequence combined_tokens;
   // Gather indices and reconstruct iterators after there are no more
   // reallocations due to growing combined_tokens.
@@ -491,10 +535,96 @@ void TextStructureView::ExpandSubtrees(NodeExpansionMap* expansions) {
   CalculateFirstTokensPerLine();
 }
 
+void TextStructureView::SpliceEditedSubtree(absl::string_view new_contents,
+                                            int left_offset, int right_offset,
+                                            DeferredExpansion* edit) {
+  InvalidateSyntaxTreeIndex();
+  const absl::string_view old_contents(contents_);
+  const int delta = static_cast<int>(new_contents.length()) -
+                    static_cast<int>(old_contents.length());
+  TextStructureView& sub_data =
+      ABSL_DIE_IF_NULL(edit->subanalysis)->MutableData();
+  CHECK(sub_data.Contents().begin() == new_contents.begin() + left_offset);
+  CHECK_EQ(static_cast<int>(sub_data.Contents().length()),
+           right_offset + delta - left_offset);
+
+  // Locate the replaced tokens, while they still point into old_contents.
+  const TokenRange replaced_tokens =
+      TokenRangeSpanningOffsets(left_offset, right_offset);
+  const auto replaced_view_begin = std::lower_bound(
+      tokens_view_.cbegin(), tokens_view_.cend(), replaced_tokens.begin());
+  const auto replaced_view_end = std::lower_bound(
+      replaced_view_begin, tokens_view_.cend(), replaced_tokens.end());
+
+  // Discard the replaced subtree, and shift everything else into
+  // new_contents.  Text after the edit moves by delta.
+  *edit->expansion_point = nullptr;
+  MutateTokens([=](TokenInfo* token) {
+    if (!IsSubRange(token->text, old_contents)) return;
+    const int offset = token->left(old_contents);
+    if (offset < left_offset) {
+      token->RebaseStringView(new_contents.begin() + offset);
+    } else if (offset >= right_offset) {
+      token->RebaseStringView(new_contents.begin() + offset + delta);
+    }
+  });
+
+  // Splice the subanalysis' tokens in place of the replaced tokens.
+  TokenSequence combined_tokens;
+  combined_tokens.reserve(tokens_.size() + sub_data.tokens_.size());
+  std::vector<int> combined_token_view_indices;
+  CopyTokensAndView(&combined_tokens, &combined_token_view_indices,
+                    make_range(tokens_.cbegin(), replaced_tokens.begin()),
+                    make_range(tokens_view_.cbegin(), replaced_view_begin));
+  if (!sub_data.tokens_.empty() && sub_data.tokens_.back().isEOF()) {
+    sub_data.tokens_.pop_back();
+  }
+  CopyTokensAndView(&combined_tokens, &combined_token_view_indices,
+                    sub_data.tokens_, sub_data.tokens_view_);
+  CopyTokensAndView(&combined_tokens, &combined_token_view_indices,
+                    make_range(replaced_tokens.end(), tokens_.cend()),
+                    make_range(replaced_view_end, tokens_view_.cend()));
+  tokens_.swap(combined_tokens);
+  tokens_view_.clear();
+  tokens_view_.reserve(combined_token_view_indices.size());
+  for (const auto index : combined_token_view_indices) {
+    tokens_view_.push_back(tokens_.cbegin() + index);
+  }
+
+  // Transfer ownership of the subanalysis' tree into this tree.
+  *edit->expansion_point = std::move(sub_data.MutableSyntaxTree());
+  for (auto& arena : sub_data.syntax_tree_arenas_) {
+    AdoptSyntaxTreeArena(std::move(arena));
+  }
+  sub_data.syntax_tree_arenas_.clear();
+  edit->subanalysis->MutableData().Clear();
+
+  contents_ = new_contents;
+  SplitLines();
+  RecalculateLineColumnMap();
+  CalculateFirstTokensPerLine();
+  const util::Status status = InternalConsistencyCheck();
+  CHECK(status.ok())
+      << "Failed internal iterator/string_view consistency check:\n  "
+      << status.message();
+}
+
+void TextStructure::SpliceEditedSubtree(
+    std::shared_ptr<MemBlock> new_contents, int left_offset, int right_offset,
+    TextStructureView::DeferredExpansion* edit) {
+  const absl::string_view owned_text = owned_contents_->AsStringView();
+  CHECK(data_.Contents().begin() == owned_text.begin());
+  CHECK_EQ(data_.Contents().length(), owned_text.length());
+  data_.SpliceEditedSubtree(new_contents->AsStringView(), left_offset,
+                            right_offset, edit);
+  // The old text is no longer referenced, and may be released.
+  owned_contents_ = std::move(new_contents);
+}
+
 util::Status TextStructure::StringViewConsistencyCheck() const {
   const absl::string_view contents = data_.Contents();
   if (!contents.empty() &&
-      !IsSubRange(contents, absl::string_view(owned_contents_))) {
+      !IsSubRange(contents, owned_contents_->AsStringView())) {
     return util::InternalError(
         "string_view contents_ is not a substring of owned_contents_, "
         "contents_ might reference deallocated memory!");
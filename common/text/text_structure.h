@@ -29,13 +29,18 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>  // IWYU pragma: keep
 #include <string>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "common/strings/line_scan.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/line_column_map.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_arena.h"
+#include "common/text/syntax_tree_index.h"
 #include "common/text/token_stream_view.h"
 #include "common/text/tree_utils.h"
 #include "common/util/status.h"
@@ -77,9 +82,26 @@ class TextStructureView {
 
   const std::vector<absl::string_view>& Lines() const { return lines_; }
 
+  // Tab and trailing whitespace positions of each of Lines().
+  const std::vector<LineStats>& GetLineStats() const { return line_stats_; }
+
   const ConcreteSyntaxTree& SyntaxTree() const { return syntax_tree_; }
 
-  ConcreteSyntaxTree& MutableSyntaxTree() { return syntax_tree_; }
+  // Mutable access discards the syntax tree index (see GetSyntaxTreeIndex()).
+  ConcreteSyntaxTree& MutableSyntaxTree() {
+    InvalidateSyntaxTreeIndex();
+    return syntax_tree_;
+  }
+
+  // Returns an index of all symbols in the syntax tree by tag, which is
+  // built on first use, and shared by all subsequent users.  Prefer this
+  // over searching the whole tree for a kind of node.  Safe to call
+  // concurrently, but not concurrently with modifying the tree.
+  const SyntaxTreeIndex& GetSyntaxTreeIndex() const;
+
+  // Keeps 'arena' alive for as long as the syntax tree may reference it.
+  // Call this when installing a tree that was built in an arena.
+  void AdoptSyntaxTreeArena(std::shared_ptr<SyntaxTreeArena> arena);
 
   const TokenSequence& TokenStream() const { return tokens_; }
 
@@ -95,9 +117,8 @@ class TextStructureView {
 
   const LineColumnMap& GetLineColumnMap() const { return line_column_map_; }
 
-  void RecalculateLineColumnMap() {
-    line_column_map_ = LineColumnMap(contents_);
-  }
+  // Uses Lines(), which must be up to date with contents_.
+  void RecalculateLineColumnMap() { line_column_map_ = LineColumnMap(lines_); }
 
   const std::vector<TokenSequence::const_iterator>& GetLineTokenMap() const {
     return line_token_map_;
@@ -150,6 +171,19 @@ class TextStructureView {
   // by this function.
   void ExpandSubtrees(NodeExpansionMap* expansions);
 
+  // Moves this view into 'new_contents' (separate memory), the text after an
+  // edit that was confined to the text of one subtree, spanning
+  // [left_offset, right_offset) of Contents(), and splices in the analysis of
+  // that subtree's edited text.  Tokens and leaves outside of the subtree
+  // are reused as they are, only shifted into 'new_contents'.
+  // 'edit.subanalysis' must view the edited text in place, i.e. the
+  // substring of 'new_contents' at 'left_offset' whose length differs from
+  // the subtree's original text like the lengths of the whole texts differ.
+  // Its syntax tree replaces the one at 'edit.expansion_point'.
+  // Like ExpandSubtrees(), this consumes the subanalysis.
+  void SpliceEditedSubtree(absl::string_view new_contents, int left_offset,
+                           int right_offset, DeferredExpansion* edit);
+
   // All of this class's consistency checks combined.
   util::Status InternalConsistencyCheck() const;
 
@@ -163,6 +197,9 @@ class TextStructureView {
   // Line-by-line view of contents_.
   std::vector<absl::string_view> lines_;
 
+  // Per-line byte classification of contents_, parallel to lines_.
+  std::vector<LineStats> line_stats_;
+
   // Tokens that constitute the original file (contents_).
   // This should always be terminated with a sentinel EOF token.
   TokenSequence tokens_;
@@ -176,9 +213,19 @@ class TextStructureView {
   // Index of token iterators that mark the beginnings of each line.
   std::vector<TokenSequence::const_iterator> line_token_map_;
 
+  // Arenas holding the memory of syntax_tree_ (and spliced-in subtrees).
+  // Declared before syntax_tree_ so that they are destroyed after it.
+  std::vector<std::shared_ptr<SyntaxTreeArena>> syntax_tree_arenas_;
+
   // Tree representation of file contents.
   ConcreteSyntaxTree syntax_tree_;
 
+  // Lazily built index of syntax_tree_, guarded by syntax_tree_index_mutex_.
+  mutable std::unique_ptr<SyntaxTreeIndex> syntax_tree_index_;
+  mutable std::mutex syntax_tree_index_mutex_;
+
+  void InvalidateSyntaxTreeIndex();
+
   void TrimSyntaxTree(int first_token_offset, int last_token_offset);
 
   void TrimTokensToSubstring(int left_offset, int right_offset);
@@ -211,8 +258,17 @@ class TextStructureView {
 // the same owned memory can be used for multiple analysis views.
 class TextStructure {
  public:
+  // Copies 'contents' into memory owned by this object.
   explicit TextStructure(absl::string_view contents);
 
+  // Shares ownership of 'contents' without copying, e.g. a memory-mapped file.
+  explicit TextStructure(std::shared_ptr<MemBlock> contents);
+
+  // Shares ownership of 'contents', but only views its 'substring', e.g. for
+  // analyzing an excerpt of an already analyzed text in place.
+  TextStructure(std::shared_ptr<MemBlock> contents,
+                absl::string_view substring);
+
   // DeferredExpansion::subanalysis requires this destructor to be virtual.
   virtual ~TextStructure();
 
@@ -222,6 +278,13 @@ class TextStructure {
 
   const ConcreteSyntaxTree& SyntaxTree() const { return data_.SyntaxTree(); }
 
+  // Takes (shared) ownership of 'new_contents', the edited text, and updates
+  // Data() with TextStructureView::SpliceEditedSubtree().
+  // Data() must view all of the currently owned text.
+  void SpliceEditedSubtree(std::shared_ptr<MemBlock> new_contents,
+                           int left_offset, int right_offset,
+                           TextStructureView::DeferredExpansion* edit);
+
   // Verify that string_views are inside memory owned by owned_contents_.
   util::Status StringViewConsistencyCheck() const;
 
@@ -229,11 +292,10 @@ class TextStructure {
   util::Status InternalConsistencyCheck() const;
 
  protected:
-  // This string owns the memory referenced by all substring string_views
-  // in this object.
-  // TODO(hzeller): avoid local copy and just require that the string-view
-  // we are called with outlives this object?
-  const std::string owned_contents_;
+  // This block owns the memory referenced by all substring string_views
+  // in this object.  It may be shared with other owners.
+  // Replaced only by SpliceEditedSubtree().
+  std::shared_ptr<MemBlock> owned_contents_;
 
   // The data_ object's string_views are owned by owned_contents_.
   TextStructureView data_;
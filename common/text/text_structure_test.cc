@@ -26,9 +26,11 @@
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/line_column_map.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_index.h"
 #include "common/text/text_structure_test_utils.h"
 #include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
@@ -46,6 +48,7 @@
 namespace verible {
 namespace {
 
+using ::testing::ElementsAre;
 using ::testing::IsEmpty;
 using ::testing::IsNull;
 using ::testing::SizeIs;
@@ -63,6 +66,28 @@ TEST(TextStructureViewCtorTest, InitializeContents) {
   }
 }
 
+// Test that contents passed as a string_view are copied.
+TEST(TextStructureCtorTest, CopiesStringContents) {
+  const std::string input("hello world");
+  TextStructure test_structure(input);
+  EXPECT_EQ(test_structure.Data().Contents(), input);
+  EXPECT_NE(test_structure.Data().Contents().data(), input.data());
+  EXPECT_OK(test_structure.InternalConsistencyCheck());
+}
+
+// Test that contents passed as a MemBlock are shared, not copied.
+TEST(TextStructureCtorTest, SharesMemBlockContents) {
+  auto block = std::make_shared<StringMemBlock>("foo\nbar\n");
+  const absl::string_view block_view = block->AsStringView();
+  TextStructure test_structure(block);
+  EXPECT_EQ(test_structure.Data().Contents().data(), block_view.data());
+  EXPECT_EQ(test_structure.Data().Contents(), "foo\nbar\n");
+  EXPECT_OK(test_structure.InternalConsistencyCheck());
+  // TextStructure keeps the memory alive.
+  block.reset();
+  EXPECT_EQ(test_structure.Data().Contents(), "foo\nbar\n");
+}
+
 // Test that filtering nothing works.
 TEST(FilterTokensTest, EmptyTokens) {
   TextStructureView test_view("blah");
@@ -402,6 +427,20 @@ TEST_F(TextStructureViewPublicTest, ExpandSubtreesEmpty) {
   EXPECT_TRUE(EqualTrees(syntax_tree_.get(), expect_tree.get()));
 }
 
+// Test that the syntax tree index is built once, and rebuilt after mutation.
+TEST_F(TextStructureViewPublicTest, SyntaxTreeIndexCachedAndInvalidated) {
+  const SyntaxTreeIndex& index = GetSyntaxTreeIndex();
+  EXPECT_EQ(index.size(), 4);
+  EXPECT_EQ(index.Count(LeafTag(3)), 2);
+  EXPECT_EQ(&GetSyntaxTreeIndex(), &index);
+
+  MutableSyntaxTree() = TNode(5, Leaf(tokens_[0]));
+  const SyntaxTreeIndex& new_index = GetSyntaxTreeIndex();
+  EXPECT_EQ(new_index.size(), 2);
+  EXPECT_EQ(new_index.Count(NodeTag(5)), 1);
+  EXPECT_EQ(new_index.Count(LeafTag(3)), 1);
+}
+
 // Splits a single token into a syntax tree node with two leaves.
 void FakeParseToken(TextStructureView* data, int offset, int node_tag) {
   TokenSequence& tokens = data->MutableTokenStream();
@@ -492,6 +531,115 @@ TEST_F(TextStructureViewPublicTest, ExpandSubtreesMultipleLeaves) {
   EXPECT_TRUE(EqualTrees(syntax_tree_.get(), expect_tree.get()));
 }
 
+// Returns a TextStructure of "hello, world" with tokens
+// "hello" "," " " "world", and a tree of the non-space tokens.
+static std::unique_ptr<TextStructure> MakeHelloWorldStructure() {
+  auto text_structure = absl::make_unique<TextStructure>("hello, world");
+  TextStructureView& data = text_structure->MutableData();
+  const absl::string_view text = data.Contents();
+  TokenSequence& tokens = data.MutableTokenStream();
+  tokens.push_back(TokenInfo(3, text.substr(0, 5)));  // "hello"
+  tokens.push_back(TokenInfo(1, text.substr(5, 1)));  // ","
+  tokens.push_back(TokenInfo(2, text.substr(6, 1)));  // " "
+  tokens.push_back(TokenInfo(3, text.substr(7, 5)));  // "world"
+  tokens.push_back(TokenInfo(TK_EOF, text.substr(12, 0)));
+  TokenStreamView& tokens_view = data.MutableTokenStreamView();
+  tokens_view.push_back(tokens.begin());
+  tokens_view.push_back(tokens.begin() + 1);
+  tokens_view.push_back(tokens.begin() + 3);
+  data.MutableSyntaxTree() =
+      Node(Leaf(tokens[0]), Leaf(tokens[1]), Leaf(tokens[3]));
+  data.CalculateFirstTokensPerLine();
+  return text_structure;
+}
+
+// Returns the texts of the tokens in the view.
+static std::vector<absl::string_view> TokenViewTexts(
+    const TextStructureView& data) {
+  std::vector<absl::string_view> texts;
+  for (const auto& token : data.GetTokenStreamView()) {
+    texts.push_back(token->text);
+  }
+  return texts;
+}
+
+// Test that an edit of the last leaf splices in its re-analysis.
+TEST(SpliceEditedSubtreeTest, LastLeaf) {
+  auto text_structure = MakeHelloWorldStructure();
+  // Edit "world" into "planet!".
+  const auto new_contents =
+      std::make_shared<StringMemBlock>(std::string("hello, planet!"));
+  const absl::string_view new_text = new_contents->AsStringView();
+  auto subanalysis =
+      absl::make_unique<TextStructure>(new_contents, new_text.substr(7));
+  FakeParseToken(&subanalysis->MutableData(), 3, 7);
+  auto& replacement_node =
+      down_cast<SyntaxTreeNode*>(
+          text_structure->MutableData().MutableSyntaxTree().get())
+          ->mutable_children()
+          .back();
+  TextStructureView::DeferredExpansion edit{&replacement_node,
+                                            std::move(subanalysis)};
+  text_structure->SpliceEditedSubtree(new_contents, 7, 12, &edit);
+
+  const TextStructureView& data = text_structure->Data();
+  EXPECT_EQ(data.Contents().begin(), new_text.begin());
+  const auto expect_tree = Node(              // noformat
+      Leaf(3, new_text.substr(0, 5)),         // noformat
+      Leaf(1, new_text.substr(5, 1)),         // noformat
+      TNode(7,                                // noformat
+            Leaf(11, new_text.substr(7, 3)),  // noformat
+            Leaf(12, new_text.substr(10))     // noformat
+            ));
+  EXPECT_TRUE(EqualTrees(data.SyntaxTree().get(), expect_tree.get()));
+  const TokenSequence& tokens = data.TokenStream();
+  ASSERT_EQ(tokens.size(), 6);
+  for (const auto& token : tokens) {
+    EXPECT_TRUE(IsSubRange(token.text, new_text)) << token;
+  }
+  EXPECT_TRUE(tokens.back().isEOF());
+  EXPECT_EQ(tokens.back().left(new_text), new_text.length());
+  EXPECT_THAT(TokenViewTexts(data),
+              ElementsAre("hello", ",", "pla", "net!"));
+}
+
+// Test that an edit of the first leaf shifts the tokens after it.
+TEST(SpliceEditedSubtreeTest, FirstLeafShiftsFollowingTokens) {
+  auto text_structure = MakeHelloWorldStructure();
+  // Edit "hello" into "hi".
+  const auto new_contents =
+      std::make_shared<StringMemBlock>(std::string("hi, world"));
+  const absl::string_view new_text = new_contents->AsStringView();
+  auto subanalysis =
+      absl::make_unique<TextStructure>(new_contents, new_text.substr(0, 2));
+  FakeParseToken(&subanalysis->MutableData(), 1, 7);
+  auto& replacement_node =
+      down_cast<SyntaxTreeNode*>(
+          text_structure->MutableData().MutableSyntaxTree().get())
+          ->mutable_children()
+          .front();
+  TextStructureView::DeferredExpansion edit{&replacement_node,
+                                            std::move(subanalysis)};
+  text_structure->SpliceEditedSubtree(new_contents, 0, 5, &edit);
+
+  const TextStructureView& data = text_structure->Data();
+  const auto expect_tree = Node(              // noformat
+      TNode(7,                                // noformat
+            Leaf(11, new_text.substr(0, 1)),  // noformat
+            Leaf(12, new_text.substr(1, 1))   // noformat
+            ),                                // noformat
+      Leaf(1, new_text.substr(2, 1)),         // noformat
+      Leaf(3, new_text.substr(4, 5)));
+  EXPECT_TRUE(EqualTrees(data.SyntaxTree().get(), expect_tree.get()));
+  // The reused leaves point into the new text.
+  const SyntaxTreeLeaf* last_leaf = GetRightmostLeaf(*data.SyntaxTree());
+  ASSERT_NE(last_leaf, nullptr);
+  EXPECT_EQ(last_leaf->get().text.begin(), new_text.begin() + 4);
+  EXPECT_THAT(TokenViewTexts(data), ElementsAre("h", "i", ",", "world"));
+  EXPECT_EQ(data.Lines().size(), 1);
+  EXPECT_EQ(data.Lines().front(), new_text);
+}
+
 // The following tests intentionally cause internal violations to
 // make sure the consistency checks work as intended.
 // The mutated fields are restored so that the consistency checks
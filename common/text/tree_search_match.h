@@ -0,0 +1,33 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_TEXT_TREE_SEARCH_MATCH_H_
+#define VERIBLE_COMMON_TEXT_TREE_SEARCH_MATCH_H_
+
+#include "common/text/symbol.h"
+#include "common/text/syntax_tree_context.h"
+
+namespace verible {
+
+// General match structure for searching a syntax tree.
+struct TreeSearchMatch {
+  // Note: The syntax tree to which the matching node belongs must outlive
+  // this pointer.
+  const Symbol* match;
+  SyntaxTreeContext context;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_TEXT_TREE_SEARCH_MATCH_H_
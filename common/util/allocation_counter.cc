@@ -0,0 +1,51 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/allocation_counter.h"
+
+#include <atomic>
+#include <cstddef>
+
+namespace verible {
+
+// Plain (constant-initialized) thread-locals, safe to use from operator new
+// at any point in a thread's life.
+static thread_local int64_t thread_allocations = 0;
+static thread_local int64_t thread_allocated_bytes = 0;
+
+static std::atomic<bool> counting_enabled(false);
+
+AllocationCount ThreadAllocationCount() {
+  AllocationCount count;
+  count.allocations = thread_allocations;
+  count.bytes = thread_allocated_bytes;
+  return count;
+}
+
+bool AllocationCountingEnabled() { return counting_enabled.load(); }
+
+namespace internal {
+
+void CountAllocation(size_t bytes) {
+  ++thread_allocations;
+  thread_allocated_bytes += bytes;
+}
+
+bool EnableAllocationCounting() {
+  counting_enabled.store(true);
+  return true;
+}
+
+}  // namespace internal
+}  // namespace verible
@@ -0,0 +1,52 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-thread counting of heap allocations, for instrumentation.
+//
+// Counting only happens in binaries that link in the replacement global
+// operator new from the ":allocation_counting" library.  Without it, counts
+// stay at zero and AllocationCountingEnabled() returns false.
+
+#ifndef VERIBLE_COMMON_UTIL_ALLOCATION_COUNTER_H_
+#define VERIBLE_COMMON_UTIL_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace verible {
+
+struct AllocationCount {
+  // Number of calls to (non-aligned) global operator new.
+  int64_t allocations = 0;
+  // Total bytes requested by those calls.
+  int64_t bytes = 0;
+};
+
+// Returns the allocations made so far by the calling thread.
+AllocationCount ThreadAllocationCount();
+
+// Returns true if allocations are being counted in this binary.
+bool AllocationCountingEnabled();
+
+namespace internal {
+// Called by the replacement operator new for each allocation.
+void CountAllocation(size_t bytes);
+
+// Called once by the replacement operator new's library, at startup.
+bool EnableAllocationCounting();
+}  // namespace internal
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_ALLOCATION_COUNTER_H_
@@ -0,0 +1,62 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replacement global operator new/delete that count allocations per thread.
+// Link this into a binary (it is 'alwayslink') to enable counting; see
+// allocation_counter.h.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "common/util/allocation_counter.h"
+
+static const bool kAllocationCountingEnabled =
+    verible::internal::EnableAllocationCounting();
+
+static void* CountedAllocate(size_t bytes) {
+  verible::internal::CountAllocation(bytes);
+  // malloc(0) may return null, which operator new must not.
+  void* p = std::malloc(bytes == 0 ? 1 : bytes);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new(size_t bytes) { return CountedAllocate(bytes); }
+
+void* operator new[](size_t bytes) { return CountedAllocate(bytes); }
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept {
+  verible::internal::CountAllocation(bytes);
+  return std::malloc(bytes == 0 ? 1 : bytes);
+}
+
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept {
+  verible::internal::CountAllocation(bytes);
+  return std::malloc(bytes == 0 ? 1 : bytes);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
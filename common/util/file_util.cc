@@ -14,18 +14,28 @@
 
 #include "common/util/file_util.h"
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <streambuf>
 #include <string>
+#include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "common/strings/mem_block.h"
 #include "common/util/logging.h"
 
 namespace verible {
@@ -54,6 +64,50 @@ bool GetContents(absl::string_view filename, std::string *content) {
   return true;
 }
 
+namespace {
+// Read-only memory-mapping of a whole file.
+class MmapMemBlock final : public MemBlock {
+ public:
+  MmapMemBlock(const char *data, size_t size) : data_(data), size_(size) {}
+
+  ~MmapMemBlock() override {
+    munmap(const_cast<char *>(data_), size_);
+  }
+
+  absl::string_view AsStringView() const override {
+    return absl::string_view(data_, size_);
+  }
+
+ private:
+  const char *const data_;
+  const size_t size_;
+};
+}  // namespace
+
+std::unique_ptr<MemBlock> GetContentAsMemBlock(absl::string_view filename) {
+  const std::string path(filename);
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return nullptr;
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) &&
+      file_stat.st_size > 0) {
+    void *const buffer =
+        mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (buffer == MAP_FAILED) return nullptr;
+    // Content is scanned front-to-back by the lexer.
+    madvise(buffer, file_stat.st_size, MADV_SEQUENTIAL);
+    return absl::make_unique<MmapMemBlock>(static_cast<const char *>(buffer),
+                                           file_stat.st_size);
+  }
+  close(fd);
+  // Empty, special or otherwise non-mappable files are read the usual way.
+  auto result = absl::make_unique<StringMemBlock>();
+  if (!GetContents(filename, result->mutable_content())) return nullptr;
+  return result;
+}
+
 bool SetContents(absl::string_view filename, absl::string_view content) {
   std::ofstream f(std::string(filename).c_str());
   if (!f.good()) return false;
@@ -61,6 +115,82 @@ bool SetContents(absl::string_view filename, absl::string_view content) {
   return true;
 }
 
+bool SetContentsAtomically(absl::string_view filename,
+                           absl::string_view content) {
+  // Write through symbolic links: replace their target, not the link.
+  std::string path(filename);
+  char *const real_path = realpath(path.c_str(), nullptr);
+  if (real_path != nullptr) {
+    path = real_path;
+    free(real_path);
+  } else {
+    // A new file is fine, a dangling link or unreadable directory is not.
+    struct stat link_stat;
+    if (errno != ENOENT || lstat(path.c_str(), &link_stat) == 0) return false;
+  }
+  // A unique temporary file next to the destination, so that rename()
+  // stays within one file system.
+  std::string temp_path = absl::StrCat(path, ".tmp-XXXXXX");
+  const int fd = mkstemp(&temp_path[0]);
+  if (fd < 0) return false;
+  bool success = true;
+  const char *data = content.data();
+  size_t remaining = content.size();
+  while (success && remaining > 0) {
+    const ssize_t written = write(fd, data, remaining);
+    if (written < 0) {
+      success = (errno == EINTR);
+      continue;
+    }
+    data += written;
+    remaining -= written;
+  }
+  // mkstemp() creates files that are only accessible by the owner.
+  struct stat file_stat;
+  const mode_t mode =
+      stat(path.c_str(), &file_stat) == 0 ? (file_stat.st_mode & 07777) : 0644;
+  success = success && fchmod(fd, mode) == 0;
+  success = (close(fd) == 0) && success;
+  success = success && rename(temp_path.c_str(), path.c_str()) == 0;
+  if (!success) unlink(temp_path.c_str());
+  return success;
+}
+
+bool IsDirectory(absl::string_view path) {
+  struct stat file_stat;
+  return stat(std::string(path).c_str(), &file_stat) == 0 &&
+         S_ISDIR(file_stat.st_mode);
+}
+
+bool ListFilesRecursively(absl::string_view dir,
+                          std::vector<std::string> *files) {
+  const std::string dir_path(dir);
+  DIR *const d = opendir(dir_path.c_str());
+  if (d == nullptr) return false;
+  std::vector<std::string> names;
+  while (const struct dirent *e = readdir(d)) {
+    const absl::string_view name(e->d_name);
+    if (name == "." || name == "..") continue;
+    names.emplace_back(name);
+  }
+  closedir(d);
+  std::sort(names.begin(), names.end());
+
+  bool success = true;
+  for (const auto &name : names) {
+    std::string path = JoinPath(dir, name);
+    struct stat entry_stat;
+    // An entry may have been removed in the meantime.
+    if (lstat(path.c_str(), &entry_stat) != 0) continue;
+    if (S_ISDIR(entry_stat.st_mode)) {
+      success = ListFilesRecursively(path, files) && success;
+    } else if (S_ISREG(entry_stat.st_mode)) {
+      files->push_back(std::move(path));
+    }
+  }
+  return success;
+}
+
 std::string JoinPath(absl::string_view base, absl::string_view name) {
   return absl::StrCat(base, "/", name);
 }
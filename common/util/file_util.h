@@ -17,9 +17,12 @@
 #ifndef VERIBLE_COMMON_UTIL_FILE_UTIL_H_
 #define VERIBLE_COMMON_UTIL_FILE_UTIL_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "common/strings/mem_block.h"
 
 namespace verible {
 namespace file {
@@ -38,10 +41,35 @@ absl::string_view Stem(absl::string_view filename);
 // TODO(hzeller): consider util::Status return?
 bool GetContents(absl::string_view filename, std::string *content);
 
+// Returns the content of file "filename", or nullptr if it cannot be read.
+// Regular files are memory-mapped read-only, which avoids copying the content;
+// other files (e.g. pipes) are read into a string.
+// Note: a mapped file must not be truncated while the block is still in use.
+std::unique_ptr<MemBlock> GetContentAsMemBlock(absl::string_view filename);
+
 // Create file "filename" and store given content in it.
 // TODO(hzeller): consider util::Status return ?
 bool SetContents(absl::string_view filename, absl::string_view content);
 
+// Like SetContents(), but writes to a temporary file in the same directory,
+// and then renames it to "filename".  Readers never see partial content, and
+// memory-mapped blocks of the previous content remain valid.
+// The permissions of an existing file are preserved.  If "filename" is a
+// symbolic link, the file it points to is replaced, and the link is kept.
+// Other hard links to the file keep the previous content.
+bool SetContentsAtomically(absl::string_view filename,
+                           absl::string_view content);
+
+// Returns true if "path" is a directory (or a symbolic link to one).
+bool IsDirectory(absl::string_view path);
+
+// Appends the paths of all regular files below directory "dir" to "files",
+// recursively, visiting entries of each directory in sorted order.
+// Symbolic links inside of "dir" are not followed.
+// Returns false if any directory could not be read.
+bool ListFilesRecursively(absl::string_view dir,
+                          std::vector<std::string> *files);
+
 // Join directory + filename
 std::string JoinPath(absl::string_view base, absl::string_view name);
 
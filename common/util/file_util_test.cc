@@ -14,8 +14,13 @@
 
 #include "common/util/file_util.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <string>
+#include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 namespace verible {
@@ -57,6 +62,110 @@ TEST(FileUtil, ScopedTestFile) {
   EXPECT_TRUE(file::GetContents(test_file.filename(), &read_back_content));
   EXPECT_EQ(test_content, read_back_content);
 }
+
+TEST(FileUtil, GetContentAsMemBlock) {
+  const std::string test_content = "Hello World!";
+  file::testing::ScopedTestFile test_file(testing::TempDir(), test_content);
+  const auto block = file::GetContentAsMemBlock(test_file.filename());
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(block->AsStringView(), test_content);
+}
+
+TEST(FileUtil, GetContentAsMemBlockEmptyFile) {
+  file::testing::ScopedTestFile test_file(testing::TempDir(), "");
+  const auto block = file::GetContentAsMemBlock(test_file.filename());
+  ASSERT_NE(block, nullptr);
+  EXPECT_TRUE(block->AsStringView().empty());
+}
+
+TEST(FileUtil, GetContentAsMemBlockNonexistentFile) {
+  EXPECT_EQ(file::GetContentAsMemBlock(
+                file::JoinPath(testing::TempDir(), "no-such-file")),
+            nullptr);
+}
+
+TEST(FileUtil, SetContentsAtomically) {
+  const std::string test_file =
+      file::JoinPath(testing::TempDir(), "atomic_file");
+  EXPECT_TRUE(file::SetContents(test_file, "old content"));
+  ASSERT_EQ(chmod(test_file.c_str(), 0640), 0);
+  // A mapping of the old content stays valid after the file is replaced.
+  const auto old_block = file::GetContentAsMemBlock(test_file);
+  ASSERT_NE(old_block, nullptr);
+
+  EXPECT_TRUE(file::SetContentsAtomically(test_file, "new content"));
+  std::string read_back_content;
+  EXPECT_TRUE(file::GetContents(test_file, &read_back_content));
+  EXPECT_EQ(read_back_content, "new content");
+  EXPECT_EQ(old_block->AsStringView(), "old content");
+
+  struct stat file_stat;
+  ASSERT_EQ(stat(test_file.c_str(), &file_stat), 0);
+  EXPECT_EQ(file_stat.st_mode & 0777, 0640);
+}
+
+// Rewriting a file through a symbolic link keeps the link.
+TEST(FileUtil, SetContentsAtomicallyThroughSymlink) {
+  const std::string target_dir =
+      file::JoinPath(testing::TempDir(), "atomic_link_target");
+  ASSERT_TRUE(file::CreateDir(target_dir));
+  const std::string target = file::JoinPath(target_dir, "file");
+  const std::string link = file::JoinPath(testing::TempDir(), "atomic_link");
+  EXPECT_TRUE(file::SetContents(target, "old content"));
+  unlink(link.c_str());  // Left over from an earlier run.
+  ASSERT_EQ(symlink(target.c_str(), link.c_str()), 0);
+
+  EXPECT_TRUE(file::SetContentsAtomically(link, "new content"));
+  struct stat link_stat;
+  ASSERT_EQ(lstat(link.c_str(), &link_stat), 0);
+  EXPECT_TRUE(S_ISLNK(link_stat.st_mode));
+  std::string read_back_content;
+  EXPECT_TRUE(file::GetContents(target, &read_back_content));
+  EXPECT_EQ(read_back_content, "new content");
+}
+
+// A dangling link is not replaced by a regular file.
+TEST(FileUtil, SetContentsAtomicallyDanglingSymlink) {
+  const std::string link =
+      file::JoinPath(testing::TempDir(), "atomic_dangling_link");
+  unlink(link.c_str());
+  ASSERT_EQ(symlink("no-such-target", link.c_str()), 0);
+  EXPECT_FALSE(file::SetContentsAtomically(link, "content"));
+  struct stat link_stat;
+  ASSERT_EQ(lstat(link.c_str(), &link_stat), 0);
+  EXPECT_TRUE(S_ISLNK(link_stat.st_mode));
+}
+
+TEST(FileUtil, SetContentsAtomicallyMissingDirectory) {
+  EXPECT_FALSE(file::SetContentsAtomically(
+      file::JoinPath(testing::TempDir(), "no-such-dir/file"), "content"));
+}
+
+TEST(FileUtil, ListFilesRecursively) {
+  const std::string root = file::JoinPath(testing::TempDir(), "list_root");
+  const std::string sub = file::JoinPath(root, "sub");
+  ASSERT_TRUE(file::CreateDir(root));
+  ASSERT_TRUE(file::CreateDir(sub));
+  ASSERT_TRUE(file::SetContents(file::JoinPath(root, "b.sv"), ""));
+  ASSERT_TRUE(file::SetContents(file::JoinPath(root, "a.v"), ""));
+  ASSERT_TRUE(file::SetContents(file::JoinPath(sub, "c.svh"), ""));
+
+  EXPECT_TRUE(file::IsDirectory(root));
+  EXPECT_FALSE(file::IsDirectory(file::JoinPath(root, "a.v")));
+
+  std::vector<std::string> files;
+  EXPECT_TRUE(file::ListFilesRecursively(root, &files));
+  EXPECT_THAT(files, ::testing::ElementsAre(file::JoinPath(root, "a.v"),
+                                            file::JoinPath(root, "b.sv"),
+                                            file::JoinPath(sub, "c.svh")));
+}
+
+TEST(FileUtil, ListFilesRecursivelyNonexistentDir) {
+  std::vector<std::string> files;
+  EXPECT_FALSE(file::ListFilesRecursively(
+      file::JoinPath(testing::TempDir(), "no-such-dir"), &files));
+  EXPECT_TRUE(files.empty());
+}
 }  // namespace
 }  // namespace util
 }  // namespace verible
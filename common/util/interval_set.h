@@ -0,0 +1,91 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_UTIL_INTERVAL_SET_H_
+#define VERIBLE_COMMON_UTIL_INTERVAL_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+
+namespace verible {
+
+// IntervalSet is a set of values represented as disjoint, non-adjacent,
+// half-open intervals [begin, end), e.g. sets of line numbers.
+// Memory is O(number of intervals), regardless of their lengths, and
+// membership queries take O(log(number of intervals)).
+template <typename T>
+class IntervalSet {
+  // Key: begin of interval, value: end of interval.
+  using impl_type = std::map<T, T>;
+
+ public:
+  using const_iterator = typename impl_type::const_iterator;
+
+  IntervalSet() = default;
+
+  // Adds values [begin, end) to the set, merging with any overlapping or
+  // abutting intervals.
+  void Add(T begin, T end) {
+    if (!(begin < end)) return;
+    auto iter = intervals_.upper_bound(begin);
+    if (iter != intervals_.begin()) {
+      const auto prev = std::prev(iter);
+      if (!(prev->second < begin)) {
+        begin = prev->first;
+        end = std::max(end, prev->second);
+        iter = intervals_.erase(prev);
+      }
+    }
+    while (iter != intervals_.end() && !(end < iter->first)) {
+      end = std::max(end, iter->second);
+      iter = intervals_.erase(iter);
+    }
+    intervals_.emplace_hint(iter, begin, end);
+  }
+
+  // Adds a single value.
+  void Add(T value) { Add(value, value + 1); }
+
+  // Returns true if value is in one of the intervals.
+  bool Contains(T value) const {
+    auto iter = intervals_.upper_bound(value);
+    if (iter == intervals_.begin()) return false;
+    --iter;
+    return value < iter->second;
+  }
+
+  bool empty() const { return intervals_.empty(); }
+
+  void clear() { intervals_.clear(); }
+
+  // Number of disjoint intervals (not values).
+  size_t size() const { return intervals_.size(); }
+
+  // Iterates over intervals as (begin, end) pairs, in increasing order.
+  const_iterator begin() const { return intervals_.begin(); }
+  const_iterator end() const { return intervals_.end(); }
+
+  bool operator==(const IntervalSet& r) const {
+    return intervals_ == r.intervals_;
+  }
+
+ private:
+  impl_type intervals_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_INTERVAL_SET_H_
@@ -0,0 +1,97 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/interval_set.h"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace verible {
+namespace {
+
+using Intervals = std::vector<std::pair<int, int>>;
+
+Intervals ToVector(const IntervalSet<int>& set) {
+  return Intervals(set.begin(), set.end());
+}
+
+TEST(IntervalSetTest, Empty) {
+  IntervalSet<int> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.Contains(0));
+  set.Add(3, 3);  // empty interval
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(IntervalSetTest, SingleInterval) {
+  IntervalSet<int> set;
+  set.Add(5, 9);
+  EXPECT_FALSE(set.Contains(4));
+  EXPECT_TRUE(set.Contains(5));
+  EXPECT_TRUE(set.Contains(8));
+  EXPECT_FALSE(set.Contains(9));
+  EXPECT_EQ(ToVector(set), (Intervals{{5, 9}}));
+}
+
+TEST(IntervalSetTest, DisjointIntervals) {
+  IntervalSet<int> set;
+  set.Add(9, 11);
+  set.Add(5, 7);
+  EXPECT_EQ(ToVector(set), (Intervals{{5, 7}, {9, 11}}));
+  EXPECT_FALSE(set.Contains(7));
+  EXPECT_FALSE(set.Contains(8));
+  EXPECT_TRUE(set.Contains(9));
+}
+
+TEST(IntervalSetTest, MergeOverlapping) {
+  IntervalSet<int> set;
+  set.Add(5, 9);
+  set.Add(7, 11);
+  EXPECT_EQ(ToVector(set), (Intervals{{5, 11}}));
+  set.Add(1, 6);
+  EXPECT_EQ(ToVector(set), (Intervals{{1, 11}}));
+  set.Add(2, 3);  // subsumed
+  EXPECT_EQ(ToVector(set), (Intervals{{1, 11}}));
+}
+
+TEST(IntervalSetTest, MergeAbutting) {
+  IntervalSet<int> set;
+  set.Add(3);
+  set.Add(5);
+  EXPECT_EQ(ToVector(set), (Intervals{{3, 4}, {5, 6}}));
+  set.Add(4);
+  EXPECT_EQ(ToVector(set), (Intervals{{3, 6}}));
+  set.Add(6, 8);
+  EXPECT_EQ(ToVector(set), (Intervals{{3, 8}}));
+}
+
+TEST(IntervalSetTest, MergeMany) {
+  IntervalSet<int> set;
+  for (int i = 0; i < 20; i += 4) set.Add(i, i + 2);
+  EXPECT_EQ(set.size(), 5);
+  set.Add(1, 15);
+  EXPECT_EQ(ToVector(set), (Intervals{{0, 15}, {16, 18}}));
+}
+
+TEST(IntervalSetTest, LargeRangeIsOneInterval) {
+  IntervalSet<int> set;
+  set.Add(0, 1000000000);
+  EXPECT_EQ(set.size(), 1);
+  EXPECT_TRUE(set.Contains(999999999));
+}
+
+}  // namespace
+}  // namespace verible
@@ -0,0 +1,186 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/phase_stats.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/util/allocation_counter.h"
+#include "common/util/enum_flags.h"
+
+namespace verible {
+
+PhaseStats::ScopedPhase::ScopedPhase(PhaseStats* stats, absl::string_view name)
+    : stats_(stats),
+      name_(name),
+      start_time_(std::chrono::steady_clock::now()),
+      start_allocations_(ThreadAllocationCount()) {}
+
+PhaseStats::ScopedPhase::~ScopedPhase() {
+  const auto end_time = std::chrono::steady_clock::now();
+  const AllocationCount end_allocations = ThreadAllocationCount();
+  PhaseStat phase;
+  phase.name = name_;
+  phase.wall_time = end_time - start_time_;
+  phase.allocations =
+      end_allocations.allocations - start_allocations_.allocations;
+  phase.allocated_bytes = end_allocations.bytes - start_allocations_.bytes;
+  stats_->Record(std::move(phase));
+}
+
+void PhaseStats::Append(const PhaseStats& other, absl::string_view prefix) {
+  for (const auto& phase : other.Phases()) {
+    PhaseStat copy(phase);
+    copy.name = absl::StrCat(prefix, phase.name);
+    Record(std::move(copy));
+  }
+}
+
+static const std::initializer_list<
+    std::pair<const absl::string_view, StatsFormat>>
+    kStatsFormatStringMap = {
+        {"none", StatsFormat::kNone},
+        {"text", StatsFormat::kText},
+        {"json", StatsFormat::kJson},
+};
+
+std::ostream& operator<<(std::ostream& stream, StatsFormat format) {
+  static const auto* flag_map = MakeEnumToStringMap(kStatsFormatStringMap);
+  return stream << flag_map->find(format)->second;
+}
+
+bool AbslParseFlag(absl::string_view text, StatsFormat* format,
+                   std::string* error) {
+  static const auto* flag_map = MakeStringToEnumMap(kStatsFormatStringMap);
+  return EnumMapParseFlag(*flag_map, text, format, error);
+}
+
+std::string AbslUnparseFlag(const StatsFormat& format) {
+  std::ostringstream stream;
+  stream << format;
+  return stream.str();
+}
+
+static int64_t Microseconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+// Prints 'text' as a JSON string literal.
+static void PrintJsonString(std::ostream& stream, absl::string_view text) {
+  stream << '"';
+  for (const char c : text) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          stream << escaped;
+        } else {
+          stream << c;
+        }
+    }
+  }
+  stream << '"';
+}
+
+static void PrintText(std::ostream& stream, absl::string_view subject,
+                      const PhaseStats& stats) {
+  stream << "Phase statistics for " << subject << ":\n";
+  size_t name_width = 5;  // "phase"
+  for (const auto& phase : stats.Phases()) {
+    name_width = std::max(name_width, phase.name.length());
+  }
+  const bool show_allocations = AllocationCountingEnabled();
+  stream << "  " << std::left << std::setw(name_width) << "phase" << std::right
+         << std::setw(12) << "time(us)";
+  if (show_allocations) {
+    stream << std::setw(12) << "allocs" << std::setw(14) << "bytes";
+  }
+  stream << '\n';
+  for (const auto& phase : stats.Phases()) {
+    stream << "  " << std::left << std::setw(name_width) << phase.name
+           << std::right << std::setw(12) << Microseconds(phase.wall_time);
+    if (show_allocations) {
+      stream << std::setw(12) << phase.allocations << std::setw(14)
+             << phase.allocated_bytes;
+    }
+    stream << '\n';
+  }
+}
+
+static void PrintJson(std::ostream& stream, absl::string_view subject,
+                      const PhaseStats& stats) {
+  const bool show_allocations = AllocationCountingEnabled();
+  stream << "{\"subject\": ";
+  PrintJsonString(stream, subject);
+  stream << ", \"phases\": [";
+  const char* separator = "";
+  for (const auto& phase : stats.Phases()) {
+    stream << separator << "{\"name\": ";
+    PrintJsonString(stream, phase.name);
+    stream << ", \"wall_time_us\": " << Microseconds(phase.wall_time);
+    if (show_allocations) {
+      stream << ", \"allocations\": " << phase.allocations
+             << ", \"allocated_bytes\": " << phase.allocated_bytes;
+    }
+    stream << '}';
+    separator = ", ";
+  }
+  stream << "]}\n";
+}
+
+void PrintPhaseStats(std::ostream& stream, absl::string_view subject,
+                     const PhaseStats& stats, StatsFormat format) {
+  // Format completely before printing, so that stats of concurrently
+  // processed subjects do not interleave.
+  std::ostringstream buffer;
+  switch (format) {
+    case StatsFormat::kNone:
+      return;
+    case StatsFormat::kText:
+      PrintText(buffer, subject, stats);
+      break;
+    case StatsFormat::kJson:
+      PrintJson(buffer, subject, stats);
+      break;
+  }
+  stream << buffer.str() << std::flush;
+}
+
+}  // namespace verible
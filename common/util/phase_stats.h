@@ -0,0 +1,105 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// PhaseStats records the wall time and heap allocations of named phases of
+// work (e.g. lexing, parsing), for finding out where time is spent.
+
+#ifndef VERIBLE_COMMON_UTIL_PHASE_STATS_H_
+#define VERIBLE_COMMON_UTIL_PHASE_STATS_H_
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/util/allocation_counter.h"
+
+namespace verible {
+
+// Measurements of one phase.
+struct PhaseStat {
+  std::string name;
+
+  std::chrono::nanoseconds wall_time{0};
+
+  // Heap allocations made by the measuring thread during the phase.
+  // These are zero unless AllocationCountingEnabled().
+  int64_t allocations = 0;
+  int64_t allocated_bytes = 0;
+};
+
+class PhaseStats {
+ public:
+  // Measures the phase from construction to destruction, and then records it
+  // into the PhaseStats that created it.
+  class ScopedPhase {
+   public:
+    ScopedPhase(PhaseStats* stats, absl::string_view name);
+    ~ScopedPhase();
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+   private:
+    PhaseStats* const stats_;
+    const std::string name_;
+    const std::chrono::steady_clock::time_point start_time_;
+    const AllocationCount start_allocations_;
+  };
+
+  // Usage:
+  //   {
+  //     const auto phase = stats.Measure("parse");
+  //     ... work ...
+  //   }  // recorded here
+  // Phases are listed in the order in which they end, so nested phases
+  // precede the phases that contain them.
+  ScopedPhase Measure(absl::string_view name) { return {this, name}; }
+
+  void Record(PhaseStat phase) { phases_.push_back(std::move(phase)); }
+
+  // Appends all of 'other's phases, with 'prefix' prepended to their names.
+  void Append(const PhaseStats& other, absl::string_view prefix);
+
+  const std::vector<PhaseStat>& Phases() const { return phases_; }
+
+ private:
+  std::vector<PhaseStat> phases_;
+};
+
+// Selects how PrintPhaseStats() formats its output.
+enum class StatsFormat {
+  kNone,  // print nothing
+  kText,  // human-readable table
+  kJson,  // one JSON object per line
+};
+
+std::ostream& operator<<(std::ostream&, StatsFormat);
+
+// For use as a flag value: "none", "text", "json".
+bool AbslParseFlag(absl::string_view text, StatsFormat* format,
+                   std::string* error);
+
+std::string AbslUnparseFlag(const StatsFormat& format);
+
+// Prints 'stats' about 'subject' (e.g. a file name) in the given format.
+void PrintPhaseStats(std::ostream& stream, absl::string_view subject,
+                     const PhaseStats& stats, StatsFormat format);
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_PHASE_STATS_H_
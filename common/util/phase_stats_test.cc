@@ -0,0 +1,113 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/phase_stats.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "common/util/allocation_counter.h"
+
+namespace verible {
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(PhaseStatsTest, NestedPhasesRecordedInOrderOfCompletion) {
+  PhaseStats stats;
+  {
+    const auto outer = stats.Measure("outer");
+    { const auto inner = stats.Measure("inner"); }
+  }
+  const auto& phases = stats.Phases();
+  ASSERT_EQ(phases.size(), 2);
+  EXPECT_EQ(phases[0].name, "inner");
+  EXPECT_EQ(phases[1].name, "outer");
+  EXPECT_GE(phases[1].wall_time, phases[0].wall_time);
+}
+
+TEST(PhaseStatsTest, CountsAllocations) {
+  // Requires the :allocation_counting library to be linked in.
+  ASSERT_TRUE(AllocationCountingEnabled());
+  PhaseStats stats;
+  {
+    const auto phase = stats.Measure("allocate");
+    for (int i = 0; i < 10; ++i) {
+      auto p = std::unique_ptr<std::vector<int>>(new std::vector<int>(100));
+    }
+  }
+  ASSERT_EQ(stats.Phases().size(), 1);
+  EXPECT_GE(stats.Phases()[0].allocations, 20);
+  EXPECT_GE(stats.Phases()[0].allocated_bytes, 10 * 100 * sizeof(int));
+}
+
+TEST(PhaseStatsTest, AppendWithPrefix) {
+  PhaseStats first, second;
+  { const auto phase = first.Measure("lex"); }
+  { const auto phase = second.Measure("parse"); }
+  first.Append(second, "retry/");
+  const auto& phases = first.Phases();
+  ASSERT_EQ(phases.size(), 2);
+  EXPECT_EQ(phases[0].name, "lex");
+  EXPECT_EQ(phases[1].name, "retry/parse");
+}
+
+TEST(PrintPhaseStatsTest, None) {
+  PhaseStats stats;
+  { const auto phase = stats.Measure("lex"); }
+  std::ostringstream stream;
+  PrintPhaseStats(stream, "foo.sv", stats, StatsFormat::kNone);
+  EXPECT_TRUE(stream.str().empty());
+}
+
+TEST(PrintPhaseStatsTest, Text) {
+  PhaseStats stats;
+  { const auto phase = stats.Measure("lex"); }
+  { const auto phase = stats.Measure("parse"); }
+  std::ostringstream stream;
+  PrintPhaseStats(stream, "foo.sv", stats, StatsFormat::kText);
+  EXPECT_THAT(stream.str(), HasSubstr("Phase statistics for foo.sv:\n"));
+  EXPECT_THAT(stream.str(), HasSubstr("\n  lex "));
+  EXPECT_THAT(stream.str(), HasSubstr("\n  parse "));
+}
+
+TEST(PrintPhaseStatsTest, Json) {
+  PhaseStats stats;
+  PhaseStat phase;
+  phase.name = "parse";
+  phase.wall_time = std::chrono::microseconds(42);
+  stats.Record(phase);
+  std::ostringstream stream;
+  PrintPhaseStats(stream, "a\"b\\c.sv", stats, StatsFormat::kJson);
+  EXPECT_THAT(stream.str(),
+              HasSubstr("{\"subject\": \"a\\\"b\\\\c.sv\", \"phases\": "
+                        "[{\"name\": \"parse\", \"wall_time_us\": 42"));
+  EXPECT_EQ(stream.str().back(), '\n');
+}
+
+TEST(StatsFormatTest, ParseFlag) {
+  StatsFormat format = StatsFormat::kNone;
+  std::string error;
+  EXPECT_TRUE(AbslParseFlag("json", &format, &error));
+  EXPECT_EQ(format, StatsFormat::kJson);
+  EXPECT_EQ(AbslUnparseFlag(format), "json");
+  EXPECT_FALSE(AbslParseFlag("xml", &format, &error));
+}
+
+}  // namespace
+}  // namespace verible
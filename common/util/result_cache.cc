@@ -0,0 +1,215 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/result_cache.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/util/file_util.h"
+#include "common/util/logging.h"
+
+namespace verible {
+
+namespace {
+
+// Entry file names: kEntryPrefix + key.  Temporary files use a different
+// prefix, so that eviction and lookups never pick up partial entries.
+constexpr absl::string_view kEntryPrefix = "r-";
+constexpr absl::string_view kTempPrefix = "tmp-";
+
+// Temporary files older than this were left behind by writers that crashed
+// before renaming them, and are evicted like entries.  Writers only keep a
+// temporary file open for as long as it takes to write one entry.
+constexpr int64_t kTempGracePeriodNs = int64_t{10} * 60 * 1000000000;
+
+// 128-bit FNV-1a.  Not cryptographic, but stable across builds and
+// platforms, and wide enough that accidental collisions are not a concern.
+class Fnv1a128 {
+ public:
+  void Update(absl::string_view bytes) {
+    for (const char c : bytes) {
+      state_ ^= static_cast<uint8_t>(c);
+      state_ *= kPrime;
+    }
+  }
+
+  std::string HexDigest() const {
+    char bytes[16];
+    for (int i = 0; i < 16; ++i) {
+      bytes[i] = static_cast<char>(state_ >> (8 * (15 - i)));
+    }
+    return absl::BytesToHexString(absl::string_view(bytes, sizeof(bytes)));
+  }
+
+ private:
+  using uint128 = unsigned __int128;
+
+  // 2^88 + 2^8 + 0x3b
+  static constexpr uint128 kPrime = (uint128{1} << 88) + (1 << 8) + 0x3b;
+
+  uint128 state_ = (uint128{0x6c62272e07bb0142} << 64) + 0x62b821756295c58d;
+};
+
+struct EntryInfo {
+  std::string path;
+  size_t size;
+  int64_t mtime_ns;  // last use
+  bool abandoned;    // temporary file of a crashed writer
+};
+
+// Lists the entries of 'dir', and temporary files that have outlived
+// kTempGracePeriodNs, but not temporary files that may still be written.
+std::vector<EntryInfo> ListEntries(const std::string& dir) {
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+  const int64_t now_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+  std::vector<EntryInfo> entries;
+  DIR* const d = opendir(dir.c_str());
+  if (d == nullptr) return entries;
+  while (const struct dirent* e = readdir(d)) {
+    const bool is_temp = absl::StartsWith(e->d_name, kTempPrefix);
+    if (!is_temp && !absl::StartsWith(e->d_name, kEntryPrefix)) continue;
+    std::string path = file::JoinPath(dir, e->d_name);
+    struct stat entry_stat;
+    // An entry may have been evicted by another process in the meantime.
+    if (stat(path.c_str(), &entry_stat) != 0) continue;
+    const int64_t mtime_ns = int64_t{entry_stat.st_mtim.tv_sec} * 1000000000 +
+                             entry_stat.st_mtim.tv_nsec;
+    if (is_temp && now_ns - mtime_ns < kTempGracePeriodNs) continue;
+    entries.push_back({std::move(path), static_cast<size_t>(entry_stat.st_size),
+                       mtime_ns, is_temp});
+  }
+  closedir(d);
+  return entries;
+}
+
+}  // namespace
+
+ResultCache::ResultCache(absl::string_view dir, size_t max_bytes)
+    : dir_(dir), max_bytes_(max_bytes), unchecked_bytes_(max_bytes) {
+  // unchecked_bytes_ starts out "full" so that the first Store() checks the
+  // size of what other processes may have left behind.
+  if (!file::CreateDir(dir_)) {
+    LOG(WARNING) << "Cannot create cache directory " << dir_;
+  }
+}
+
+std::string ResultCache::Key(std::initializer_list<absl::string_view> parts) {
+  Fnv1a128 hash;
+  for (const auto part : parts) {
+    // Prefix each part with its length to delimit it.
+    hash.Update(absl::StrCat(part.length(), ":"));
+    hash.Update(part);
+  }
+  return hash.HexDigest();
+}
+
+const std::string& ResultCache::ToolBuildId() {
+  static const std::string* const build_id = [] {
+    // Identify the executable by its file, rather than by hashing its
+    // contents, which would cost every short-lived process a full read.
+    // Rebuilding or reinstalling a tool replaces the file, which changes
+    // its inode or modification time.
+    struct stat exe_stat;
+    if (stat("/proc/self/exe", &exe_stat) != 0) {
+      // Without an identity, never share results with other processes.
+      return new std::string(
+          Key({"unknown-build", absl::StrCat(getpid()),
+               absl::StrCat(std::chrono::steady_clock::now()
+                                .time_since_epoch()
+                                .count())}));
+    }
+    return new std::string(
+        Key({absl::StrCat(exe_stat.st_dev), absl::StrCat(exe_stat.st_ino),
+             absl::StrCat(exe_stat.st_size),
+             absl::StrCat(exe_stat.st_mtim.tv_sec),
+             absl::StrCat(exe_stat.st_mtim.tv_nsec)}));
+  }();
+  return *build_id;
+}
+
+std::string ResultCache::EntryPath(absl::string_view key) const {
+  return file::JoinPath(dir_, absl::StrCat(kEntryPrefix, key));
+}
+
+bool ResultCache::Lookup(absl::string_view key, std::string* value) const {
+  const std::string path = EntryPath(key);
+  if (!file::GetContents(path, value)) return false;
+  // Refresh the modification time, which eviction uses as last-use time.
+  utime(path.c_str(), nullptr);
+  return true;
+}
+
+bool ResultCache::Store(absl::string_view key, absl::string_view value) {
+  // Write to a unique temporary file, and atomically rename into place.
+  const std::string temp_path =
+      file::JoinPath(dir_, absl::StrCat(kTempPrefix, getpid(), "-",
+                                        temp_counter_++, "-", key));
+  if (!file::SetContents(temp_path, value) ||
+      rename(temp_path.c_str(), EntryPath(key).c_str()) != 0) {
+    unlink(temp_path.c_str());
+    return false;
+  }
+  const size_t unchecked = unchecked_bytes_ += value.size();
+  if (unchecked >= max_bytes_ / 16) {
+    unchecked_bytes_ = 0;
+    size_t total_bytes = 0;
+    for (const auto& entry : ListEntries(dir_)) total_bytes += entry.size;
+    // Evict somewhat below the limit, so that eviction is not triggered by
+    // every subsequent store.
+    if (total_bytes > max_bytes_) Evict(max_bytes_ / 4 * 3);
+  }
+  return true;
+}
+
+void ResultCache::Evict(size_t target_bytes) const {
+  std::vector<EntryInfo> entries(ListEntries(dir_));
+  size_t total_bytes = 0;
+  for (const auto& entry : entries) total_bytes += entry.size;
+  // Abandoned temporary files first, then entries, oldest first.
+  std::sort(entries.begin(), entries.end(),
+            [](const EntryInfo& a, const EntryInfo& b) {
+              if (a.abandoned != b.abandoned) return a.abandoned;
+              return a.mtime_ns < b.mtime_ns;
+            });
+  for (const auto& entry : entries) {
+    // Abandoned temporary files are garbage, regardless of the target size.
+    if (!entry.abandoned && total_bytes <= target_bytes) break;
+    // Another process may have removed it already, which is fine.
+    unlink(entry.path.c_str());
+    total_bytes -= entry.size;
+  }
+}
+
+void ResultCache::Clear() const {
+  for (const auto& entry : ListEntries(dir_)) unlink(entry.path.c_str());
+}
+
+}  // namespace verible
@@ -0,0 +1,97 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ResultCache is a persistent, content-addressed cache of tool results in a
+// local directory, e.g. lint diagnostics or formatted output, keyed by a hash
+// of everything that determines the result (see ResultCache::Key).
+//
+// Each entry is one file named by its key.  Entries are written to a
+// temporary file and renamed into place, so readers never see partial
+// entries, and several processes (or threads) may share one directory.
+// When the directory grows beyond its size limit, the least recently used
+// entries are evicted, along with temporary files that writers left behind.
+
+#ifndef VERIBLE_COMMON_UTIL_RESULT_CACHE_H_
+#define VERIBLE_COMMON_UTIL_RESULT_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace verible {
+
+class ResultCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 256 << 20;
+
+  // Uses (and creates, if needed) directory 'dir'.
+  // Eviction keeps the total size of entries under about 'max_bytes'.
+  explicit ResultCache(absl::string_view dir,
+                       size_t max_bytes = kDefaultMaxBytes);
+
+  ResultCache(const ResultCache&) = delete;
+  ResultCache& operator=(const ResultCache&) = delete;
+
+  // Returns a key (a 128-bit hash as 32 hex digits) for the sequence of
+  // 'parts', which should include the input contents, every setting that
+  // affects the result, and ToolBuildId().  Part boundaries are significant:
+  // {"ab", "c"} and {"a", "bc"} yield different keys.
+  static std::string Key(std::initializer_list<absl::string_view> parts);
+
+  // Returns an identifier of the running executable (a hash of the device,
+  // inode, size and modification time of its file), so that results of
+  // different builds of a tool are never confused.
+  static const std::string& ToolBuildId();
+
+  // Returns true and sets 'value' if an entry for 'key' exists.
+  // Marks the entry as recently used.
+  bool Lookup(absl::string_view key, std::string* value) const;
+
+  // Stores 'value' under 'key', replacing any existing entry, and evicts old
+  // entries if needed.  Returns false if the entry could not be written,
+  // which callers may ignore.
+  bool Store(absl::string_view key, absl::string_view value);
+
+  // Removes least recently used entries until the total size of entries is
+  // at most 'target_bytes'.  Also removes temporary files that were abandoned
+  // by writers (e.g. that crashed) long enough ago, which count toward the
+  // total size until then.
+  void Evict(size_t target_bytes) const;
+
+  // Removes all entries, and abandoned temporary files.
+  void Clear() const;
+
+  const std::string& Dir() const { return dir_; }
+
+ private:
+  std::string EntryPath(absl::string_view key) const;
+
+  const std::string dir_;
+  const size_t max_bytes_;
+
+  // Bytes stored by this object since the last scan of the directory's size.
+  // Scanning the whole directory after every store would be quadratic, so
+  // the directory is only scanned once a fraction of max_bytes_ was stored.
+  std::atomic<size_t> unchecked_bytes_;
+
+  // Disambiguates temporary file names within this process.
+  std::atomic<size_t> temp_counter_{0};
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_RESULT_CACHE_H_
@@ -0,0 +1,170 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/result_cache.h"
+
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/util/file_util.h"
+
+namespace verible {
+namespace {
+
+TEST(ResultCacheTest, KeyIsDeterministic) {
+  EXPECT_EQ(ResultCache::Key({"abc", "def"}), ResultCache::Key({"abc", "def"}));
+  EXPECT_EQ(ResultCache::Key({}).size(), 32);
+}
+
+TEST(ResultCacheTest, KeyDependsOnPartBoundaries) {
+  EXPECT_NE(ResultCache::Key({"ab", "c"}), ResultCache::Key({"a", "bc"}));
+  EXPECT_NE(ResultCache::Key({"abc"}), ResultCache::Key({"abc", ""}));
+  EXPECT_NE(ResultCache::Key({"abc"}), ResultCache::Key({"abd"}));
+}
+
+TEST(ResultCacheTest, ToolBuildIdIsStable) {
+  EXPECT_FALSE(ResultCache::ToolBuildId().empty());
+  EXPECT_EQ(ResultCache::ToolBuildId(), ResultCache::ToolBuildId());
+}
+
+// Gives each test an empty cache directory of its own.
+class ResultCacheDirTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const char* test_name =
+        testing::UnitTest::GetInstance()->current_test_info()->name();
+    dir_ = file::JoinPath(testing::TempDir(),
+                          absl::StrCat("cache_", test_name));
+    // The directory may remain from an earlier run.
+    ResultCache(dir_).Clear();
+  }
+
+  std::string dir_;
+};
+
+TEST_F(ResultCacheDirTest, StoreAndLookup) {
+  ResultCache cache(dir_);
+  const std::string key = ResultCache::Key({"some input"});
+  std::string value;
+  EXPECT_FALSE(cache.Lookup(key, &value));
+
+  EXPECT_TRUE(cache.Store(key, "some result"));
+  ASSERT_TRUE(cache.Lookup(key, &value));
+  EXPECT_EQ(value, "some result");
+
+  // Replace existing entry.
+  EXPECT_TRUE(cache.Store(key, ""));
+  ASSERT_TRUE(cache.Lookup(key, &value));
+  EXPECT_EQ(value, "");
+}
+
+TEST_F(ResultCacheDirTest, SharedBetweenInstances) {
+  const std::string key = ResultCache::Key({"input"});
+  {
+    ResultCache writer(dir_);
+    EXPECT_TRUE(writer.Store(key, "result"));
+  }
+  ResultCache reader(dir_);
+  std::string value;
+  ASSERT_TRUE(reader.Lookup(key, &value));
+  EXPECT_EQ(value, "result");
+}
+
+TEST_F(ResultCacheDirTest, EvictsToTarget) {
+  ResultCache cache(dir_);
+  const std::string value(100, 'x');
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(cache.Store(ResultCache::Key({std::to_string(i)}), value));
+  }
+  cache.Evict(550);
+  int remaining = 0;
+  std::string unused;
+  for (int i = 0; i < 10; ++i) {
+    remaining += cache.Lookup(ResultCache::Key({std::to_string(i)}), &unused);
+  }
+  EXPECT_EQ(remaining, 5);
+}
+
+TEST_F(ResultCacheDirTest, StoreStaysWithinBound) {
+  ResultCache cache(dir_, 1000);
+  const std::string value(100, 'x');
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(cache.Store(ResultCache::Key({std::to_string(i)}), value));
+  }
+  int remaining = 0;
+  std::string unused;
+  for (int i = 0; i < 100; ++i) {
+    remaining += cache.Lookup(ResultCache::Key({std::to_string(i)}), &unused);
+  }
+  EXPECT_GT(remaining, 0);
+  EXPECT_LE(remaining, 10);
+  // The most recently stored entry survives.
+  EXPECT_TRUE(cache.Lookup(ResultCache::Key({"99"}), &unused));
+}
+
+// Creates a file in 'dir' that looks like the temporary file of a writer,
+// last modified 'age_seconds' ago.
+static std::string MakeTempFile(const std::string& dir, absl::string_view name,
+                                time_t age_seconds) {
+  const std::string path = file::JoinPath(dir, absl::StrCat("tmp-", name));
+  EXPECT_TRUE(file::SetContents(path, std::string(100, 'x')));
+  const time_t mtime = time(nullptr) - age_seconds;
+  const struct utimbuf times = {mtime, mtime};
+  EXPECT_EQ(utime(path.c_str(), &times), 0);
+  return path;
+}
+
+static bool FileExists(const std::string& path) {
+  struct stat file_stat;
+  return stat(path.c_str(), &file_stat) == 0;
+}
+
+TEST_F(ResultCacheDirTest, EvictsAbandonedTempFiles) {
+  ResultCache cache(dir_);
+  const std::string key = ResultCache::Key({"input"});
+  EXPECT_TRUE(cache.Store(key, "result"));
+  const std::string abandoned = MakeTempFile(dir_, "abandoned", 24 * 3600);
+  const std::string in_progress = MakeTempFile(dir_, "in-progress", 0);
+
+  // Abandoned files go, even if entries are within the target size.
+  cache.Evict(1000);
+  EXPECT_FALSE(FileExists(abandoned));
+  // Files that may still be written, and entries, stay.
+  EXPECT_TRUE(FileExists(in_progress));
+  std::string value;
+  EXPECT_TRUE(cache.Lookup(key, &value));
+  unlink(in_progress.c_str());
+}
+
+TEST_F(ResultCacheDirTest, AbandonedTempFilesCountTowardBound) {
+  ResultCache cache(dir_, 1000);
+  std::vector<std::string> abandoned;
+  for (int i = 0; i < 20; ++i) {
+    abandoned.push_back(MakeTempFile(dir_, std::to_string(i), 24 * 3600));
+  }
+  // The first store scans the directory, and finds it over the limit.
+  EXPECT_TRUE(cache.Store(ResultCache::Key({"input"}), "result"));
+  for (const auto& path : abandoned) EXPECT_FALSE(FileExists(path)) << path;
+}
+
+}  // namespace
+}  // namespace verible
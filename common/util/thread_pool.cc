@@ -0,0 +1,117 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>  // IWYU pragma: keep
+#include <thread>
+#include <utility>
+
+namespace verible {
+
+ThreadPool::ThreadPool(int num_threads) {
+  const size_t count = std::max(num_threads, 1);
+  queues_.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  workers_.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutting_down_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+int ThreadPool::HardwareConcurrency() {
+  const unsigned int count = std::thread::hardware_concurrency();
+  return count > 0 ? count : 1;
+}
+
+void ThreadPool::Schedule(Task task) {
+  // When called from a worker this still distributes round-robin; idle
+  // workers will steal back whatever is unevenly placed.
+  const size_t index = next_queue_++ % queues_.size();
+  {
+    WorkQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++unclaimed_tasks_;
+  }
+  work_available_.notify_one();
+}
+
+bool ThreadPool::TakeTask(size_t index, Task* task) {
+  {
+    WorkQueue& own = *queues_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      *task = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      return true;
+    }
+  }
+  // Steal from the opposite end of the victims' queues, to reduce contention
+  // with the owners working on the front.
+  for (size_t offset = 1; offset < queues_.size(); ++offset) {
+    WorkQueue& victim = *queues_[(index + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      *task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(
+          lock, [this] { return unclaimed_tasks_ > 0 || shutting_down_; });
+      // Drain all remaining work before exiting.
+      if (unclaimed_tasks_ == 0) return;
+      // Claiming a task here guarantees that one remains in some queue
+      // for this worker, because tasks are only removed by claimants.
+      --unclaimed_tasks_;
+    }
+    Task task;
+    while (!TakeTask(index, &task)) {
+      // The claimed task was queued before it was counted, so a scan can
+      // only miss it by racing with other workers' removals; retry.
+      std::this_thread::yield();
+    }
+    task();
+  }
+}
+
+}  // namespace verible
@@ -0,0 +1,99 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_UTIL_THREAD_POOL_H_
+#define VERIBLE_COMMON_UTIL_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>  // IWYU pragma: keep
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // IWYU pragma: keep
+#include <thread>
+#include <vector>
+
+namespace verible {
+
+// ThreadPool runs scheduled tasks on a fixed set of worker threads.
+// Each worker owns a queue of tasks: it takes work from the front of its own
+// queue, and when that runs dry, steals from the back of other workers'
+// queues.  This keeps all workers busy when task durations vary widely,
+// e.g. when analyzing files of very different sizes.
+//
+// Tasks may be scheduled from any thread, including from within other tasks.
+// There is no ordering guarantee among tasks; callers that need results in a
+// particular order should write them into pre-allocated slots.
+//
+// Destruction blocks until every scheduled task has run.
+class ThreadPool {
+ public:
+  // Starts 'num_threads' workers.  Values < 1 are treated as 1.
+  explicit ThreadPool(int num_threads);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Waits for all pending tasks to finish, and then joins all workers.
+  ~ThreadPool();
+
+  // Enqueues a task to be run by one of the workers.
+  void Schedule(std::function<void()> task);
+
+  // Returns the number of worker threads.
+  size_t NumThreads() const { return workers_.size(); }
+
+  // Returns the number of hardware threads, or 1 if that is unknown.
+  static int HardwareConcurrency();
+
+ private:
+  using Task = std::function<void()>;
+
+  // One task queue per worker.
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  // Removes one task, preferring the front of worker 'index's own queue,
+  // otherwise stealing from the back of another worker's queue.
+  // Returns false if all queues were empty.
+  bool TakeTask(size_t index, Task* task);
+
+  // Main loop of each worker thread.
+  void WorkerLoop(size_t index);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+  std::vector<std::thread> workers_;
+
+  // Round-robin selector for the queue that receives the next task.
+  std::atomic<size_t> next_queue_{0};
+
+  // Guards the following members, which are used to put idle workers to
+  // sleep and wake them up.
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+
+  // Number of tasks that have been enqueued but not yet claimed by a worker.
+  size_t unclaimed_tasks_ = 0;
+
+  // Set once the pool is being destroyed.
+  bool shutting_down_ = false;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_THREAD_POOL_H_
@@ -0,0 +1,80 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace verible {
+namespace {
+
+TEST(ThreadPoolTest, NonPositiveThreadCountUsesOneThread) {
+  ThreadPool pool(0);
+  EXPECT_EQ(pool.NumThreads(), 1);
+}
+
+TEST(ThreadPoolTest, HardwareConcurrencyIsPositive) {
+  EXPECT_GE(ThreadPool::HardwareConcurrency(), 1);
+}
+
+TEST(ThreadPoolTest, NoTasks) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.NumThreads(), 4);
+}
+
+TEST(ThreadPoolTest, AllTasksRunBeforeDestruction) {
+  std::atomic<int> count(0);
+  {
+    ThreadPool pool(3);
+    for (int i = 0; i < 1000; ++i) {
+      pool.Schedule([&count] { ++count; });
+    }
+  }
+  EXPECT_EQ(count, 1000);
+}
+
+TEST(ThreadPoolTest, ResultsInPreallocatedSlots) {
+  std::vector<int> results(100, 0);
+  {
+    ThreadPool pool(8);
+    for (int i = 0; i < 100; ++i) {
+      pool.Schedule([&results, i] { results[i] = i * i; });
+    }
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(results[i], i * i);
+  }
+}
+
+TEST(ThreadPoolTest, TasksCanScheduleMoreTasks) {
+  std::atomic<int> count(0);
+  {
+    ThreadPool pool(2);
+    for (int i = 0; i < 10; ++i) {
+      pool.Schedule([&pool, &count] {
+        for (int j = 0; j < 10; ++j) {
+          pool.Schedule([&count] { ++count; });
+        }
+      });
+    }
+  }
+  EXPECT_EQ(count, 100);
+}
+
+}  // namespace
+}  // namespace verible
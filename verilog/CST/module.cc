@@ -22,9 +22,11 @@
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_index.h"
 #include "common/text/token_info.h"
 #include "common/text/tree_utils.h"
 #include "verilog/CST/verilog_matchers.h"  // IWYU pragma: keep
+#include "verilog/CST/verilog_nonterminals.h"
 
 namespace verilog {
 
@@ -33,6 +35,11 @@ std::vector<verible::TreeSearchMatch> FindAllModuleDeclarations(
   return SearchSyntaxTree(root, NodekModuleDeclaration());
 }
 
+std::vector<verible::TreeSearchMatch> FindAllModuleDeclarations(
+    const verible::SyntaxTreeIndex& index) {
+  return index.FindAll(verible::NodeTag(NodeEnum::kModuleDeclaration));
+}
+
 const verible::SyntaxTreeNode& GetModuleHeader(
     const verible::Symbol& module_symbol) {
   return verible::GetSubtreeAsNode(module_symbol, NodeEnum::kModuleDeclaration,
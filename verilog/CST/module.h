@@ -23,6 +23,7 @@
 #include "common/analysis/syntax_tree_search.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_index.h"
 #include "common/text/token_info.h"
 
 namespace verilog {
@@ -31,6 +32,10 @@ namespace verilog {
 std::vector<verible::TreeSearchMatch> FindAllModuleDeclarations(
     const verible::Symbol&);
 
+// Find all module declarations, using a prebuilt index of the tree.
+std::vector<verible::TreeSearchMatch> FindAllModuleDeclarations(
+    const verible::SyntaxTreeIndex&);
+
 // Returns the full header of a module (params, ports, etc...).
 const verible::SyntaxTreeNode& GetModuleHeader(const verible::Symbol&);
 
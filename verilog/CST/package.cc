@@ -22,9 +22,11 @@
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_index.h"
 #include "common/text/token_info.h"
 #include "common/text/tree_utils.h"
 #include "verilog/CST/verilog_matchers.h"  // IWYU pragma: keep
+#include "verilog/CST/verilog_nonterminals.h"
 
 namespace verilog {
 
@@ -33,6 +35,11 @@ std::vector<verible::TreeSearchMatch> FindAllPackageDeclarations(
   return SearchSyntaxTree(root, NodekPackageDeclaration());
 }
 
+std::vector<verible::TreeSearchMatch> FindAllPackageDeclarations(
+    const verible::SyntaxTreeIndex& index) {
+  return index.FindAll(verible::NodeTag(NodeEnum::kPackageDeclaration));
+}
+
 const verible::TokenInfo& GetPackageNameToken(const verible::Symbol& s) {
   const auto& name_node =
       verible::GetSubtreeAsLeaf(s, NodeEnum::kPackageDeclaration, 2);
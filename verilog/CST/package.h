@@ -22,6 +22,7 @@
 
 #include "common/analysis/syntax_tree_search.h"
 #include "common/text/symbol.h"
+#include "common/text/syntax_tree_index.h"
 #include "common/text/token_info.h"
 
 namespace verilog {
@@ -30,6 +31,10 @@ namespace verilog {
 std::vector<verible::TreeSearchMatch> FindAllPackageDeclarations(
     const verible::Symbol&);
 
+// Find all package declarations, using a prebuilt index of the tree.
+std::vector<verible::TreeSearchMatch> FindAllPackageDeclarations(
+    const verible::SyntaxTreeIndex&);
+
 // Extract the subnode of a package declaration that is the package name.
 const verible::TokenInfo& GetPackageNameToken(const verible::Symbol&);
 
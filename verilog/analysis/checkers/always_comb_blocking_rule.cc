@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -53,6 +54,10 @@ std::string AlwaysCombBlockingRule::GetDescription(
                       "non-blocking assignment in combinational logic.");
 }
 
+std::vector<verible::SymbolTag> AlwaysCombBlockingRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kAlwaysStatement)};
+}
+
 void AlwaysCombBlockingRule::HandleSymbol(const verible::Symbol& symbol,
                                           const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -50,6 +51,10 @@ std::string AlwaysCombRule::GetDescription(DescriptionType description_type) {
                       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> AlwaysCombRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kAlwaysStatement)};
+}
+
 void AlwaysCombRule::HandleSymbol(const verible::Symbol& symbol,
                                   const SyntaxTreeContext& context) {
   // Check for offending use of always @*
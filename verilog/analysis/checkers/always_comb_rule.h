@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -42,6 +44,8 @@ class AlwaysCombRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -54,15 +58,15 @@ class AlwaysCombRule : public verible::SyntaxTreeLintRule {
   // Diagnostic message.
   static const char kMessage[];
 
-  using Matcher = verible::matcher::Matcher;
+  using CompiledMatcher = verible::matcher::CompiledMatcher;
 
   // Matches event control (sensitivity list) for all signals.
   // For example:
   //   always @* begin
   //     f = g + h;
   //   end
-  const Matcher always_star_matcher_ = NodekAlwaysStatement(
-      AlwaysKeyword(), AlwaysStatementHasEventControlStar());
+  const CompiledMatcher always_star_matcher_{NodekAlwaysStatement(
+      AlwaysKeyword(), AlwaysStatementHasEventControlStar())};
 
   std::set<verible::LintViolation> violations_;
 };
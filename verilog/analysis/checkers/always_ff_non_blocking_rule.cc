@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -53,6 +54,10 @@ std::string AlwaysFFNonBlockingRule::GetDescription(
                       "blocking assignment in sequential logic.");
 }
 
+std::vector<verible::SymbolTag> AlwaysFFNonBlockingRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kAlwaysStatement)};
+}
+
 void AlwaysFFNonBlockingRule::HandleSymbol(const verible::Symbol &symbol,
                                            const SyntaxTreeContext &context) {
   verible::matcher::BoundSymbolManager manager;
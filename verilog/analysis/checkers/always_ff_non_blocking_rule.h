@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -39,6 +41,8 @@ class AlwaysFFNonBlockingRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -51,9 +55,10 @@ class AlwaysFFNonBlockingRule : public verible::SyntaxTreeLintRule {
   // Diagnostic message.
   static const char kMessage[];
 
-  using Matcher = verible::matcher::Matcher;
+  using CompiledMatcher = verible::matcher::CompiledMatcher;
 
-  const Matcher always_ff_matcher_ = NodekAlwaysStatement(AlwaysFFKeyword());
+  const CompiledMatcher always_ff_matcher_{
+      NodekAlwaysStatement(AlwaysFFKeyword())};
 
   std::set<verible::LintViolation> violations_;
 };
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -50,6 +51,10 @@ std::string CaseMissingDefaultRule::GetDescription(
                       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> CaseMissingDefaultRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kCaseItemList)};
+}
+
 void CaseMissingDefaultRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
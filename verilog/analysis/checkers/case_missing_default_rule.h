@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/core_matchers.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
@@ -41,6 +43,8 @@ class CaseMissingDefaultRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -53,10 +57,10 @@ class CaseMissingDefaultRule : public verible::SyntaxTreeLintRule {
   // Diagnostic message.
   static const char kMessage[];
 
-  using Matcher = verible::matcher::Matcher;
+  using CompiledMatcher = verible::matcher::CompiledMatcher;
 
-  Matcher matcher_ =
-      NodekCaseItemList(verible::matcher::Unless(HasDefaultCase()));
+  CompiledMatcher matcher_{
+      NodekCaseItemList(verible::matcher::Unless(HasDefaultCase()))};
 
   std::set<verible::LintViolation> violations_;
 };
@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -154,6 +155,10 @@ static std::string FormatReason(absl::string_view decl_name,
       decl_name, ", got: ", name_text, ". ");
 }
 
+std::vector<verible::SymbolTag> CreateObjectNameMatchRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kAssignmentStatement)};
+}
+
 void CreateObjectNameMatchRule::HandleSymbol(const verible::Symbol& symbol,
                                              const SyntaxTreeContext& context) {
   // Check for assignments that match the pattern.
@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/core_matchers.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
@@ -50,6 +52,8 @@ class CreateObjectNameMatchRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -59,7 +63,7 @@ class CreateObjectNameMatchRule : public verible::SyntaxTreeLintRule {
   // Link to style guide rule.
   static const char kTopic[];
 
-  using Matcher = verible::matcher::Matcher;
+  using CompiledMatcher = verible::matcher::CompiledMatcher;
 
   // Matches against assignments to typename::type_id::create() calls.
   //
@@ -69,13 +73,13 @@ class CreateObjectNameMatchRule : public verible::SyntaxTreeLintRule {
   // Here, the LHS var_h will be bound to "lval" (only for simple references),
   // the qualified function call (mytype::type_id::create) will be bound to
   // "func", and the list of function call arguments will be bound to "args".
-  const Matcher create_assignment_matcher_ = NodekAssignmentStatement(
+  const CompiledMatcher create_assignment_matcher_{NodekAssignmentStatement(
       LValueOfAssignment(
           PathkReference(UnqualifiedReferenceHasId().Bind("lval")),
           verible::matcher::Unless(ReferenceHasHierarchy()),
           verible::matcher::Unless(ReferenceHasIndex())),
       RValueIsFunctionCall(FunctionCallIsQualified().Bind("func"),
-                           FunctionCallArguments().Bind("args")));
+                           FunctionCallArguments().Bind("args")))};
 
   // Record of found violations.
   std::set<verible::LintViolation> violations_;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -57,6 +58,11 @@ std::string ExplicitFunctionLifetimeRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> ExplicitFunctionLifetimeRule::HandledTags()
+    const {
+  return {verible::NodeTag(NodeEnum::kFunctionDeclaration)};
+}
+
 void ExplicitFunctionLifetimeRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   // Don't need to check for lifetime declaration if context is inside a class
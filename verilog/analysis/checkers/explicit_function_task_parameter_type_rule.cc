@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -57,6 +58,11 @@ std::string ExplicitFunctionTaskParameterTypeRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag>
+ExplicitFunctionTaskParameterTypeRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kPortItem)};
+}
+
 void ExplicitFunctionTaskParameterTypeRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -55,6 +56,11 @@ std::string ExplicitParameterStorageTypeRule::GetDescription(
                       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> ExplicitParameterStorageTypeRule::HandledTags()
+    const {
+  return {verible::NodeTag(NodeEnum::kParamDeclaration)};
+}
+
 void ExplicitParameterStorageTypeRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -45,6 +46,10 @@ std::string ForbidDefparamRule::GetDescription(
       "Do not use defparam. See:", GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> ForbidDefparamRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kParameterOverride)};
+}
+
 void ForbidDefparamRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
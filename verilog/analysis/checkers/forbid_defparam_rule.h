@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -41,6 +43,8 @@ class ForbidDefparamRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -48,7 +52,7 @@ class ForbidDefparamRule : public verible::SyntaxTreeLintRule {
 
  private:
   // Matches the defparam construct.
-  const verible::matcher::Matcher matcher_ = NodekParameterOverride();
+  const verible::matcher::CompiledMatcher matcher_{NodekParameterOverride()};
 
   // Link to style guide rule.
   static const char kTopic[];
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -51,6 +52,11 @@ std::string ForbiddenAnonymousEnumsRule::GetDescription(
       ". See ", GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> ForbiddenAnonymousEnumsRule::HandledTags()
+    const {
+  return {verible::NodeTag(NodeEnum::kEnumDataType)};
+}
+
 void ForbiddenAnonymousEnumsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -55,6 +56,12 @@ std::string ForbiddenAnonymousStructsUnionsRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag>
+ForbiddenAnonymousStructsUnionsRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kStructDataType),
+          verible::NodeTag(NodeEnum::kUnionDataType)};
+}
+
 void ForbiddenAnonymousStructsUnionsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -17,6 +17,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -60,6 +61,10 @@ ForbiddenMacroRule::InvalidMacrosMap() {
   return *invalid_symbols;
 }
 
+std::vector<verible::SymbolTag> ForbiddenMacroRule::HandledTags() const {
+  return {verible::LeafTag(MacroCallId)};
+}
+
 void ForbiddenMacroRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
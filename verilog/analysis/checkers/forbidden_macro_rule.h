@@ -18,8 +18,10 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -50,6 +52,8 @@ class ForbiddenMacroRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -65,7 +69,8 @@ class ForbiddenMacroRule : public verible::SyntaxTreeLintRule {
   static const std::map<std::string, std::string>& InvalidMacrosMap();
 
   // Matches all macro call ids, like `foo.
-  const verible::matcher::Matcher matcher_ = MacroCallIdLeaf().Bind("name");
+  const verible::matcher::CompiledMatcher matcher_{
+      MacroCallIdLeaf().Bind("name")};
 
  private:
   std::set<verible::LintViolation> violations_;
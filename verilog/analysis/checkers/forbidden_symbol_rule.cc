@@ -17,6 +17,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -78,6 +79,11 @@ ForbiddenSystemTaskFunctionRule::InvalidSymbolsMap() {
   return *invalid_symbols;
 }
 
+std::vector<verible::SymbolTag> ForbiddenSystemTaskFunctionRule::HandledTags()
+    const {
+  return {verible::LeafTag(SystemTFIdentifier)};
+}
+
 void ForbiddenSystemTaskFunctionRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -47,6 +48,10 @@ std::string GenerateLabelRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> GenerateLabelRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kGenerateBlock)};
+}
+
 void GenerateLabelRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
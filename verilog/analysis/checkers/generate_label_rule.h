@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/core_matchers.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
@@ -53,6 +55,8 @@ class GenerateLabelRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -66,8 +70,8 @@ class GenerateLabelRule : public verible::SyntaxTreeLintRule {
   //      always @(posedge clk) foo <= bar;
   //    end
   //
-  const verible::matcher::Matcher matcher_ =
-      NodekGenerateBlock(verible::matcher::Unless(HasBeginLabel()));
+  const verible::matcher::CompiledMatcher matcher_{
+      NodekGenerateBlock(verible::matcher::Unless(HasBeginLabel()))};
 
   // Link to style guide rule.
   static const char kTopic[];
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -48,6 +49,10 @@ std::string ModuleBeginBlockRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> ModuleBeginBlockRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kModuleBlock)};
+}
+
 void ModuleBeginBlockRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
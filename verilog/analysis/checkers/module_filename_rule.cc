@@ -67,11 +67,11 @@ static bool ModuleNameMatches(const verible::Symbol& s,
 
 void ModuleFilenameRule::Lint(const TextStructureView& text_structure,
                               absl::string_view filename) {
-  const auto& tree = text_structure.SyntaxTree();
-  if (tree == nullptr) return;
+  if (text_structure.SyntaxTree() == nullptr) return;
 
   // Find all module declarations.
-  auto module_matches = FindAllModuleDeclarations(*tree);
+  auto module_matches =
+      FindAllModuleDeclarations(text_structure.GetSyntaxTreeIndex());
 
   // See if any names match the stem of the filename.
   const absl::string_view basename = verible::file::Basename(filename);
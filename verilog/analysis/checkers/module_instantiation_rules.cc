@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -92,6 +93,10 @@ const char ModuleParameterRule::kMessage[] =
     "Pass named parameters for parameterized module instantiations with "
     "more than one parameter";
 
+std::vector<verible::SymbolTag> ModuleParameterRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kActualParameterList)};
+}
+
 void ModuleParameterRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   // Syntactically, class instances are indistinguishable from module instances
@@ -132,6 +137,10 @@ const char ModulePortRule::kMessage[] =
     "Use named ports for module instantiation with "
     "more than one port";
 
+std::vector<verible::SymbolTag> ModulePortRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kGateInstance)};
+}
+
 void ModulePortRule::HandleSymbol(const verible::Symbol& symbol,
                                   const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
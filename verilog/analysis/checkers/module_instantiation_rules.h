@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -42,6 +44,8 @@ class ModuleParameterRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
   verible::LintRuleStatus Report() const override;
@@ -51,8 +55,8 @@ class ModuleParameterRule : public verible::SyntaxTreeLintRule {
   // For examples:
   //   foo #(1, 2) bar;
   // Here, the node representing "1, 2" will be bound to "list".
-  const verible::matcher::Matcher matcher_ = NodekActualParameterList(
-      ActualParameterListHasPositionalParameterList().Bind("list"));
+  const verible::matcher::CompiledMatcher matcher_{NodekActualParameterList(
+      ActualParameterListHasPositionalParameterList().Bind("list"))};
 
   // Link to style guide rule.
   static const char kTopic[];
@@ -74,6 +78,8 @@ class ModulePortRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
   verible::LintRuleStatus Report() const override;
@@ -84,8 +90,8 @@ class ModulePortRule : public verible::SyntaxTreeLintRule {
   // For example:
   //   foo bar (port1, port2);
   // Here, the node representing "port1, port2" will be bound to "list"
-  const verible::matcher::Matcher matcher_ =
-      NodekGateInstance(GateInstanceHasPortList().Bind("list"));
+  const verible::matcher::CompiledMatcher matcher_{
+      NodekGateInstance(GateInstanceHasPortList().Bind("list"))};
 
   // Link to style guide rule.
   static const char kTopic[];
@@ -22,6 +22,7 @@
 #include "absl/strings/string_view.h"
 #include "common/analysis/citation.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_scan.h"
 #include "common/text/token_info.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
@@ -50,11 +51,14 @@ std::string NoTabsRule::GetDescription(DescriptionType description_type) {
 }
 
 void NoTabsRule::HandleLine(absl::string_view line) {
-  // Finds first tab in each line, if there is one.
-  // This reports only the first violation on each line.
-  const auto tab_pos = line.find('\t');
-  if (tab_pos != absl::string_view::npos) {
-    TokenInfo token(TK_SPACE, line.substr(tab_pos, 1));
+  HandleScannedLine(line, verible::ScanLine(line));
+}
+
+void NoTabsRule::HandleScannedLine(absl::string_view line,
+                                   const verible::LineStats& stats) {
+  // Reports only the first tab on each line, if there is one.
+  if (stats.first_tab >= 0) {
+    TokenInfo token(TK_SPACE, line.substr(stats.first_tab, 1));
     violations_.insert(LintViolation(token, kMessage));
   }
 }
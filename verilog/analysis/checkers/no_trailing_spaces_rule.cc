@@ -16,9 +16,6 @@
 
 #include <stddef.h>
 
-#include <algorithm>
-#include <cctype>
-#include <iterator>
 #include <set>
 #include <string>
 
@@ -26,6 +23,7 @@
 #include "absl/strings/string_view.h"
 #include "common/analysis/citation.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_scan.h"
 #include "common/text/token_info.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
@@ -54,19 +52,15 @@ std::string NoTrailingSpacesRule::GetDescription(
 }
 
 void NoTrailingSpacesRule::HandleLine(absl::string_view line) {
-  // Searches each line in reverse for spaces.
-  const auto rbegin = line.crbegin();
-  const auto rend = line.crend();
-  if (rbegin != rend) {
-    // Lines already exclude \n, so we can check using std::isspace.
-    const auto reverse_iter =
-        std::find_if(rbegin, rend, [](char c) { return !std::isspace(c); });
-    const int trailing = std::distance(rbegin, reverse_iter);
-    if (trailing != 0) {
-      const int column = line.length() - trailing;
-      const TokenInfo token(TK_SPACE, line.substr(column));
-      violations_.insert(LintViolation(token, kMessage));
-    }
+  HandleScannedLine(line, verible::ScanLine(line));
+}
+
+void NoTrailingSpacesRule::HandleScannedLine(absl::string_view line,
+                                             const verible::LineStats& stats) {
+  // Lines already exclude \n, so trailing whitespace is as in std::isspace.
+  if (stats.trailing_space < static_cast<int>(line.length())) {
+    const TokenInfo token(TK_SPACE, line.substr(stats.trailing_space));
+    violations_.insert(LintViolation(token, kMessage));
   }
 }
 
@@ -23,6 +23,7 @@
 #include "absl/strings/string_view.h"
 #include "common/analysis/line_lint_rule.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_scan.h"
 #include "verilog/analysis/descriptions.h"
 
 namespace verilog {
@@ -42,6 +43,9 @@ class NoTrailingSpacesRule : public verible::LineLintRule {
 
   void HandleLine(absl::string_view line) override;
 
+  void HandleScannedLine(absl::string_view line,
+                         const verible::LineStats& stats) override;
+
   verible::LintRuleStatus Report() const override;
 
  private:
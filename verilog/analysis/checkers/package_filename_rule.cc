@@ -60,11 +60,11 @@ std::string PackageFilenameRule::GetDescription(
 
 void PackageFilenameRule::Lint(const TextStructureView& text_structure,
                                absl::string_view filename) {
-  const auto& tree = text_structure.SyntaxTree();
-  if (tree == nullptr) return;
+  if (text_structure.SyntaxTree() == nullptr) return;
 
   // Find all package declarations.
-  auto package_matches = FindAllPackageDeclarations(*tree);
+  auto package_matches =
+      FindAllPackageDeclarations(text_structure.GetSyntaxTreeIndex());
 
   // See if names match the stem of the filename.
   //
@@ -17,6 +17,7 @@
 #include <algorithm>  // for std::distance
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -61,6 +62,10 @@ std::string PackedDimensionsRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> PackedDimensionsRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kDimensionRange)};
+}
+
 void PackedDimensionsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   if (!ContextIsInsidePackedDimensions(context)) return;
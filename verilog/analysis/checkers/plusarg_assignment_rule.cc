@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -50,6 +51,10 @@ std::string PlusargAssignmentRule::GetDescription(
                       " system task. See ", GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> PlusargAssignmentRule::HandledTags() const {
+  return {verible::LeafTag(SystemTFIdentifier)};
+}
+
 void PlusargAssignmentRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
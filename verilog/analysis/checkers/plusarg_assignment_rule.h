@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -49,6 +51,8 @@ class PlusargAssignmentRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -63,8 +67,8 @@ class PlusargAssignmentRule : public verible::SyntaxTreeLintRule {
   static const char kForbiddenFunctionName[];
   static const char kCorrectFunctionName[];
 
-  const verible::matcher::Matcher matcher_ =
-      SystemTFIdentifierLeaf().Bind("name");
+  const verible::matcher::CompiledMatcher matcher_{
+      SystemTFIdentifierLeaf().Bind("name")};
 
  private:
   std::set<verible::LintViolation> violations_;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -63,6 +64,11 @@ std::string ProperParameterDeclarationRule::GetDescription(
 }
 
 // TODO(kathuriac): Also check the 'interface' and 'program' constructs.
+std::vector<verible::SymbolTag> ProperParameterDeclarationRule::HandledTags()
+    const {
+  return {verible::NodeTag(NodeEnum::kParamDeclaration)};
+}
+
 void ProperParameterDeclarationRule::HandleSymbol(
     const verible::Symbol& symbol, const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -58,6 +59,12 @@ std::string SignalNameStyleRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> SignalNameStyleRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kPortDeclaration),
+          verible::NodeTag(NodeEnum::kNetDeclaration),
+          verible::NodeTag(NodeEnum::kDataDeclaration)};
+}
+
 void SignalNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                        const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -42,6 +44,8 @@ class SignalNameStyleRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -54,11 +58,11 @@ class SignalNameStyleRule : public verible::SyntaxTreeLintRule {
   // Diagnostic message.
   static const char kMessage[];
 
-  using Matcher = verible::matcher::Matcher;
+  using CompiledMatcher = verible::matcher::CompiledMatcher;
 
-  Matcher matcher_port_ = NodekPortDeclaration();
-  Matcher matcher_net_ = NodekNetDeclaration();
-  Matcher matcher_data_ = NodekDataDeclaration();
+  CompiledMatcher matcher_port_{NodekPortDeclaration()};
+  CompiledMatcher matcher_net_{NodekNetDeclaration()};
+  CompiledMatcher matcher_data_{NodekDataDeclaration()};
 
   std::set<verible::LintViolation> violations_;
 };
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -56,6 +57,10 @@ std::string StructUnionNameStyleRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> StructUnionNameStyleRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kTypeDeclaration)};
+}
+
 void StructUnionNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
                                             const SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -17,9 +17,11 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -44,6 +46,8 @@ class UndersizedBinaryLiteralRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -62,10 +66,10 @@ class UndersizedBinaryLiteralRule : public verible::SyntaxTreeLintRule {
   // constant width and based literal.
   // TODO(fangism): If more precision is needed than what the inner matcher
   // provides, pass a more specific predicate matching function instead.
-  const verible::matcher::Matcher number_matcher_ = NodekNumber(
+  const verible::matcher::CompiledMatcher number_matcher_{NodekNumber(
       NumberHasConstantWidth().Bind("width"),
       NumberHasBasedLiteral(NumberIsBinary().Bind("base"),
-                            NumberHasBinaryDigits().Bind("digits")));
+                            NumberHasBinaryDigits().Bind("digits")))};
 
   std::set<verible::LintViolation> violations_;
 };
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -69,6 +70,10 @@ std::string UnpackedDimensionsRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> UnpackedDimensionsRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kDimensionRange)};
+}
+
 void UnpackedDimensionsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   if (!ContextIsInsideUnpackedDimensions(context)) return;
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "common/analysis/citation.h"
@@ -54,6 +55,10 @@ std::string V2001GenerateBeginRule::GetDescription(
       GetStyleGuideCitation(kTopic), ".");
 }
 
+std::vector<verible::SymbolTag> V2001GenerateBeginRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kGenerateRegion)};
+}
+
 void V2001GenerateBeginRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -51,14 +53,16 @@ class V2001GenerateBeginRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
   verible::LintRuleStatus Report() const override;
 
  private:
-  const verible::matcher::Matcher matcher_ =
-      NodekGenerateRegion(HasGenerateBlock().Bind("block"));
+  const verible::matcher::CompiledMatcher matcher_{
+      NodekGenerateRegion(HasGenerateBlock().Bind("block"))};
 
   // Link to style guide rule.
   static const char kTopic[];
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -60,6 +61,10 @@ const std::set<std::string>& VoidCastRule::BlacklistedFunctionsSet() {
   return *blacklisted_functions;
 }
 
+std::vector<verible::SymbolTag> VoidCastRule::HandledTags() const {
+  return {verible::NodeTag(NodeEnum::kVoidcast)};
+}
+
 void VoidCastRule::HandleSymbol(const verible::Symbol& symbol,
                                 const SyntaxTreeContext& context) {
   // Check for blacklisted function names
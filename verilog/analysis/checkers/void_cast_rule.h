@@ -17,8 +17,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "common/analysis/lint_rule_status.h"
+#include "common/analysis/matcher/compiled_matcher.h"
 #include "common/analysis/matcher/core_matchers.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
@@ -43,6 +45,8 @@ class VoidCastRule : public verible::SyntaxTreeLintRule {
   // helper flag or markdown depending on the parameter type.
   static std::string GetDescription(DescriptionType);
 
+  std::vector<verible::SymbolTag> HandledTags() const override;
+
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
@@ -55,7 +59,7 @@ class VoidCastRule : public verible::SyntaxTreeLintRule {
   // Link to style guide rule.
   static const char kTopic[];
 
-  using Matcher = verible::matcher::Matcher;
+  using CompiledMatcher = verible::matcher::CompiledMatcher;
 
   static const std::set<std::string>& BlacklistedFunctionsSet();
 
@@ -63,9 +67,9 @@ class VoidCastRule : public verible::SyntaxTreeLintRule {
   // For example:
   //   void'(foo());
   // Here, the leaf representing "foo" will be bound to id
-  const Matcher blacklisted_function_matcher_ =
+  const CompiledMatcher blacklisted_function_matcher_{
       NodekVoidcast(VoidcastHasExpression(
-          ExpressionHasFunctionCall(FunctionCallHasId().Bind("id"))));
+          ExpressionHasFunctionCall(FunctionCallHasId().Bind("id"))))};
 
   // Matches against both calls to randomize and randomize methods within
   // voidcasts.
@@ -77,9 +81,9 @@ class VoidCastRule : public verible::SyntaxTreeLintRule {
   //   void'(randomize(obj));
   // Here, the node representing "randomize(obj)" will be bound to "id"
   //
-  const Matcher randomize_matcher_ = NodekVoidcast(VoidcastHasExpression(
+  const CompiledMatcher randomize_matcher_{NodekVoidcast(VoidcastHasExpression(
       verible::matcher::AnyOf(ExpressionHasRandomizeCallExtension().Bind("id"),
-                              ExpressionHasRandomizeFunction().Bind("id"))));
+                              ExpressionHasRandomizeFunction().Bind("id"))))};
 
   std::set<verible::LintViolation> violations_;
 };
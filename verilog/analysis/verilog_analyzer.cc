@@ -30,19 +30,25 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/file_analyzer.h"
+#include "common/lexer/token_generator.h"
 #include "common/lexer/token_stream_adapter.h"
 #include "common/strings/comment_utils.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
+#include "common/text/tree_utils.h"
 #include "common/text/visitors.h"
+#include "common/util/casts.h"
 #include "common/util/container_util.h"
 #include "common/util/logging.h"
+#include "common/util/range.h"
 #include "common/util/status.h"
 #include "common/util/status_macros.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/verilog_excerpt_parse.h"
 #include "verilog/parser/verilog_lexer.h"
 #include "verilog/parser/verilog_lexical_context.h"
@@ -61,6 +67,7 @@ const char VerilogAnalyzer::kParseDirectiveName[] = "verilog_syntax:";
 
 verible::util::Status VerilogAnalyzer::Tokenize() {
   if (!tokenized_) {
+    const auto phase = stats_.Measure("lex");
     VerilogLexer lexer{Data().Contents()};
     tokenized_ = true;
     lex_status_ = FileAnalyzer::Tokenize(&lexer);
@@ -127,8 +134,15 @@ static const absl::string_view FailingTokenKeywordToParsingMode(
 
 std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
     absl::string_view text, absl::string_view name) {
+  return AnalyzeAutomaticMode(
+      std::make_shared<verible::StringMemBlock>(std::string(text)), name);
+}
+
+std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
+    std::shared_ptr<verible::MemBlock> text_block, absl::string_view name) {
   VLOG(2) << __FUNCTION__;
-  auto analyzer = absl::make_unique<VerilogAnalyzer>(text, name);
+  auto analyzer = absl::make_unique<VerilogAnalyzer>(std::move(text_block),
+                                                     name);
   if (analyzer == nullptr) return analyzer;
   const absl::string_view text_base = analyzer->Data().Contents();
   // If there is any lexical error, stop right away.
@@ -138,11 +152,16 @@ std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
       ScanParsingModeDirective(analyzer->Data().TokenStream());
   if (!parse_mode.empty()) {
     // Invoke alternate parser, and use its results.
-    // Slightly inefficient to lex text all over again, but this is
-    // acceptable for an exceptional code path.
     VLOG(1) << "Analyzing using parse mode directive: " << parse_mode;
-    auto mode_analyzer = AnalyzeVerilogWithMode(text, name, parse_mode);
-    if (mode_analyzer != nullptr) return mode_analyzer;
+    std::unique_ptr<VerilogAnalyzer> mode_analyzer;
+    {
+      const auto phase = analyzer->stats_.Measure("directive-reanalysis");
+      mode_analyzer = analyzer->ReanalyzeWithMode(parse_mode);
+    }
+    if (mode_analyzer != nullptr) {
+      mode_analyzer->InheritStats(*analyzer, "directive-reanalysis/");
+      return mode_analyzer;
+    }
     // Silently ignore any unknown parsing modes.
   }
 
@@ -162,8 +181,12 @@ std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
               yytokentype(first_reject.token_info.token_enum));
       VLOG(1) << "Retrying parsing in mode: " << retry_parse_mode;
       if (!retry_parse_mode.empty()) {
-        auto retry_analyzer =
-            AnalyzeVerilogWithMode(text, name, retry_parse_mode);
+        std::unique_ptr<VerilogAnalyzer> retry_analyzer;
+        {
+          const auto phase = analyzer->stats_.Measure("retry-reanalysis");
+          retry_analyzer = analyzer->ReanalyzeWithMode(retry_parse_mode);
+        }
+        retry_analyzer->InheritStats(*analyzer, "retry-reanalysis/");
         const absl::string_view retry_text_base =
             retry_analyzer->Data().Contents();
         VLOG(1) << "Retrying to parse:\n" << retry_text_base;
@@ -178,9 +201,9 @@ std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
         if (!retry_rejected_tokens.empty()) {
           VLOG(1) << "Retrying parsing found at least one error.";
           const auto& first_retry_reject = retry_rejected_tokens.front();
-          const int retry_error_offset = first_retry_reject.token_info.left(
-              retry_analyzer->Data().Contents());
-          // When comparing failure location, compensate position for prolog.
+          // Both analyzers share the same text.
+          const int retry_error_offset =
+              first_retry_reject.token_info.left(text_base);
           const int original_error_offset =
               first_reject.token_info.left(text_base);
           if (retry_error_offset > original_error_offset) {
@@ -197,13 +220,253 @@ std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeAutomaticMode(
   return analyzer;
 }
 
+// Returns the top-level declaration of 'tree' that surrounds the text of an
+// edit of [left_offset, right_offset) of 'text', such that neither its first
+// nor last byte is edited.  Returns nullptr if there is no such declaration.
+static verible::SymbolPtr* FindEnclosingTopLevelDeclaration(
+    verible::ConcreteSyntaxTree* tree, absl::string_view text,
+    size_t left_offset, size_t right_offset) {
+  if (*tree == nullptr || (*tree)->Kind() != verible::SymbolKind::kNode) {
+    return nullptr;
+  }
+  auto& root = verible::down_cast<verible::SyntaxTreeNode&>(**tree);
+  if (root.Tag().tag != static_cast<int>(NodeEnum::kDescriptionList)) {
+    return nullptr;
+  }
+  for (auto& child : root.mutable_children()) {
+    if (child == nullptr) continue;
+    const absl::string_view span = verible::StringSpanOfSymbol(*child);
+    if (span.empty()) continue;
+    const size_t span_left = std::distance(text.begin(), span.begin());
+    const size_t span_right = span_left + span.length();
+    if (span_right <= left_offset) continue;
+    if (span_left >= left_offset || span_right <= right_offset) {
+      return nullptr;  // The edit touches this declaration's boundary.
+    }
+    switch (static_cast<NodeEnum>(child->Tag().tag)) {
+      case NodeEnum::kModuleDeclaration:
+      case NodeEnum::kInterfaceDeclaration:
+      case NodeEnum::kProgramDeclaration:
+      case NodeEnum::kPackageDeclaration:
+      case NodeEnum::kClassDeclaration:
+        return &child;
+      default:
+        return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeIncrementally(
+    std::unique_ptr<VerilogAnalyzer> previous,
+    std::shared_ptr<verible::MemBlock> new_text, size_t offset,
+    size_t removed_length) {
+  const absl::string_view old_text = previous->Data().Contents();
+  const absl::string_view text = new_text->AsStringView();
+  CHECK_LE(offset + removed_length, old_text.length());
+  CHECK_GE(text.length() + removed_length, old_text.length());
+  const int delta = static_cast<int>(text.length()) -
+                    static_cast<int>(old_text.length());
+
+  // Only results of a plain analysis of a whole text, without errors, can be
+  // taken apart.  Parsing modes other than the default one parse the whole
+  // text differently.
+  verible::SymbolPtr* declaration = nullptr;
+  if (previous->LexStatus().ok() && previous->ParseStatus().ok() &&
+      previous->prolog_tokens_.empty() && previous->epilog_tokens_.empty() &&
+      old_text.begin() == previous->owned_contents_->AsStringView().begin() &&
+      old_text.length() == previous->owned_contents_->AsStringView().length()) {
+    declaration = FindEnclosingTopLevelDeclaration(
+        &previous->MutableData().MutableSyntaxTree(), old_text, offset,
+        offset + removed_length);
+  }
+  if (declaration == nullptr) {
+    return AnalyzeAutomaticMode(std::move(new_text), previous->filename_);
+  }
+
+  // Lex and parse the edited declaration on its own, in place.
+  // Its first and last bytes are unchanged, so the lexer is in its initial
+  // state at both ends, like when lexing the whole text.
+  const absl::string_view old_span = verible::StringSpanOfSymbol(**declaration);
+  const int left_offset = std::distance(old_text.begin(), old_span.begin());
+  const int right_offset = left_offset + old_span.length();
+  const absl::string_view new_span =
+      text.substr(left_offset, right_offset + delta - left_offset);
+  std::unique_ptr<VerilogAnalyzer> subanalyzer(
+      new VerilogAnalyzer(new_text, new_span, previous->filename_));
+  subanalyzer->Analyze();
+  // The edited text must still be exactly one declaration, whose tokens
+  // span all of the text, so that no tokens could merge across its ends.
+  verible::ConcreteSyntaxTree& subtree =
+      subanalyzer->MutableData().MutableSyntaxTree();
+  const verible::SyntaxTreeNode* subroot =
+      subtree != nullptr && subtree->Kind() == verible::SymbolKind::kNode
+          ? &verible::down_cast<const verible::SyntaxTreeNode&>(*subtree)
+          : nullptr;
+  if (!subanalyzer->LexStatus().ok() || !subanalyzer->ParseStatus().ok() ||
+      subroot == nullptr ||
+      subroot->Tag().tag != static_cast<int>(NodeEnum::kDescriptionList) ||
+      subroot->children().size() != 1 ||
+      subroot->children().front() == nullptr ||
+      !verible::BoundsEqual(
+          verible::StringSpanOfSymbol(*subroot->children().front()),
+          new_span)) {
+    return AnalyzeAutomaticMode(std::move(new_text), previous->filename_);
+  }
+  subtree = std::move(
+      verible::down_cast<verible::SyntaxTreeNode&>(*subtree)
+          .mutable_children()
+          .front());
+
+  // Reuse everything else.
+  previous->stats_ = subanalyzer->Stats();
+  const auto phase = previous->stats_.Measure("splice");
+  previous->max_used_stack_size_ = std::max(
+      previous->max_used_stack_size_, subanalyzer->max_used_stack_size_);
+  verible::TextStructureView::DeferredExpansion edit{declaration,
+                                                     std::move(subanalyzer)};
+  previous->SpliceEditedSubtree(std::move(new_text), left_offset,
+                                right_offset, &edit);
+  // Macro definitions may have changed, but the tokens passed through
+  // the preprocessor unchanged, so there is no need to redo the view.
+  VerilogPreprocess preprocessor;
+  previous->preprocessor_data_ =
+      preprocessor.ScanStream(previous->Data().GetTokenStreamView());
+  if (!previous->preprocessor_data_.errors.empty()) {
+    // e.g. a conditional directive now pairs up with one outside of the edit.
+    return AnalyzeAutomaticMode(previous->owned_contents_,
+                                previous->filename_);
+  }
+  return previous;
+}
+
+void VerilogAnalyzer::InheritStats(const VerilogAnalyzer& original,
+                                   absl::string_view prefix) {
+  verible::PhaseStats stats(original.stats_);
+  stats.Append(stats_, prefix);
+  stats_ = std::move(stats);
+}
+
+// Lexes 'text' into the tokens that the parser would see.
+static TokenSequence LexSyntaxTreeTokens(absl::string_view text) {
+  VerilogLexer lexer(text);
+  TokenSequence tokens;
+  for (TokenInfo token = lexer.DoNextToken(); !token.isEOF();
+       token = lexer.DoNextToken()) {
+    if (VerilogLexer::KeepSyntaxTreeTokens(token)) tokens.push_back(token);
+  }
+  return tokens;
+}
+
+std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::ReanalyzeWithMode(
+    absl::string_view mode) const {
+  const VerilogExcerptWrapper* wrapper = FindVerilogExcerptWrapper(mode);
+  if (wrapper == nullptr) return nullptr;
+  std::unique_ptr<VerilogAnalyzer> analyzer(
+      new VerilogAnalyzer(owned_contents_, Data().Contents(), filename_));
+  // The prolog and epilog tokens point into the wrapper's (static) text.
+  analyzer->prolog_tokens_ = LexSyntaxTreeTokens(wrapper->prolog);
+  analyzer->epilog_tokens_ = LexSyntaxTreeTokens(wrapper->epilog);
+
+  // Reuse this analyzer's tokens, but not their context-based
+  // interpretation, which could differ inside the wrapper.
+  verible::TextStructureView& data = analyzer->MutableData();
+  TokenSequence& tokens = data.MutableTokenStream();
+  tokens = Data().TokenStream();
+  for (auto& token : tokens) {
+    token.token_enum = LexicalContext::LexedTokenEnum(token.token_enum);
+  }
+  data.CalculateFirstTokensPerLine();
+  verible::InitTokenStreamView(tokens, &data.MutableTokenStreamView());
+  analyzer->tokenized_ = true;
+  analyzer->lex_status_ = lex_status_;
+
+  analyzer->Analyze();  // Let caller check analyzer's status.
+  return analyzer;
+}
+
 void VerilogAnalyzer::FilterTokensForSyntaxTree() {
   data_.FilterTokens(&VerilogLexer::KeepSyntaxTreeTokens);
 }
 
 void VerilogAnalyzer::ContextualizeTokens() {
   LexicalContext context;
-  context.TransformVerilogSymbols(data_.MakeTokenStreamReferenceView());
+  if (prolog_tokens_.empty() && epilog_tokens_.empty()) {
+    context.TransformVerilogSymbols(data_.MakeTokenStreamReferenceView());
+    return;
+  }
+  // Interpret tokens in the context established by the prolog.
+  verible::TokenStreamReferenceView tokens_view;
+  for (auto iter = prolog_tokens_.begin(); iter != prolog_tokens_.end();
+       ++iter) {
+    tokens_view.push_back(iter);
+  }
+  const auto data_view = data_.MakeTokenStreamReferenceView();
+  tokens_view.insert(tokens_view.end(), data_view.begin(), data_view.end());
+  for (auto iter = epilog_tokens_.begin(); iter != epilog_tokens_.end();
+       ++iter) {
+    tokens_view.push_back(iter);
+  }
+  context.TransformVerilogSymbols(tokens_view);
+}
+
+// Returns a generator that yields 'prolog', the tokens of 'generator' up to
+// its EOF token, 'epilog', and then the EOF token.
+static verible::TokenGenerator WrapTokens(const TokenSequence& prolog,
+                                          verible::TokenGenerator generator,
+                                          const TokenSequence& epilog) {
+  auto prolog_iter = prolog.begin();
+  auto epilog_iter = epilog.begin();
+  TokenInfo eof_token(TokenInfo::EOFToken());
+  bool generator_done = false;
+  return [=, &prolog, &epilog]() mutable {
+    if (prolog_iter != prolog.end()) return *prolog_iter++;
+    if (!generator_done) {
+      const TokenInfo token(generator());
+      if (!token.isEOF()) return token;
+      eof_token = token;
+      generator_done = true;
+    }
+    if (epilog_iter != epilog.end()) return *epilog_iter++;
+    return eof_token;
+  };
+}
+
+// Replaces 'tree' with its largest subtree whose leaves lie inside 'text',
+// discarding any leading and trailing leaves from outside of 'text'.
+// This is like verible::TrimSyntaxTree(), but does not depend on the
+// relative memory locations of 'text' and the outside leaves.
+static void TrimSyntaxTreeToText(verible::ConcreteSyntaxTree* tree,
+                                 absl::string_view text) {
+  if (*tree == nullptr) return;
+  const auto inside = [text](const verible::SyntaxTreeLeaf* leaf) {
+    return leaf != nullptr && verible::IsSubRange(leaf->get().text, text);
+  };
+  // Find shallowest subtree that starts inside the text.
+  verible::ConcreteSyntaxTree* match = verible::FindFirstSubtreeMutable(
+      tree, [&inside](const verible::Symbol& symbol) {
+        return inside(verible::GetLeftmostLeaf(symbol));
+      });
+  // Take leftmost subtree until it also ends inside the text.
+  while (match != nullptr && *match != nullptr &&
+         !inside(verible::GetRightmostLeaf(**match))) {
+    if ((*match)->Kind() == verible::SymbolKind::kLeaf) {
+      match = nullptr;
+      break;
+    }
+    auto& node = verible::down_cast<verible::SyntaxTreeNode&>(**match);
+    auto& children = node.mutable_children();
+    const auto first_child = std::find_if(
+        children.begin(), children.end(),
+        [](const verible::SymbolPtr& child) { return child != nullptr; });
+    match = first_child == children.end() ? nullptr : &*first_child;
+  }
+  if (match == tree) return;
+  if (match == nullptr || *match == nullptr) {
+    *tree = nullptr;
+  } else {
+    *tree = std::move(*match);
+  }
 }
 
 // Analyzes Verilog code: lexer, filter, parser.
@@ -214,15 +477,22 @@ verible::util::Status VerilogAnalyzer::Analyze() {
   RETURN_IF_ERROR(Tokenize());
 
   // Here would be one place to analyze the raw token stream.
-  FilterTokensForSyntaxTree();
+  {
+    const auto phase = stats_.Measure("filter");
+    FilterTokensForSyntaxTree();
+  }
 
   // Disambiguate tokens using lexical context.
-  ContextualizeTokens();
+  {
+    const auto phase = stats_.Measure("contextualize");
+    ContextualizeTokens();
+  }
 
   // pseudo-preprocess token stream.
   // TODO(fangism): preprocessor_.Configure();
   //   Not all analyses will want to preprocess.
   {
+    const auto phase = stats_.Measure("preprocess");
     VerilogPreprocess preprocessor;
     preprocessor_data_ = preprocessor.ScanStream(Data().GetTokenStreamView());
     if (!preprocessor_data_.errors.empty()) {
@@ -240,14 +510,24 @@ verible::util::Status VerilogAnalyzer::Analyze() {
     // TODO(fangism): could we just move, swap, or directly reference?
   }
 
-  auto generator = MakeTokenViewer(Data().GetTokenStreamView());
-  VerilogParser parser(&generator);
-  parse_status_ = FileAnalyzer::Parse(&parser);
-  // Here would be appropriate for analyzing the syntax tree.
-  max_used_stack_size_ = parser.MaxUsedStackSize();
+  {
+    const auto phase = stats_.Measure("parse");
+    auto generator = MakeTokenViewer(Data().GetTokenStreamView());
+    const bool wrapped = !prolog_tokens_.empty() || !epilog_tokens_.empty();
+    if (wrapped) {
+      generator =
+          WrapTokens(prolog_tokens_, std::move(generator), epilog_tokens_);
+    }
+    VerilogParser parser(&generator, /* use_arena= */ true);
+    parse_status_ = FileAnalyzer::Parse(&parser);
+    // Here would be appropriate for analyzing the syntax tree.
+    max_used_stack_size_ = parser.MaxUsedStackSize();
+    if (wrapped) DiscardPrologAndEpilog();
+  }
 
   // Expand macro arguments that are parseable as expressions.
   if (parse_status_.ok() && SyntaxTree() != nullptr) {
+    const auto phase = stats_.Measure("expand-macro-args");
     ExpandMacroCallArgExpressions();
   }
 
@@ -262,81 +542,99 @@ using verible::SyntaxTreeNode;
 using verible::TextStructureView;
 using verible::TokenInfo;
 
-// Helper class to replace macro call argument nodes with expression trees.
-class MacroCallArgExpander : public MutableTreeVisitorRecursive {
+// Collects macro call argument leaves, for expansion as expressions.
+class MacroCallArgCollector : public MutableTreeVisitorRecursive {
  public:
-  explicit MacroCallArgExpander(absl::string_view text) : full_text_(text) {}
-
   void Visit(const SyntaxTreeNode&, SymbolPtr*) override {}
 
   void Visit(const SyntaxTreeLeaf& leaf, SymbolPtr* leaf_owner) override {
-    const TokenInfo& token(leaf.get());
-    if (token.token_enum == MacroArg) {
-      VLOG(3) << "MacroCallArgExpander: examining token: " << token;
-      // Attempt to parse text as an expression.
-      std::unique_ptr<VerilogAnalyzer> expr_analyzer =
-          AnalyzeVerilogExpression(token.text, "<macro-arg-expander>");
-      if (ABSL_DIE_IF_NULL(expr_analyzer)->LexStatus().ok() &&
-          expr_analyzer->ParseStatus().ok()) {
-        VLOG(3) << "  ... is a parse-able expression, saving for expansion.";
-        const auto& token_sequence = expr_analyzer->Data().TokenStream();
-        const verible::TokenInfo::Context token_context{
-            expr_analyzer->Data().Contents(), [](std::ostream& stream, int e) {
-              stream << verilog_symbol_name(e);
-            }};
-        if (VLOG_IS_ON(4)) {
-          LOG(INFO) << "macro call-arg's lexed tokens: ";
-          for (const auto& t : token_sequence) {
-            LOG(INFO) << verible::TokenWithContext{t, token_context};
-          }
-        }
-        CHECK_EQ(token_sequence.back().right(expr_analyzer->Data().Contents()),
-                 token.text.length());
-        // Defer in-place expansion until all expansions have been collected
-        // (for efficiency, avoiding inserting into middle of a vector,
-        // and causing excessive reallocation).
-        TextStructureView::DeferredExpansion& analysis_slot =
-            InsertKeyOrDie(&subtrees_to_splice_, token.left(full_text_));
-        CHECK_EQ(analysis_slot.subanalysis.get(), nullptr)
-            << "Cannot expand the same location twice.  Token: " << token;
-        analysis_slot.expansion_point = leaf_owner;
-        analysis_slot.subanalysis = std::move(expr_analyzer);
-      } else {
-        // Ignore parse failures.
-        VLOG(3) << "Ignoring parse-as-expression failure: " << token;
-      }
+    if (leaf.get().token_enum == MacroArg) {
+      macro_args_.push_back(leaf_owner);
     }
   }
 
-  MacroCallArgExpander(const MacroCallArgExpander&) = delete;
-  MacroCallArgExpander(MacroCallArgExpander&&) = delete;
-  MacroCallArgExpander& operator=(const MacroCallArgExpander&) = delete;
-
-  // Process accumulated DeferredExpansions.
-  void ExpandSubtrees(VerilogAnalyzer* analyzer) {
-    if (!subtrees_to_splice_.empty()) {
-      analyzer->MutableData().ExpandSubtrees(&subtrees_to_splice_);
-    }
-  }
+  // Returns the positions of MacroArg leaves, in tree order.
+  const std::vector<SymbolPtr*>& MacroArgs() const { return macro_args_; }
 
  private:
-  // Deferred set of syntax tree nodes to expand.
-  // Key: location.
-  // Value: substring analysis results.
-  TextStructureView::NodeExpansionMap subtrees_to_splice_;
-
-  // Full text from which tokens were lexed, for calculating byte offsets.
-  absl::string_view full_text_;
+  std::vector<SymbolPtr*> macro_args_;
 };
 
 }  // namespace
 
+void VerilogAnalyzer::DiscardPrologAndEpilog() {
+  const absl::string_view text = Data().Contents();
+  TrimSyntaxTreeToText(&MutableData().MutableSyntaxTree(), text);
+  // The prolog always parses, so a rejected token from outside of the text
+  // comes from the epilog.  Report it at the end of the text.
+  for (auto& rejected_token : rejected_tokens_) {
+    TokenInfo& token = rejected_token.token_info;
+    if (!verible::IsSubRange(token.text, text)) {
+      token = TokenInfo(token.token_enum, text.substr(text.length(), 0));
+    }
+  }
+}
+
+std::unique_ptr<VerilogAnalyzer> VerilogAnalyzer::AnalyzeExpressionInPlace(
+    absl::string_view text) const {
+  std::unique_ptr<VerilogAnalyzer> analyzer(
+      new VerilogAnalyzer(owned_contents_, text, "<macro-arg-expander>"));
+  // Direct the parser to accept only an expression.
+  analyzer->prolog_tokens_.push_back(TokenInfo(ExpressionEntryPoint, ""));
+  analyzer->Analyze();  // Let caller check analyzer's status.
+  return analyzer;
+}
+
 void VerilogAnalyzer::ExpandMacroCallArgExpressions() {
   VLOG(2) << __FUNCTION__;
-  MacroCallArgExpander expander(Data().Contents());
+  MacroCallArgCollector collector;
   ABSL_DIE_IF_NULL(SyntaxTree())
-      ->Accept(&expander, &MutableData().MutableSyntaxTree());
-  expander.ExpandSubtrees(this);
+      ->Accept(&collector, &MutableData().MutableSyntaxTree());
+
+  // Full text from which tokens were lexed, for calculating byte offsets.
+  const absl::string_view full_text = Data().Contents();
+  // Deferred set of syntax tree nodes to expand.
+  // Key: location.
+  // Value: substring analysis results.
+  // Expansions are collected first and spliced in all at once (for
+  // efficiency, avoiding inserting into middle of a vector, and causing
+  // excessive reallocation).
+  TextStructureView::NodeExpansionMap subtrees_to_splice;
+  for (SymbolPtr* leaf_owner : collector.MacroArgs()) {
+    const TokenInfo& token(SymbolCastToLeaf(**leaf_owner).get());
+    VLOG(3) << "ExpandMacroCallArgExpressions: examining token: " << token;
+    // Attempt to parse text as an expression.  Unlike the argument's
+    // enclosing code, it has not been lexed yet.
+    std::unique_ptr<VerilogAnalyzer> expr_analyzer =
+        AnalyzeExpressionInPlace(token.text);
+    if (!expr_analyzer->LexStatus().ok() ||
+        !expr_analyzer->ParseStatus().ok()) {
+      // Ignore parse failures.
+      VLOG(3) << "Ignoring parse-as-expression failure: " << token;
+      continue;
+    }
+    VLOG(3) << "  ... is a parse-able expression, saving for expansion.";
+    const auto& token_sequence = expr_analyzer->Data().TokenStream();
+    if (VLOG_IS_ON(4)) {
+      const verible::TokenInfo::Context token_context{
+          full_text, [](std::ostream& stream, int e) {
+            stream << verilog_symbol_name(e);
+          }};
+      LOG(INFO) << "macro call-arg's lexed tokens: ";
+      for (const auto& t : token_sequence) {
+        LOG(INFO) << verible::TokenWithContext{t, token_context};
+      }
+    }
+    CHECK_EQ(token_sequence.back().right(token.text), token.text.length());
+    TextStructureView::DeferredExpansion& analysis_slot =
+        InsertKeyOrDie(&subtrees_to_splice, token.left(full_text));
+    analysis_slot.expansion_point = leaf_owner;
+    analysis_slot.subanalysis = std::move(expr_analyzer);
+  }
+
+  if (!subtrees_to_splice.empty()) {
+    MutableData().ExpandSubtrees(&subtrees_to_splice);
+  }
   VLOG(2) << "end of " << __FUNCTION__;
 }
 
@@ -19,10 +19,13 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/strings/string_view.h"
 #include "common/analysis/file_analyzer.h"
+#include "common/strings/mem_block.h"
 #include "common/text/token_stream_view.h"
+#include "common/util/phase_stats.h"
 #include "common/util/status.h"
 #include "verilog/preprocessor/verilog_preprocess.h"
 
@@ -37,6 +40,14 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
         max_used_stack_size_(0),
         use_parser_directive_comments_(use_parser_directive_comments) {}
 
+  // Analyzes text owned by 'text' without copying it.
+  VerilogAnalyzer(std::shared_ptr<verible::MemBlock> text,
+                  absl::string_view name,
+                  bool use_parser_directive_comments = true)
+      : verible::FileAnalyzer(std::move(text), name),
+        max_used_stack_size_(0),
+        use_parser_directive_comments_(use_parser_directive_comments) {}
+
   // Lex-es the input text into tokens.
   verible::util::Status Tokenize() override;
 
@@ -60,10 +71,33 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   static std::unique_ptr<VerilogAnalyzer> AnalyzeAutomaticMode(
       absl::string_view text, absl::string_view name);
 
+  // Same as above, but shares ownership of 'text' instead of copying it,
+  // e.g. for memory-mapped files.
+  static std::unique_ptr<VerilogAnalyzer> AnalyzeAutomaticMode(
+      std::shared_ptr<verible::MemBlock> text, absl::string_view name);
+
+  // Analyzes 'new_text', the text of 'previous' after an edit that replaced
+  // 'removed_length' bytes at 'offset' (with any number of bytes), reusing
+  // the results of 'previous', which is consumed.
+  // If the edit lies inside of one top-level module, interface, program,
+  // package or class declaration, only that declaration is lexed and parsed
+  // again, and the rest of the tokens and syntax tree are reused.
+  // Otherwise, or if the declaration no longer parses on its own, this falls
+  // back to AnalyzeAutomaticMode().  Either way, the results are those of
+  // analyzing 'new_text' from scratch.
+  static std::unique_ptr<VerilogAnalyzer> AnalyzeIncrementally(
+      std::unique_ptr<VerilogAnalyzer> previous,
+      std::shared_ptr<verible::MemBlock> new_text, size_t offset,
+      size_t removed_length);
+
   const VerilogPreprocessData& PreprocessorData() const {
     return preprocessor_data_;
   }
 
+  // Returns the time and allocations spent in each phase of analysis,
+  // including those of any re-analysis done by AnalyzeAutomaticMode().
+  const verible::PhaseStats& Stats() const { return stats_; }
+
   // Maybe this belongs in a subclass like VerilogFileAnalyzer?
   // TODO(fangism): Retain a copy of the token stream transformer because it
   // may contain tokens backed by generated text.
@@ -88,6 +122,36 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   // syntax tree.  If parsing fails, leave the MacroArg token unexpanded.
   void ExpandMacroCallArgExpressions();
 
+  // Analyzes 'text', a substring of 'contents', in place.
+  VerilogAnalyzer(std::shared_ptr<verible::MemBlock> contents,
+                  absl::string_view text, absl::string_view name)
+      : verible::FileAnalyzer(std::move(contents), text, name),
+        max_used_stack_size_(0),
+        use_parser_directive_comments_(false) {}
+
+  // Analyzes 'text', a substring of this analyzer's contents (e.g. a macro
+  // call argument), as a single expression.  The returned analyzer shares
+  // this analyzer's memory, so its tokens point into 'text' without copying.
+  std::unique_ptr<VerilogAnalyzer> AnalyzeExpressionInPlace(
+      absl::string_view text) const;
+
+  // Re-analyzes this analyzer's text in the parsing 'mode' (see
+  // AnalyzeVerilogWithMode()), reusing its lexed tokens.  Instead of lexing
+  // the text again with a prolog and an epilog around it, the tokens are
+  // parsed between tokens of the prolog and the epilog.
+  // Returns nullptr if 'mode' is unknown.
+  std::unique_ptr<VerilogAnalyzer> ReanalyzeWithMode(
+      absl::string_view mode) const;
+
+  // Removes the parts of the syntax tree that came from prolog_tokens_ and
+  // epilog_tokens_, and moves rejected tokens from them into the text.
+  void DiscardPrologAndEpilog();
+
+  // Makes this analyzer, which is the result of re-analyzing the text of
+  // 'original', report the phases of 'original', followed by its own under
+  // 'prefix'.
+  void InheritStats(const VerilogAnalyzer& original, absl::string_view prefix);
+
   // Information about parser internals.
 
   // True if input text has already been lexed.
@@ -102,11 +166,20 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   // If true, let comments control the parsing mode.
   bool use_parser_directive_comments_ = true;
 
+  // Synthetic tokens that are parsed before and after the tokens of the text,
+  // e.g. to parse the text as a module body.  Their text lies outside of
+  // the analyzed text, and they are not part of the results.
+  verible::TokenSequence prolog_tokens_;
+  verible::TokenSequence epilog_tokens_;
+
   // Status of lexing.
   verible::util::Status lex_status_;
 
   // Status of parsing.
   verible::util::Status parse_status_;
+
+  // Instrumentation of analysis phases.
+  verible::PhaseStats stats_;
 };
 
 // Returns true if both token sequences are equivalent, ignoring whitespace.
@@ -25,9 +25,11 @@
 #include "absl/base/casts.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "common/analysis/file_analyzer.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/constants.h"
@@ -36,6 +38,7 @@
 #include "common/text/token_info.h"
 #include "common/text/token_info_test_util.h"
 #include "common/text/token_stream_view.h"
+#include "common/text/tree_compare.h"
 #include "common/text/tree_utils.h"
 #include "common/util/casts.h"
 #include "common/util/logging.h"
@@ -328,6 +331,17 @@ TEST(AnalyzeVerilogAutomaticMode, NormalModeModule) {
   EXPECT_OK(ABSL_DIE_IF_NULL(analyzer_ptr)->ParseStatus());
 }
 
+TEST(AnalyzeVerilogAutomaticMode, NormalModeModuleSharedMemBlock) {
+  const auto text =
+      std::make_shared<verible::StringMemBlock>("module rrr;\nendmodule\n");
+  std::unique_ptr<VerilogAnalyzer> analyzer_ptr =
+      VerilogAnalyzer::AnalyzeAutomaticMode(text, "<file>");
+  EXPECT_OK(ABSL_DIE_IF_NULL(analyzer_ptr)->ParseStatus());
+  // Analyzer works directly on the shared memory, without copying.
+  EXPECT_EQ(analyzer_ptr->Data().Contents().data(),
+            text->AsStringView().data());
+}
+
 TEST(AnalyzeVerilogAutomaticMode, NormalModeModuleInvalidSelection) {
   std::unique_ptr<VerilogAnalyzer> analyzer_ptr =
       VerilogAnalyzer::AnalyzeAutomaticMode(
@@ -506,6 +520,20 @@ TEST(VerilogAnalyzerExpandsMacroArgsTest, NonExprArg) {
   EXPECT_TRUE(TreeContainsToken(tree, search_tokens[0]));
 }
 
+// Test that a macro arg that starts with an expression, but does not end with
+// it, doesn't expand.
+TEST(VerilogAnalyzerExpandsMacroArgsTest, ExprFollowedByStatementArg) {
+  const TokenInfoTestData test = {"`FOOBAR(", {MacroArg, "a; wire b"}, ")\n"};
+  const auto analyzer =
+      absl::make_unique<VerilogAnalyzer>(test.code, "<<inline>>");
+  EXPECT_OK(analyzer->Analyze());
+  const ConcreteSyntaxTree& tree = analyzer->SyntaxTree();
+  const auto search_tokens =
+      test.FindImportantTokens(analyzer->Data().Contents());
+  ASSERT_EQ(search_tokens.size(), 1);
+  EXPECT_TRUE(TreeContainsToken(tree, search_tokens[0]));
+}
+
 // Test that an integer expression macro arg expands properly.
 TEST(VerilogAnalyzerExpandsMacroArgsTest, IntegerArg) {
   const TokenInfoTestData test = {"`FOO(", {TK_DecNumber, "123"}, ")\n"};
@@ -921,5 +949,110 @@ TEST(LexicallyEquivalentTest, DiagnosticMismatch) {
   }
 }
 
+// Returns true if 'analyzer' was produced by splicing rather than by
+// analyzing the whole text again.
+bool WasSpliced(const VerilogAnalyzer& analyzer) {
+  for (const auto& phase : analyzer.Stats().Phases()) {
+    if (phase.name == "splice") return true;
+  }
+  return false;
+}
+
+struct IncrementalEditTestCase {
+  absl::string_view before;
+  size_t offset;
+  size_t removed_length;
+  absl::string_view inserted;
+  bool expect_spliced;
+};
+
+TEST(AnalyzeIncrementallyTest, SameAsFullAnalysis) {
+  const IncrementalEditTestCase kTestCases[] = {
+      // Edits inside of one declaration are re-analyzed alone.
+      {"module m;\nendmodule\nmodule n;\nendmodule\n", 9, 0, "\n  wire w;",
+       true},
+      {"module m;\n  wire w;\nendmodule\nmodule n;\nendmodule\n", 12, 7,
+       "reg [3:0] rr;", true},
+      {"package p;\nendpackage\nmodule n;\n  wire w;\nendmodule\n", 39, 1,
+       "ww", true},
+      {"class c;\nendclass\n\nmodule n;\nendmodule\n", 7, 0, " extends d",
+       true},
+      // Edits that touch the ends of declarations fall back to full analysis.
+      {"module m;\nendmodule\nmodule n;\nendmodule\n", 0, 6, "package", false},
+      {"module m;\nendmodule\nmodule n;\nendmodule\n", 19, 0, "\n", false},
+      {"module m;\nendmodule\nmodule n;\nendmodule\n", 18, 2, "\n", false},
+      // Edits that split a declaration fall back to full analysis.
+      {"module m;\nendmodule\n", 9, 0, " endmodule module mm;", false},
+      // Edits that no longer parse fall back to full analysis.
+      {"module m;\nendmodule\n", 9, 0, " wire;", false},
+      {"module m;\nendmodule\n", 9, 0, " /* ", false},
+  };
+  for (const auto& test : kTestCases) {
+    const std::string after =
+        absl::StrCat(test.before.substr(0, test.offset), test.inserted,
+                     test.before.substr(test.offset + test.removed_length));
+    auto previous = VerilogAnalyzer::AnalyzeAutomaticMode(
+        std::make_shared<verible::StringMemBlock>(std::string(test.before)),
+        "<file>");
+    ASSERT_OK(previous->ParseStatus()) << test.before;
+    const auto new_text = std::make_shared<verible::StringMemBlock>(after);
+    const auto incremental = VerilogAnalyzer::AnalyzeIncrementally(
+        std::move(previous), new_text, test.offset, test.removed_length);
+    const auto full = VerilogAnalyzer::AnalyzeAutomaticMode(after, "<file>");
+
+    EXPECT_EQ(WasSpliced(*incremental), test.expect_spliced) << after;
+    EXPECT_EQ(incremental->ParseStatus().ok(), full->ParseStatus().ok())
+        << after;
+    EXPECT_EQ(incremental->Data().Contents().data(),
+              new_text->AsStringView().data());
+    EXPECT_OK(incremental->Data().InternalConsistencyCheck());
+    const auto& tokens = incremental->Data().TokenStream();
+    const auto& expected_tokens = full->Data().TokenStream();
+    ASSERT_EQ(tokens.size(), expected_tokens.size()) << after;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      EXPECT_TRUE(verible::EqualByEnumString(tokens[i], expected_tokens[i]))
+          << after << "\ntoken [" << i << "]: " << tokens[i];
+      EXPECT_EQ(tokens[i].left(incremental->Data().Contents()),
+                expected_tokens[i].left(full->Data().Contents()));
+    }
+    EXPECT_EQ(incremental->Data().GetTokenStreamView().size(),
+              full->Data().GetTokenStreamView().size());
+    EXPECT_TRUE(verible::EqualTreesByEnumString(
+        incremental->SyntaxTree().get(), full->SyntaxTree().get()))
+        << after;
+  }
+}
+
+TEST(AnalyzeIncrementallyTest, RepeatedEdits) {
+  std::string text = "module m;\nendmodule\n\nmodule n;\nendmodule\n";
+  auto analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(
+      std::make_shared<verible::StringMemBlock>(text), "<file>");
+  for (int i = 0; i < 3; ++i) {
+    const size_t offset = text.find("n;") + 2;
+    text.insert(offset, "\n  wire w;");
+    analyzer = VerilogAnalyzer::AnalyzeIncrementally(
+        std::move(analyzer), std::make_shared<verible::StringMemBlock>(text),
+        offset, 0);
+    EXPECT_TRUE(WasSpliced(*analyzer));
+    EXPECT_OK(analyzer->ParseStatus());
+  }
+  const auto full = VerilogAnalyzer::AnalyzeAutomaticMode(text, "<file>");
+  EXPECT_TRUE(verible::EqualTreesByEnumString(analyzer->SyntaxTree().get(),
+                                              full->SyntaxTree().get()));
+}
+
+TEST(AnalyzeIncrementallyTest, PreviousErrorsFallBack) {
+  auto previous = VerilogAnalyzer::AnalyzeAutomaticMode(
+      std::make_shared<verible::StringMemBlock>("module m;\nendmodule\n("),
+      "<file>");
+  ASSERT_FALSE(previous->ParseStatus().ok());
+  const auto analyzer = VerilogAnalyzer::AnalyzeIncrementally(
+      std::move(previous),
+      std::make_shared<verible::StringMemBlock>("module m;\nendmodule\n"), 20,
+      1);
+  EXPECT_FALSE(WasSpliced(*analyzer));
+  EXPECT_OK(analyzer->ParseStatus());
+}
+
 }  // namespace
 }  // namespace verilog
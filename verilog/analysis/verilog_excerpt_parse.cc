@@ -14,7 +14,6 @@
 
 #include "verilog/analysis/verilog_excerpt_parse.h"
 
-#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -23,6 +22,7 @@
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "common/strings/mem_block.h"
 #include "common/text/text_structure.h"
 #include "common/util/container_util.h"
 #include "common/util/logging.h"
@@ -45,15 +45,18 @@ static std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogConstruct(
   CHECK(epilog.empty() || absl::ascii_isspace(epilog[0]))
       << "epilog text must begin with a whitespace to prevent unintentional "
          "token-joining and escaped-identifier extension.";
-  const std::string analyze_text = absl::StrCat(prolog, text, epilog);
+  // The analyzer takes ownership of the concatenated text without copying.
+  auto analyze_text = std::make_shared<verible::StringMemBlock>(
+      absl::StrCat(prolog, text, epilog));
   // Disable parser directive comments because a specific parser
   // is already being selected.
   auto analyzer_ptr = absl::make_unique<VerilogAnalyzer>(
-      analyze_text, std::string(filename),
+      analyze_text, filename,
       /* use_parser_directive_comments_ */ false);
 
   if (!ABSL_DIE_IF_NULL(analyzer_ptr)->Analyze().ok()) {
-    VLOG(2) << __FUNCTION__ << ": Analyze() failed.  code:\n" << analyze_text;
+    VLOG(2) << __FUNCTION__ << ": Analyze() failed.  code:\n"
+            << analyze_text->AsStringView();
     // Continue to processes, even if there's an error, so that token
     // string_views can be properly rebased.
     // There may or may not be a formed syntax tree.
@@ -69,56 +72,77 @@ static std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogConstruct(
   return analyzer_ptr;  // Let caller check analyzer_ptr's status.
 }
 
+static std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogConstruct(
+    const VerilogExcerptWrapper& wrapper, absl::string_view text,
+    absl::string_view filename) {
+  return AnalyzeVerilogConstruct(wrapper.prolog, text, wrapper.epilog,
+                                 filename);
+}
+
+static constexpr VerilogExcerptWrapper kStatementsWrapper{
+    "function foo();\n", "\nendfunction\n"};
+
+// $error in this context is an elaboration system task
+// The space before the ) is critical to accommodate escaped identifiers.
+// Without the space, lexing an escaped identifier would consume part
+// of the epilog text.
+static constexpr VerilogExcerptWrapper kExpressionWrapper{
+    "module foo;\nif (", " ) $error;\nendmodule\n"};
+
+static constexpr VerilogExcerptWrapper kModuleBodyWrapper{"module foo;\n",
+                                                          "\nendmodule\n"};
+
+static constexpr VerilogExcerptWrapper kClassBodyWrapper{"class foo;\n",
+                                                         "\nendclass\n"};
+
+static constexpr VerilogExcerptWrapper kPackageBodyWrapper{"package foo;\n",
+                                                           "\nendpackage\n"};
+
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogStatements(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("function foo();\n", text, "\nendfunction\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kStatementsWrapper, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogExpression(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("module foo;\nif (", text,
-                                 " ) $error;\nendmodule\n", filename);
-  // $error in this context is an elaboration system task
-  // The space before the ) is critical to accommodate escaped identifiers.
-  // Without the space, lexing an escaped identifier would consume part
-  // of the epilog text.
+  return AnalyzeVerilogConstruct(kExpressionWrapper, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogModuleBody(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("module foo;\n", text, "\nendmodule\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kModuleBodyWrapper, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogClassBody(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("class foo;\n", text, "\nendclass\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kClassBodyWrapper, text, filename);
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogPackageBody(
     absl::string_view text, absl::string_view filename) {
-  return AnalyzeVerilogConstruct("package foo;\n", text, "\nendpackage\n",
-                                 filename);
+  return AnalyzeVerilogConstruct(kPackageBodyWrapper, text, filename);
+}
+
+const VerilogExcerptWrapper* FindVerilogExcerptWrapper(absl::string_view mode) {
+  static const auto* wrapper_map =
+      new std::map<absl::string_view, const VerilogExcerptWrapper*>{
+          {"parse-as-statements", &kStatementsWrapper},
+          {"parse-as-expression", &kExpressionWrapper},
+          {"parse-as-module-body", &kModuleBodyWrapper},
+          {"parse-as-class-body", &kClassBodyWrapper},
+          {"parse-as-package-body", &kPackageBodyWrapper},
+      };
+  const auto* wrapper_ptr = FindOrNull(*wrapper_map, mode);
+  if (wrapper_ptr == nullptr) return nullptr;
+  return *wrapper_ptr;
 }
 
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogWithMode(
     absl::string_view text, absl::string_view filename,
     absl::string_view mode) {
-  static const auto* func_map =
-      new std::map<absl::string_view,
-                   std::function<std::unique_ptr<VerilogAnalyzer>(
-                       absl::string_view, absl::string_view)>>{
-          {"parse-as-statements", &AnalyzeVerilogStatements},
-          {"parse-as-expression", &AnalyzeVerilogExpression},
-          {"parse-as-module-body", &AnalyzeVerilogModuleBody},
-          {"parse-as-class-body", &AnalyzeVerilogClassBody},
-          {"parse-as-package-body", &AnalyzeVerilogPackageBody},
-      };
-  auto func_ptr = FindOrNull(*func_map, mode);
-  if (func_ptr == nullptr) return nullptr;
-  return (*func_ptr)(text, filename);
+  const VerilogExcerptWrapper* wrapper = FindVerilogExcerptWrapper(mode);
+  if (wrapper == nullptr) return nullptr;
+  return AnalyzeVerilogConstruct(*wrapper, text, filename);
 }
 
 }  // namespace verilog
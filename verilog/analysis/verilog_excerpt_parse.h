@@ -56,6 +56,17 @@ std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogPackageBody(
 std::unique_ptr<VerilogAnalyzer> AnalyzeVerilogWithMode(
     absl::string_view text, absl::string_view filename, absl::string_view mode);
 
+// Text that is wrapped around an excerpt of code to form a whole Verilog
+// source, to analyze the excerpt in one of the parsing modes.
+struct VerilogExcerptWrapper {
+  absl::string_view prolog;
+  absl::string_view epilog;
+};
+
+// Returns the wrapper used by AnalyzeVerilogWithMode() for 'mode', or nullptr
+// if 'mode' is unknown.
+const VerilogExcerptWrapper* FindVerilogExcerptWrapper(absl::string_view mode);
+
 }  // namespace verilog
 
 #endif  // VERIBLE_VERILOG_ANALYSIS_VERILOG_EXCERPT_PARSE_H_
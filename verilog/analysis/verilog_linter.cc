@@ -14,7 +14,9 @@
 
 #include "verilog/analysis/verilog_linter.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <memory>
@@ -36,13 +38,16 @@
 #include "common/analysis/text_structure_linter.h"
 #include "common/analysis/token_stream_lint_rule.h"
 #include "common/analysis/token_stream_linter.h"
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/line_column_map.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 #include "common/util/file_util.h"
 #include "common/util/logging.h"
+#include "common/util/phase_stats.h"
 #include "common/util/status.h"
+#include "common/util/thread_pool.h"
 #include "verilog/analysis/default_rules.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/analysis/verilog_analyzer.h"
@@ -53,6 +58,10 @@
 ABSL_FLAG(verilog::RuleBundle, rules, {}, "List of lint rules to enable");
 ABSL_FLAG(verilog::RuleSet, ruleset, verilog::RuleSet::kDefault,
           "[default|all|none], the base set of rules used by linter");
+ABSL_FLAG(int, lint_threads, 1,
+          "Number of threads over which to spread the lint rules of each "
+          "file.  0 means one per hardware thread.  Useful for very large "
+          "files; findings are the same for any value.");
 
 namespace verilog {
 
@@ -64,13 +73,25 @@ using verible::TokenInfo;
 
 int LintOneFile(std::ostream* stream, absl::string_view filename,
                 const LinterConfiguration& config, bool parse_fatal,
-                bool lint_fatal) {
-  std::string content;
-  if (!verible::file::GetContents(filename, &content)) return 2;
+                bool lint_fatal, verible::PhaseStats* stats) {
+  std::shared_ptr<verible::MemBlock> content =
+      verible::file::GetContentAsMemBlock(filename);
+  if (content == nullptr) return 2;
+  return LintOneFile(stream, filename, std::move(content), config, parse_fatal,
+                     lint_fatal, stats);
+}
+
+int LintOneFile(std::ostream* stream, absl::string_view filename,
+                std::shared_ptr<verible::MemBlock> content,
+                const LinterConfiguration& config, bool parse_fatal,
+                bool lint_fatal, verible::PhaseStats* stats) {
 
   // Lex and parse the contents of the file.
   const auto analyzer =
-      VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
+      VerilogAnalyzer::AnalyzeAutomaticMode(std::move(content), filename);
+  verible::PhaseStats local_stats;
+  if (stats == nullptr) stats = &local_stats;
+  *stats = ABSL_DIE_IF_NULL(analyzer)->Stats();
   const auto lex_status = ABSL_DIE_IF_NULL(analyzer)->LexStatus();
   const auto parse_status = analyzer->ParseStatus();
   if (!lex_status.ok() || !parse_status.ok()) {
@@ -88,8 +109,13 @@ int LintOneFile(std::ostream* stream, absl::string_view filename,
 
   // Analyze the parsed structure for lint violations.
   std::ostringstream lint_stream;
-  const verible::util::Status lint_status = VerilogLintTextStructure(
-      &lint_stream, std::string(filename), content, config, analyzer->Data());
+  verible::util::Status lint_status;
+  {
+    const auto phase = stats->Measure("lint");
+    lint_status = VerilogLintTextStructure(&lint_stream, std::string(filename),
+                                           analyzer->Data().Contents(), config,
+                                           analyzer->Data());
+  }
   if (!lint_status.ok()) {
     // Something went wrong with running the lint analysis itself.
     LOG(ERROR) << "Fatal error: " << lint_status.message();
@@ -102,7 +128,7 @@ int LintOneFile(std::ostream* stream, absl::string_view filename,
   return 0;
 }
 
-VerilogLinter::VerilogLinter()
+VerilogLinter::VerilogLinter(int num_threads)
     : lint_waiver_(
           [](const TokenInfo& t) {
             return t.token_enum == TK_COMMENT_BLOCK ||
@@ -112,7 +138,12 @@ VerilogLinter::VerilogLinter()
             return t.token_enum == TK_SPACE || t.token_enum == TK_NEWLINE;
           },
           kLinterTrigger, kLinterWaiveLineCommand, kLinterWaiveStartCommand,
-          kLinterWaiveStopCommand) {}
+          kLinterWaiveStopCommand),
+      num_threads_(num_threads > 0
+                       ? num_threads
+                       : verible::ThreadPool::HardwareConcurrency()) {
+  syntax_tree_linters_.emplace_back(new verible::SyntaxTreeLinter);
+}
 
 void VerilogLinter::Configure(const LinterConfiguration& configuration) {
   if (VLOG_IS_ON(1)) {
@@ -133,29 +164,57 @@ void VerilogLinter::Configure(const LinterConfiguration& configuration) {
     token_stream_linter_.AddRule(std::move(rule));
   }
   auto syntax_rules = configuration.CreateSyntaxTreeRules();
-  for (auto& rule : syntax_rules) {
-    syntax_tree_linter_.AddRule(std::move(rule));
+  const size_t num_syntax_tree_linters = std::max<size_t>(
+      1, std::min<size_t>(num_threads_, syntax_rules.size()));
+  syntax_tree_linters_.clear();
+  for (size_t i = 0; i < num_syntax_tree_linters; ++i) {
+    syntax_tree_linters_.emplace_back(new verible::SyntaxTreeLinter);
+  }
+  for (size_t i = 0; i < syntax_rules.size(); ++i) {
+    syntax_tree_linters_[i % num_syntax_tree_linters]->AddRule(
+        std::move(syntax_rules[i]));
   }
 }
 
 void VerilogLinter::Lint(const TextStructureView& text_structure,
                          absl::string_view filename) {
-  // Collect all lint waivers in an initial pass.
-  lint_waiver_.ProcessTokenRangesByLine(text_structure);
+  // The families of rules only read text_structure, and each keeps its own
+  // state, so they can run concurrently.
+  std::vector<std::function<void()>> tasks;
+
+  // Collect all lint waivers (applied only in ReportStatus()).
+  tasks.emplace_back(
+      [&] { lint_waiver_.ProcessTokenRangesByLine(text_structure); });
 
   // Analyze general text structure.
-  text_structure_linter_.Lint(text_structure, filename);
+  tasks.emplace_back(
+      [&] { text_structure_linter_.Lint(text_structure, filename); });
 
   // Analyze lines of text.
-  line_linter_.Lint(text_structure.Lines());
+  tasks.emplace_back([&] {
+    line_linter_.Lint(text_structure.Lines(), text_structure.GetLineStats());
+  });
 
   // Analyze token stream.
-  token_stream_linter_.Lint(text_structure.TokenStream());
+  tasks.emplace_back(
+      [&] { token_stream_linter_.Lint(text_structure.TokenStream()); });
 
   // Analyze syntax tree.
   const verible::ConcreteSyntaxTree& syntax_tree = text_structure.SyntaxTree();
   if (syntax_tree != nullptr) {
-    syntax_tree_linter_.Lint(*syntax_tree);
+    for (auto& linter : syntax_tree_linters_) {
+      tasks.emplace_back([&] { linter->Lint(*syntax_tree); });
+    }
+  }
+
+  const int num_threads =
+      std::min(num_threads_, static_cast<int>(tasks.size()));
+  if (num_threads <= 1) {
+    for (const auto& task : tasks) task();
+  } else {
+    // Pool destruction waits for all tasks to finish.
+    verible::ThreadPool pool(num_threads);
+    for (auto& task : tasks) pool.Schedule(std::move(task));
   }
 }
 
@@ -166,22 +225,8 @@ static void AppendLintRuleStatuses(
     std::vector<LintRuleStatus>* cumulative_statuses) {
   for (const auto& status : new_statuses) {
     cumulative_statuses->push_back(status);
-    const auto* waived_lines = waivers.LookupLineSet(status.lint_rule_name);
-    if (waived_lines) {
-      cumulative_statuses->back().WaiveViolations(
-          [&](const verible::LintViolation& violation) {
-            // Lookup the line number on which the offending token resides.
-            const size_t offset = violation.token.left(text_base);
-            const size_t line = line_map(offset).line;
-            // Check that line number against the set of waived lines.
-            const bool waived =
-                LintWaiver::LineSetContains(*waived_lines, line);
-            VLOG(2) << "Violation of " << status.lint_rule_name
-                    << " rule on line " << line + 1
-                    << (waived ? " is waived." : " is not waived.");
-            return waived;
-          });
-    }
+    waivers.FilterWaivedViolations(line_map, text_base,
+                                   &cumulative_statuses->back());
   }
 }
 
@@ -195,8 +240,20 @@ std::vector<LintRuleStatus> VerilogLinter::ReportStatus(
                          line_map, text_base, &statuses);
   AppendLintRuleStatuses(token_stream_linter_.ReportStatus(), waivers, line_map,
                          text_base, &statuses);
-  AppendLintRuleStatuses(syntax_tree_linter_.ReportStatus(), waivers, line_map,
-                         text_base, &statuses);
+  // Re-interleave the statuses of the syntax-tree linters, whose rules were
+  // dealt round-robin, to report them in their configured order.
+  std::vector<std::vector<LintRuleStatus>> syntax_tree_statuses;
+  for (const auto& linter : syntax_tree_linters_) {
+    syntax_tree_statuses.push_back(linter->ReportStatus());
+  }
+  for (size_t i = 0;; ++i) {
+    auto& linter_statuses =
+        syntax_tree_statuses[i % syntax_tree_statuses.size()];
+    const size_t index = i / syntax_tree_statuses.size();
+    if (index >= linter_statuses.size()) break;
+    AppendLintRuleStatuses({linter_statuses[index]}, waivers, line_map,
+                           text_base, &statuses);
+  }
   return statuses;
 }
 
@@ -216,10 +273,10 @@ LinterConfiguration LinterConfigurationFromFlags() {
 
 verible::util::Status VerilogLintTextStructure(
     std::ostream* stream, const std::string& filename,
-    const std::string& contents, const LinterConfiguration& config,
+    absl::string_view contents, const LinterConfiguration& config,
     const TextStructureView& text_structure) {
   // Create the linter, add rules, and run it.
-  VerilogLinter linter;
+  VerilogLinter linter(absl::GetFlag(FLAGS_lint_threads));
   linter.Configure(config);
   linter.Lint(text_structure, filename);
 
@@ -237,7 +294,7 @@ verible::util::Status VerilogLintTextStructure(
   } else {
     VLOG(1) << "Lint Violations (" << total_violations << "): " << std::endl;
     // Output results to stream using formatter.
-    verible::LintStatusFormatter formatter(contents);
+    verible::LintStatusFormatter formatter(text_structure.GetLineColumnMap());
     formatter.FormatLintRuleStatuses(stream, linter_statuses, text_base,
                                      filename);
   }
@@ -16,6 +16,7 @@
 #define VERIBLE_VERILOG_ANALYSIS_VERILOG_LINTER_H_
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,8 +27,10 @@
 #include "common/analysis/syntax_tree_linter.h"
 #include "common/analysis/text_structure_linter.h"
 #include "common/analysis/token_stream_linter.h"
+#include "common/strings/mem_block.h"
 #include "common/text/line_column_map.h"
 #include "common/text/text_structure.h"
+#include "common/util/phase_stats.h"
 #include "common/util/status.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/analysis/verilog_linter_configuration.h"
@@ -42,17 +45,31 @@ namespace verilog {
 // If 'parse_fatal' is true, abort after encountering syntax errors, else
 // continue to analyze the salvaged code structure.
 // If 'lint_fatal' is true, exit nonzero on finding lint violations.
+// If 'stats' is non-null, it receives the time spent in each phase of
+// analysis and linting.
 // Returns an exit_code like status where 0 means success, 1 means some
 // errors were found (syntax, lint), and anything else is a fatal error.
 int LintOneFile(std::ostream* stream, absl::string_view filename,
                 const LinterConfiguration& config, bool parse_fatal,
-                bool lint_fatal);
+                bool lint_fatal, verible::PhaseStats* stats = nullptr);
+
+// Same as above, but lints 'content', which was already read from 'filename'.
+int LintOneFile(std::ostream* stream, absl::string_view filename,
+                std::shared_ptr<verible::MemBlock> content,
+                const LinterConfiguration& config, bool parse_fatal,
+                bool lint_fatal, verible::PhaseStats* stats = nullptr);
 
 // VerilogLinter analyzes a TextStructureView of Verilog source code.
 // This uses syntax-tree based analyses and lexical token-stream analyses.
 class VerilogLinter {
  public:
-  VerilogLinter();
+  // With 'num_threads' > 1, Lint() runs the independent families of rules
+  // (waiver collection, text-structure, line, token-stream and syntax-tree
+  // rules) concurrently, and splits the syntax-tree rules into up to
+  // 'num_threads' subsets that each traverse the tree in parallel.
+  // Values < 1 mean one thread per hardware thread.
+  // Findings do not depend on the number of threads.
+  explicit VerilogLinter(int num_threads = 1);
 
   // Configures the internal linters, enabling select rules.
   void Configure(const LinterConfiguration& configuration);
@@ -72,14 +89,18 @@ class VerilogLinter {
   // Token-based linter.
   verible::TokenStreamLinter token_stream_linter_;
 
-  // Syntax-tree based linter.
-  verible::SyntaxTreeLinter syntax_tree_linter_;
+  // Syntax-tree based linters, each with a subset of the syntax-tree rules,
+  // dealt round-robin.  There is only one unless num_threads_ > 1.
+  std::vector<std::unique_ptr<verible::SyntaxTreeLinter>> syntax_tree_linters_;
 
   // TextStructure-based linter.
   verible::TextStructureLinter text_structure_linter_;
 
   // Tracks the set of waived lines per rule.
   verible::LintWaiverBuilder lint_waiver_;
+
+  // Maximum number of threads used by Lint().
+  const int num_threads_;
 };
 
 // Creates a linter configuration from global flags.
@@ -89,7 +110,7 @@ LinterConfiguration LinterConfigurationFromFlags();
 // and syntactically detectable pitfalls.
 //
 // The configuration of this function is controlled by flags:
-//   FLAGS_ruleset, FLAGS_rules.
+//   FLAGS_ruleset, FLAGS_rules, FLAGS_lint_threads.
 //
 // Args:
 //   stream: the output stream where diagnostics are captured.
@@ -105,7 +126,7 @@ LinterConfiguration LinterConfigurationFromFlags();
 //   util::Status that reflects whether linter linter ran successfully.
 verible::util::Status VerilogLintTextStructure(
     std::ostream* stream, const std::string& filename,
-    const std::string& contents, const LinterConfiguration& config,
+    absl::string_view contents, const LinterConfiguration& config,
     const verible::TextStructureView& text_structure);
 
 // Prints the rule, description and default_enabled.
@@ -330,5 +330,42 @@ TEST_F(VerilogLinterTest, ModuleBodyLineLengthWaived) {
   EXPECT_EQ(diagnostics.second, "");
 }
 
+// This test verifies that running rule families and subsets of syntax-tree
+// rules concurrently yields the same findings, in the same order.
+TEST(VerilogLinterThreadsTest, SameStatusesForAnyNumberOfThreads) {
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kAll);
+  const std::string content =
+      "module  m;\t\n"
+      "  initial $psprintf(\"blah\");  \n"
+      "  initial $psprintf(\"waived\");  // verilog_lint: waive "
+      "invalid-system-task-function\n"
+      "  always @* begin x = 1; end\n"
+      "endmodule\n";
+  const auto analyzer = absl::make_unique<VerilogAnalyzer>(content, "t.sv");
+  ASSERT_TRUE(analyzer->Analyze().ok());
+  const auto& text_structure = analyzer->Data();
+
+  const auto report = [&](int num_threads) {
+    VerilogLinter linter(num_threads);
+    linter.Configure(config);
+    linter.Lint(text_structure, "t.sv");
+    std::vector<std::pair<std::string, size_t>> findings;
+    for (const auto& status : linter.ReportStatus(
+             text_structure.GetLineColumnMap(), text_structure.Contents())) {
+      findings.emplace_back(std::string(status.lint_rule_name),
+                            status.violations.size());
+    }
+    return findings;
+  };
+  const auto serial = report(1);
+  size_t total_violations = 0;
+  for (const auto& finding : serial) total_violations += finding.second;
+  EXPECT_GT(total_violations, 0);
+  EXPECT_EQ(report(2), serial);
+  EXPECT_EQ(report(7), serial);
+  EXPECT_EQ(report(64), serial);
+}
+
 }  // namespace
 }  // namespace verilog
@@ -19,6 +19,8 @@
 #include <sstream>
 #include <string>
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "common/util/enum_flags.h"
 
@@ -55,5 +57,45 @@ std::string AbslUnparseFlag(const PreserveSpaces& mode) {
   return stream.str();
 }
 
+// Catches fields that were added without being listed in ForEachField().
+static_assert(sizeof(FormatStyle) ==
+                  4 * sizeof(int) + 2 * sizeof(PreserveSpaces),
+              "New FormatStyle fields must be listed in ForEachField().");
+
+std::string FormatStyle::Serialize() const {
+  std::ostringstream stream;
+  const char* separator = "";
+  ForEachField(*this, [&](absl::string_view name, const auto& field) {
+    stream << separator << name << '=' << field;
+    separator = " ";
+  });
+  return stream.str();
+}
+
+static bool ParseField(absl::string_view text, int* field, std::string*) {
+  return absl::SimpleAtoi(text, field);
+}
+
+static bool ParseField(absl::string_view text, PreserveSpaces* field,
+                       std::string* error) {
+  return AbslParseFlag(text, field, error);
+}
+
+bool FormatStyle::SetField(absl::string_view name, absl::string_view value,
+                           std::string* error) {
+  bool found = false;
+  bool valid = false;
+  ForEachField(*this, [&](absl::string_view field_name, auto& field) {
+    if (field_name != name) return;
+    found = true;
+    // Invalid values leave the field unchanged.
+    auto parsed = field;
+    valid = ParseField(value, &parsed, error);
+    if (valid) field = parsed;
+  });
+  if (!found) *error = absl::StrCat("Unknown style field: ", name);
+  return valid;
+}
+
 }  // namespace formatter
 }  // namespace verilog
@@ -64,6 +64,26 @@ struct FormatStyle : public verible::BasicFormatStyle {
   // Vertical (inter-line) space preservation policy.
   // This takes effect only if preserve_horizontal_spaces != All.
   PreserveSpaces preserve_vertical_spaces = PreserveSpaces::None;
+
+  // Like BasicFormatStyle::ForEachField(), including the fields above.
+  // Names match the flags of verilog_format.
+  template <typename Style, typename Visitor>
+  static void ForEachField(Style& style, Visitor&& visitor) {
+    BasicFormatStyle::ForEachField(style, visitor);
+    visitor("preserve_hspaces", style.preserve_horizontal_spaces);
+    visitor("preserve_vspaces", style.preserve_vertical_spaces);
+  }
+
+  // Returns all fields as space-separated "name=value" pairs.  Styles with
+  // equal serializations format code identically, so this can key cached
+  // formatter output.
+  std::string Serialize() const;
+
+  // Sets the field called 'name' (see ForEachField()) from its serialized
+  // 'value'.  Returns false, with a diagnostic in 'error', for unknown names
+  // and invalid values.
+  bool SetField(absl::string_view name, absl::string_view value,
+                std::string* error);
 };
 
 }  // namespace formatter
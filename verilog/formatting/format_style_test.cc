@@ -15,9 +15,12 @@
 #include "verilog/formatting/format_style.h"
 
 #include <initializer_list>
+#include <string>
 #include <utility>
 
 #include "gtest/gtest.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "common/util/enum_flags_test_util.h"
 
 namespace verilog {
@@ -43,6 +46,45 @@ TEST(EnumFlagsTest, UnparseFlags) {
       kPreserveSpacesStringMap);
 }
 
+TEST(FormatStyleTest, Serialize) {
+  FormatStyle style;
+  style.column_limit = 80;
+  style.preserve_vertical_spaces = PreserveSpaces::All;
+  EXPECT_EQ(style.Serialize(),
+            "indentation_spaces=2 wrap_spaces=4 column_limit=80 "
+            "over_column_limit_penalty=100 preserve_hspaces=unhandled "
+            "preserve_vspaces=all");
+}
+
+// Every serialized field can be set back from its name and value.
+TEST(FormatStyleTest, SetFieldRoundTrip) {
+  FormatStyle original;
+  original.indentation_spaces = 3;
+  original.wrap_spaces = 5;
+  original.column_limit = 60;
+  original.over_column_limit_penalty = 7;
+  original.preserve_horizontal_spaces = PreserveSpaces::None;
+  original.preserve_vertical_spaces = PreserveSpaces::All;
+  FormatStyle copy;
+  for (absl::string_view pair : absl::StrSplit(original.Serialize(), ' ')) {
+    const std::pair<absl::string_view, absl::string_view> field =
+        absl::StrSplit(pair, '=');
+    std::string error;
+    EXPECT_TRUE(copy.SetField(field.first, field.second, &error)) << error;
+  }
+  EXPECT_EQ(copy.Serialize(), original.Serialize());
+}
+
+TEST(FormatStyleTest, SetFieldInvalid) {
+  FormatStyle style;
+  std::string error;
+  EXPECT_FALSE(style.SetField("column_limit", "wide", &error));
+  EXPECT_FALSE(style.SetField("preserve_hspaces", "some", &error));
+  EXPECT_FALSE(style.SetField("tab_width", "8", &error));
+  EXPECT_EQ(error, "Unknown style field: tab_width");
+  EXPECT_EQ(style.Serialize(), FormatStyle().Serialize());
+}
+
 }  // namespace
 }  // namespace formatter
 }  // namespace verilog
@@ -16,27 +16,43 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
 #include "common/formatting/format_token.h"
 #include "common/formatting/line_wrap_searcher.h"
 #include "common/formatting/token_partition_tree.h"
 #include "common/formatting/unwrapped_line.h"
+#include "common/strings/mem_block.h"
 #include "common/strings/range.h"
 #include "common/text/line_column_map.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
+#include "common/util/enum_flags.h"
 #include "common/util/expandable_tree_view.h"
 #include "common/util/iterator_range.h"
 #include "common/util/logging.h"
+#include "common/util/phase_stats.h"
 #include "common/util/spacer.h"
 #include "common/util/status.h"
+#include "common/util/thread_pool.h"
 #include "common/util/vector_tree.h"
+#include "verilog/analysis/verilog_analyzer.h"
 #include "verilog/formatting/format_style.h"
 #include "verilog/formatting/token_annotator.h"
 #include "verilog/formatting/tree_unwrapper.h"
+#include "verilog/parser/verilog_lexer.h"
+#include "verilog/parser/verilog_parser.h"
+#include "verilog/parser/verilog_token_enum.h"
 
 namespace verilog {
 namespace formatter {
@@ -48,6 +64,33 @@ using verible::TreeViewNodeInfo;
 using verible::UnwrappedLine;
 using verible::VectorTree;
 
+// This mapping defines how this enum is displayed and parsed.
+static const std::initializer_list<
+    std::pair<const absl::string_view, VerifyMode>>
+    kVerifyModeStringMap = {
+        {"fast", VerifyMode::kFast},
+        {"full", VerifyMode::kFull},
+};
+
+std::ostream& operator<<(std::ostream& stream, VerifyMode mode) {
+  static const auto* flag_map =
+      verible::MakeEnumToStringMap(kVerifyModeStringMap);
+  return stream << flag_map->find(mode)->second;
+}
+
+bool AbslParseFlag(absl::string_view text, VerifyMode* mode,
+                   std::string* error) {
+  static const auto* flag_map =
+      verible::MakeStringToEnumMap(kVerifyModeStringMap);
+  return EnumMapParseFlag(*flag_map, text, mode, error);
+}
+
+std::string AbslUnparseFlag(const VerifyMode& mode) {
+  std::ostringstream stream;
+  stream << mode;
+  return stream.str();
+}
+
 typedef VectorTree<TreeViewNodeInfo<UnwrappedLine>> partition_node_type;
 
 // Decided at each node in UnwrappedLine partition tree whether or not
@@ -195,22 +238,45 @@ verible::util::Status Formatter::Format(const ExecutionControl& control) {
       MakeUnwrappedLinesWorklist(*format_tokens_partitions, style_);
 
   // For each UnwrappedLine: minimize total penalty of wrap/break decisions.
-  // TODO(fangism): This could be parallelized if results are written
-  // to their own 'slots'.
+  // Searches are independent of each other, so they may run concurrently,
+  // each writing its result into its own slot.
+  // TODO(fangism): Use different formatting strategies depending on
+  // uwline.PartitionPolicy().
+  std::vector<std::vector<verible::FormattedExcerpt>>
+      optimal_solutions_per_line(unwrapped_lines.size());
+  const auto search = [&](size_t i) {
+    optimal_solutions_per_line[i] = verible::SearchLineWraps(
+        unwrapped_lines[i], style_, control.max_search_states);
+  };
+  int num_threads = control.num_threads;
+  if (num_threads <= 0) {
+    num_threads = verible::ThreadPool::HardwareConcurrency();
+  }
+  num_threads = std::min(num_threads, static_cast<int>(unwrapped_lines.size()));
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < unwrapped_lines.size(); ++i) search(i);
+  } else {
+    // Pool destruction waits for all searches to finish.
+    verible::ThreadPool pool(num_threads);
+    for (size_t i = 0; i < unwrapped_lines.size(); ++i) {
+      pool.Schedule([&search, i] { search(i); });
+    }
+  }
+
+  // Collect results in original order, so that output (including
+  // diagnostics) does not depend on the number of threads.
   std::vector<const UnwrappedLine*> partially_formatted_lines;
   formatted_lines_.reserve(unwrapped_lines.size());
-  for (const auto& uwline : unwrapped_lines) {
-    // TODO(fangism): Use different formatting strategies depending on
-    // uwline.PartitionPolicy().
-    const auto optimal_solutions =
-        verible::SearchLineWraps(uwline, style_, control.max_search_states);
+  for (size_t i = 0; i < unwrapped_lines.size(); ++i) {
+    const auto& uwline = unwrapped_lines[i];
+    auto& optimal_solutions = optimal_solutions_per_line[i];
     if (control.show_equally_optimal_wrappings &&
         optimal_solutions.size() > 1) {
       verible::DisplayEquallyOptimalWrappings(control.Stream(), uwline,
                                               optimal_solutions);
     }
     // Arbitrarily choose the first solution, if there are multiple.
-    formatted_lines_.push_back(optimal_solutions.front());
+    formatted_lines_.push_back(std::move(optimal_solutions.front()));
     if (!formatted_lines_.back().CompletedFormatting()) {
       // Copy over any lines that did not finish wrap searching.
       partially_formatted_lines.push_back(&uwline);
@@ -289,5 +355,153 @@ void Formatter::Emit(std::ostream& stream) const {
   }
 }
 
+verible::util::Status FormatVerilog(std::shared_ptr<verible::MemBlock> content,
+                                    absl::string_view filename,
+                                    const FormatStyle& style,
+                                    std::ostream& formatted_stream,
+                                    const Formatter::ExecutionControl& control,
+                                    verible::PhaseStats* stats) {
+  const auto analyzer =
+      VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
+  {
+    // Lex and parse code.  Exit on failure.
+    const auto lex_status = ABSL_DIE_IF_NULL(analyzer)->LexStatus();
+    const auto parse_status = analyzer->ParseStatus();
+    if (!lex_status.ok() || !parse_status.ok()) {
+      return verible::util::InvalidArgumentError(
+          absl::StrJoin(analyzer->LinterTokenErrorMessages(), "\n"));
+    }
+  }
+  verible::PhaseStats local_stats;
+  if (stats == nullptr) stats = &local_stats;
+  *stats = analyzer->Stats();
+
+  const verible::TextStructureView& text_structure = analyzer->Data();
+  std::ostringstream stream;
+  {
+    Formatter formatter(text_structure, style);
+    verible::util::Status format_status;
+    {
+      const auto phase = stats->Measure("format");
+      format_status = formatter.Format(control);
+    }
+    // In any diagnostic mode, proceed no further.
+    if (control.AnyStop()) return verible::util::OkStatus();
+    if (format_status.code() ==
+        verible::util::StatusCode::kResourceExhausted) {
+      // Still provide the partially formatted code.
+      formatter.Emit(formatted_stream);
+    }
+    if (!format_status.ok()) return format_status;
+    formatter.Emit(stream);
+  }
+  // Shared with any re-analysis, to avoid copying the output again.
+  const auto formatted_block =
+      std::make_shared<verible::StringMemBlock>(stream.str());
+  formatted_stream << formatted_block->AsStringView();
+
+  // TODO(b/138868051): Verify output stability/convergence.
+  return VerifyFormatting(text_structure, formatted_block, filename,
+                          control.verify, stats);
+}
+
+// Returns the next token from 'lexer' that is not whitespace.
+static const verible::TokenInfo& NextNonWhitespaceToken(VerilogLexer* lexer) {
+  while (true) {
+    const verible::TokenInfo& token = lexer->DoNextToken();
+    if (token.token_enum != TK_SPACE && token.token_enum != TK_NEWLINE) {
+      return token;
+    }
+  }
+}
+
+verible::util::Status VerifyFormattingLexically(absl::string_view original,
+                                                absl::string_view formatted) {
+  // Streaming through both texts avoids storing either token sequence.
+  VerilogLexer original_lexer(original);
+  VerilogLexer formatted_lexer(formatted);
+  for (size_t index = 0;; ++index) {
+    const auto& original_token = NextNonWhitespaceToken(&original_lexer);
+    const auto& formatted_token = NextNonWhitespaceToken(&formatted_lexer);
+    if (original_lexer.TokenIsError(original_token) ||
+        formatted_lexer.TokenIsError(formatted_token)) {
+      return verible::util::Status(
+          verible::util::StatusCode::kDataLoss,
+          absl::StrCat("Lexical error at token [", index, "]."));
+    }
+    if (!original_token.EquivalentWithoutLocation(formatted_token)) {
+      std::ostringstream errstream;
+      errstream << "First mismatched token [" << index << "]: ("
+                << verilog_symbol_name(original_token.token_enum) << ") "
+                << original_token << " vs. ("
+                << verilog_symbol_name(formatted_token.token_enum) << ") "
+                << formatted_token;
+      return verible::util::Status(verible::util::StatusCode::kDataLoss,
+                                   errstream.str());
+    }
+    if (original_token.isEOF()) return verible::util::OkStatus();
+  }
+}
+
+verible::util::Status VerifyFormattingByAnalysis(
+    const verible::TokenSequence& original_tokens,
+    std::shared_ptr<verible::MemBlock> formatted, absl::string_view filename) {
+  // Verify that the formatted output creates the same lexical
+  // stream (filtered) as the original.
+  // Note: We cannot just Tokenize() and compare because Analyze()
+  // performs additional transformations like expanding MacroArgs to
+  // expression subtrees.
+  const auto reanalyzer =
+      VerilogAnalyzer::AnalyzeAutomaticMode(std::move(formatted), filename);
+  {
+    // Filter out only whitespaces and compare.
+    // First difference is included in the message, for debugging.
+    std::ostringstream errstream;
+    if (!LexicallyEquivalent(original_tokens,
+                             ABSL_DIE_IF_NULL(reanalyzer)->Data().TokenStream(),
+                             &errstream)) {
+      return verible::util::Status(
+          verible::util::StatusCode::kDataLoss,
+          absl::StrCat(errstream.str(),
+                       "Formatted output is lexically different from the "
+                       "input.  Please file a bug."));
+    }
+  }
+  if (!reanalyzer->LexStatus().ok() || !reanalyzer->ParseStatus().ok()) {
+    std::string message(
+        "Error lex/parsing-ing formatted output.  Please file a bug.");
+    const auto& token_errors = reanalyzer->TokenErrorMessages();
+    // Only report the first error.
+    if (!token_errors.empty()) {
+      absl::StrAppend(&message, "\nFirst error: ", token_errors.front());
+    }
+    return verible::util::Status(verible::util::StatusCode::kDataLoss,
+                                 message);
+  }
+  return verible::util::OkStatus();
+}
+
+verible::util::Status VerifyFormatting(
+    const verible::TextStructureView& original,
+    std::shared_ptr<verible::MemBlock> formatted, absl::string_view filename,
+    VerifyMode mode, verible::PhaseStats* stats) {
+  verible::PhaseStats local_stats;
+  if (stats == nullptr) stats = &local_stats;
+  if (mode == VerifyMode::kFast) {
+    verible::util::Status status;
+    {
+      const auto phase = stats->Measure("verify-lex");
+      status = VerifyFormattingLexically(original.Contents(),
+                                         formatted->AsStringView());
+    }
+    if (status.ok()) return status;
+    VLOG(1) << "Lexical verification failed, re-analyzing: "
+            << status.message();
+  }
+  const auto phase = stats->Measure("verify-analyze");
+  return VerifyFormattingByAnalysis(original.TokenStream(),
+                                    std::move(formatted), filename);
+}
+
 }  // namespace formatter
 }  // namespace verilog
@@ -16,16 +16,39 @@
 #define VERIBLE_VERILOG_FORMATTING_FORMATTER_H_
 
 #include <iosfwd>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "common/formatting/unwrapped_line.h"
+#include "common/strings/mem_block.h"
 #include "common/text/text_structure.h"
+#include "common/text/token_stream_view.h"
+#include "common/util/phase_stats.h"
 #include "common/util/status.h"
 #include "verilog/formatting/format_style.h"
 
 namespace verilog {
 namespace formatter {
 
+// How thoroughly formatted code is verified against the original code.
+enum class VerifyMode {
+  // Only lex both, and compare their tokens.  Only if that fails, fall back
+  // to kFull, because lexical differences can be benign (see
+  // VerifyFormattingLexically()).
+  kFast,
+  // Fully analyze the formatted code again, and compare its tokens with
+  // those of the analyzed original.
+  kFull,
+};
+
+std::ostream& operator<<(std::ostream&, VerifyMode);
+
+// Flag handling for VerifyMode.
+bool AbslParseFlag(absl::string_view, VerifyMode*, std::string*);
+std::string AbslUnparseFlag(const VerifyMode& mode);
+
 // Takes a TextStructureView and FormatStyle, and formats UnwrappedLines.
 class Formatter {
  public:
@@ -47,6 +70,14 @@ class Formatter {
     // If this limit is exceeded, error out with a diagnostic message.
     int max_search_states = 10000;
 
+    // Number of threads used to search for optimal line wraps.
+    // Each unwrapped line is searched independently, and output is the same
+    // regardless of this value.  0 means one per hardware thread.
+    int num_threads = 1;
+
+    // How FormatVerilog() verifies formatted output.
+    VerifyMode verify = VerifyMode::kFast;
+
     // Output stream for diagnostic feedback (not formatting output).
     std::ostream* stream = nullptr;
 
@@ -86,6 +117,57 @@ class Formatter {
   std::vector<verible::FormattedExcerpt> formatted_lines_;
 };
 
+// Analyzes and formats 'content' of file 'filename' (used in diagnostics),
+// and writes the formatted code to 'formatted_stream'.
+// The formatted code is then verified to be lexically equivalent to the
+// original and to parse successfully, as selected by 'control.verify'
+// (see VerifyFormatting()).
+// Returns OK on success, or if 'control' requested a diagnostic mode
+// (nothing is written to 'formatted_stream' then).  Otherwise returns
+//   kInvalidArgument: 'content' has syntax errors, listed in the message.
+//   kResourceExhausted: line wrap search was aborted, with partially
+//     formatted code written to 'formatted_stream'.
+//   kDataLoss: verification of the formatted code failed.
+// In the latter cases, the formatted code must not replace the original.
+// If 'stats' is non-null, it receives the time spent in analysis,
+// formatting and verification.
+verible::util::Status FormatVerilog(
+    std::shared_ptr<verible::MemBlock> content, absl::string_view filename,
+    const FormatStyle& style, std::ostream& formatted_stream,
+    const Formatter::ExecutionControl& control = Formatter::ExecutionControl(),
+    verible::PhaseStats* stats = nullptr);
+
+// Returns OK if 'formatted' lexes into the same tokens as 'original',
+// ignoring whitespace.  Tokens are compared as they are lexed, without
+// preprocessing or parsing either text.  Analysis only depends on the
+// non-whitespace tokens, so if 'original' analyzes without errors, then so
+// does 'formatted', with equivalent results.
+// Otherwise returns kDataLoss, describing the first difference.  This does not
+// necessarily mean that formatting is wrong: e.g. the formatter may respace
+// the contents of a macro call argument, which is lexed as a single token,
+// but analyzed as an expression.
+verible::util::Status VerifyFormattingLexically(absl::string_view original,
+                                                absl::string_view formatted);
+
+// Returns OK if analysis of 'formatted' succeeds, and yields tokens
+// equivalent to 'original_tokens' (the analyzed tokens of the original
+// code), ignoring whitespace.  Otherwise returns kDataLoss.
+// 'filename' is only used in diagnostics.
+verible::util::Status VerifyFormattingByAnalysis(
+    const verible::TokenSequence& original_tokens,
+    std::shared_ptr<verible::MemBlock> formatted, absl::string_view filename);
+
+// Verifies 'formatted' against the analyzed 'original' code:
+//   VerifyMode::kFast: VerifyFormattingLexically(), falling back to
+//     VerifyFormattingByAnalysis() if that fails.
+//   VerifyMode::kFull: VerifyFormattingByAnalysis() only.
+// Returns OK or kDataLoss.  If 'stats' is non-null, it receives the time
+// spent in each tier.
+verible::util::Status VerifyFormatting(
+    const verible::TextStructureView& original,
+    std::shared_ptr<verible::MemBlock> formatted, absl::string_view filename,
+    VerifyMode mode, verible::PhaseStats* stats = nullptr);
+
 }  // namespace formatter
 }  // namespace verilog
 
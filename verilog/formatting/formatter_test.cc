@@ -27,6 +27,7 @@
 #include "common/formatting/format_token.h"
 #include "common/formatting/unwrapped_line.h"
 #include "common/formatting/unwrapped_line_test_utils.h"
+#include "common/strings/mem_block.h"
 #include "common/text/text_structure.h"
 #include "common/util/logging.h"
 #include "common/util/status.h"
@@ -1727,6 +1728,30 @@ TEST(FormatterEndToEndTest, VerilogFormatTest) {
   }
 }
 
+// Tests that searching for line wraps concurrently yields the same results.
+TEST(FormatterEndToEndTest, VerilogFormatMultiThreadedTest) {
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+  style.over_column_limit_penalty = 50;
+  style.preserve_horizontal_spaces = PreserveSpaces::None;
+  style.preserve_vertical_spaces = PreserveSpaces::None;
+  Formatter::ExecutionControl control;
+  control.num_threads = 4;
+  for (const auto& test_case : kFormatterTestCases) {
+    const std::unique_ptr<VerilogAnalyzer> analyzer =
+        VerilogAnalyzer::AnalyzeAutomaticMode(test_case.input, "<filename>");
+    ASSERT_OK(ABSL_DIE_IF_NULL(analyzer)->LexStatus());
+    ASSERT_OK(analyzer->ParseStatus());
+    Formatter formatter(analyzer->Data(), style);
+    EXPECT_OK(formatter.Format(control));
+    std::ostringstream stream;
+    formatter.Emit(stream);
+    EXPECT_EQ(stream.str(), test_case.expected) << "code:\n" << test_case.input;
+  }
+}
+
 // Tests that formatter preserves all original spaces when so asked.
 TEST(FormatterEndToEndTest, NoFormatTest) {
   FormatStyle style;
@@ -2184,6 +2209,90 @@ TEST(FormatterEndToEndTest, UnfinishedLineWrapSearching) {
   EXPECT_TRUE(absl::StartsWith(status.message(), "***"));
 }
 
+TEST(VerifyModeTest, ParseFlag) {
+  VerifyMode mode = VerifyMode::kFull;
+  std::string error;
+  EXPECT_TRUE(AbslParseFlag("fast", &mode, &error));
+  EXPECT_EQ(mode, VerifyMode::kFast);
+  EXPECT_EQ(AbslUnparseFlag(mode), "fast");
+  EXPECT_TRUE(AbslParseFlag("full", &mode, &error));
+  EXPECT_EQ(mode, VerifyMode::kFull);
+  EXPECT_EQ(AbslUnparseFlag(mode), "full");
+  EXPECT_FALSE(AbslParseFlag("slow", &mode, &error));
+}
+
+TEST(VerifyFormattingTest, LexicallyEquivalent) {
+  EXPECT_OK(VerifyFormattingLexically("module m;endmodule",
+                                      "module m;\nendmodule\n"));
+  EXPECT_OK(VerifyFormattingLexically("", "\n"));
+}
+
+TEST(VerifyFormattingTest, LexicallyDifferent) {
+  for (const auto& formatted : {"module m2;\nendmodule\n",  // changed token
+                                "module m;\n",               // lost tokens
+                                "module m;\nendmodule\n;",  // extra token
+                                "module m; // c\nendmodule\n"}) {  // comment
+    const auto status =
+        VerifyFormattingLexically("module m;\nendmodule\n", formatted);
+    EXPECT_EQ(status.code(), StatusCode::kDataLoss) << formatted;
+  }
+}
+
+// Tests that the fast tier falls back to full analysis, where tokens that
+// are analyzed further, like macro call arguments, are respaced.
+TEST(VerifyFormattingTest, FastFallsBackToAnalysis) {
+  constexpr absl::string_view original =
+      "module m;\nassign x = `FOO(a+b);\nendmodule\n";
+  const auto formatted = std::make_shared<verible::StringMemBlock>(
+      "module m;\n  assign x = `FOO(a + b);\nendmodule\n");
+  const auto analyzer =
+      VerilogAnalyzer::AnalyzeAutomaticMode(original, "<filename>");
+  ASSERT_OK(ABSL_DIE_IF_NULL(analyzer)->LexStatus());
+  ASSERT_OK(analyzer->ParseStatus());
+
+  EXPECT_EQ(
+      VerifyFormattingLexically(original, formatted->AsStringView()).code(),
+      StatusCode::kDataLoss);
+  for (const auto mode : {VerifyMode::kFast, VerifyMode::kFull}) {
+    EXPECT_OK(VerifyFormatting(analyzer->Data(), formatted, "<filename>",
+                               mode));
+  }
+}
+
+// Tests that both tiers reject output that does not parse the same way.
+TEST(VerifyFormattingTest, BothTiersRejectDifferences) {
+  constexpr absl::string_view original = "module m;\nendmodule\n";
+  const auto formatted =
+      std::make_shared<verible::StringMemBlock>("module m;\nendmodule\n;");
+  const auto analyzer =
+      VerilogAnalyzer::AnalyzeAutomaticMode(original, "<filename>");
+  ASSERT_OK(ABSL_DIE_IF_NULL(analyzer)->LexStatus());
+  ASSERT_OK(analyzer->ParseStatus());
+  for (const auto mode : {VerifyMode::kFast, VerifyMode::kFull}) {
+    EXPECT_EQ(VerifyFormatting(analyzer->Data(), formatted, "<filename>", mode)
+                  .code(),
+              StatusCode::kDataLoss);
+  }
+}
+
+// Tests that both tiers of verification accept expected formatter outputs.
+TEST(VerifyFormattingTest, FormatterTestCases) {
+  for (const auto& test_case : kFormatterTestCases) {
+    const auto analyzer =
+        VerilogAnalyzer::AnalyzeAutomaticMode(test_case.input, "<filename>");
+    ASSERT_OK(ABSL_DIE_IF_NULL(analyzer)->LexStatus());
+    ASSERT_OK(analyzer->ParseStatus());
+    const auto formatted = std::make_shared<verible::StringMemBlock>(
+        std::string(test_case.expected));
+    for (const auto mode : {VerifyMode::kFast, VerifyMode::kFull}) {
+      EXPECT_OK(VerifyFormatting(analyzer->Data(), formatted, "<filename>",
+                                 mode))
+          << "code:\n"
+          << test_case.input;
+    }
+  }
+}
+
 // TODO(fangism): directed tests using style variations
 
 }  // namespace
@@ -14,6 +14,7 @@
 
 #include "verilog/formatting/token_annotator.h"
 
+#include <array>
 #include <iterator>
 #include <vector>
 
@@ -21,6 +22,7 @@
 #include "common/formatting/format_token.h"
 #include "common/formatting/tree_annotator.h"
 #include "common/strings/range.h"
+#include "common/text/concrete_syntax_tree.h"
 #include "common/text/syntax_tree_context.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
@@ -52,18 +54,156 @@ struct WithReason {
 // This value must be negative.
 static constexpr int kUnhandledSpacesRequired = -1;
 
-static bool IsUnaryPrefixExpressionOperand(const PreFormatToken& left,
-                                           const SyntaxTreeContext& context) {
-  return IsUnaryOperator(yytokentype(left.TokenEnum())) &&
-         context.IsInsideFirst({NodeEnum::kUnaryPrefixExpression},
-                               {NodeEnum::kExpression});
+// Context-sensitive conditions consulted by the rules below.
+// These are updated as each node is pushed onto the syntax tree context,
+// so that no rule needs to search the whole context for every token pair.
+struct ContextFlags {
+  // Same as context.IsInsideFirst({kDimensionRange, kDimensionScalar}, {}).
+  bool in_dimensions = false;
+  // Same as context.IsInsideFirst({kUnaryPrefixExpression}, {kExpression}).
+  bool in_unary_prefix_expression = false;
+  // Same as context.IsInsideFirst({kPackedDimensions}, {kExpression}).
+  bool in_packed_dimensions = false;
+  // Same as context.IsInside(kModuleHeader).
+  bool in_module_header = false;
+  // Same as context.IsInside(kActualNamedPort).
+  bool in_actual_named_port = false;
+  // Same as context.IsInside(kGateInstance).
+  bool in_gate_instance = false;
+
+  // Returns the flags that apply inside of a child node with the given tag.
+  ContextFlags Enter(NodeEnum tag) const {
+    ContextFlags flags(*this);
+    switch (tag) {
+      case NodeEnum::kDimensionRange:
+      case NodeEnum::kDimensionScalar:
+        flags.in_dimensions = true;
+        break;
+      case NodeEnum::kUnaryPrefixExpression:
+        flags.in_unary_prefix_expression = true;
+        break;
+      case NodeEnum::kPackedDimensions:
+        flags.in_packed_dimensions = true;
+        break;
+      case NodeEnum::kExpression:
+        flags.in_unary_prefix_expression = false;
+        flags.in_packed_dimensions = false;
+        break;
+      case NodeEnum::kModuleHeader:
+        flags.in_module_header = true;
+        break;
+      case NodeEnum::kActualNamedPort:
+        flags.in_actual_named_port = true;
+        break;
+      case NodeEnum::kGateInstance:
+        flags.in_gate_instance = true;
+        break;
+      default:
+        break;
+    }
+    return flags;
+  }
+
+  // Computes the flags for an entire context, from the bottom up.
+  static ContextFlags FromContext(const SyntaxTreeContext& context) {
+    ContextFlags flags;
+    for (const auto* node : context) {
+      flags = flags.Enter(NodeEnum(node->Tag().tag));
+    }
+    return flags;
+  }
+};
+
+// Maintains ContextFlags in step with the syntax tree context.
+class ContextFlagsTracker : public verible::SyntaxContextListener {
+ public:
+  ContextFlagsTracker() : stack_(1) {}
+
+  void Push(const verible::SyntaxTreeNode& node) override {
+    stack_.push_back(stack_.back().Enter(NodeEnum(node.Tag().tag)));
+  }
+
+  void Pop() override { stack_.pop_back(); }
+
+  const ContextFlags& Current() const { return stack_.back(); }
+
+ private:
+  // The bottom element applies outside of all nodes.
+  std::vector<ContextFlags> stack_;
+};
+
+// Properties of adjacent tokens that depend only on their FormatTokenTypes.
+// The rules below consult these in their original priority order.
+struct TokenPairTraits {
+  // "(x", "x)": no space inside of groups.
+  bool binds_group = false;
+  // A comment follows.
+  bool precedes_comment = false;
+  // Either side is a binary or assignment operator.
+  bool around_binary_operator = false;
+  // Between numeric width, base, and digits.
+  bool inside_numeric_literal = false;
+  // Either side is a hierarchy separator.
+  bool around_hierarchy = false;
+  // Penalty for breaking around hierarchy separators, 0 if not applicable.
+  int hierarchy_break_penalty = 0;
+};
+
+static constexpr int kNumFormatTokenTypes = FTT::eol_comment + 1;
+
+using TokenPairTraitsTable =
+    std::array<std::array<TokenPairTraits, kNumFormatTokenTypes>,
+               kNumFormatTokenTypes>;
+
+static constexpr TokenPairTraits ComputeTokenPairTraits(FTT left, FTT right) {
+  TokenPairTraits traits;
+  traits.binds_group = left == FTT::open_group || right == FTT::close_group;
+  traits.precedes_comment = IsComment(right);
+  traits.around_binary_operator =
+      left == FTT::binary_operator || right == FTT::binary_operator;
+  traits.inside_numeric_literal =
+      (left == FTT::numeric_literal && right == FTT::numeric_base) ||
+      left == FTT::numeric_base;
+  traits.around_hierarchy = left == FTT::hierarchy || right == FTT::hierarchy;
+  // Hierarchy examples: "a.b", "a::b"
+  // TODO(fangism): '.' is not always hierarchy, differentiate by context.
+  if (left == FTT::hierarchy) {
+    traits.hierarchy_break_penalty = 50;
+  } else if (right == FTT::hierarchy) {
+    // slightly prefer to break on the left
+    traits.hierarchy_break_penalty = 45;
+  }
+  return traits;
 }
 
-static bool IsInsideNumericLiteral(const PreFormatToken& left,
-                                   const PreFormatToken& right) {
-  return (left.format_token_enum == FormatTokenType::numeric_literal &&
-          right.format_token_enum == FormatTokenType::numeric_base) ||
-         left.format_token_enum == FormatTokenType::numeric_base;
+static constexpr TokenPairTraitsTable BuildTokenPairTraitsTable() {
+  TokenPairTraitsTable table{};
+  for (int left = 0; left < kNumFormatTokenTypes; ++left) {
+    for (int right = 0; right < kNumFormatTokenTypes; ++right) {
+      table[left][right] = ComputeTokenPairTraits(FTT(left), FTT(right));
+    }
+  }
+  return table;
+}
+
+static constexpr TokenPairTraitsTable kTokenPairTraits =
+    BuildTokenPairTraitsTable();
+
+static const TokenPairTraits& GetTokenPairTraits(const PreFormatToken& left,
+                                                 const PreFormatToken& right) {
+  static constexpr TokenPairTraits kUnclassified{};
+  const auto l = static_cast<unsigned>(left.format_token_enum);
+  const auto r = static_cast<unsigned>(right.format_token_enum);
+  if (l >= kNumFormatTokenTypes || r >= kNumFormatTokenTypes) {
+    return kUnclassified;
+  }
+  return kTokenPairTraits[l][r];
+}
+
+static bool IsUnaryPrefixExpressionOperand(const PreFormatToken& left,
+                                           const ContextFlags& flags) {
+  return IsUnaryOperator(yytokentype(left.TokenEnum())) &&
+         flags.in_unary_prefix_expression;
 }
 
 // Returns true if keyword can be used like a function/method call.
@@ -117,7 +257,8 @@ static bool PairwiseNonmergeable(const PreFormatToken& ftoken) {
 // handled, and it is up to the caller to decide what to do when this happens.
 static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
                                              const PreFormatToken& right,
-                                             const SyntaxTreeContext& context) {
+                                             const SyntaxTreeContext& context,
+                                             const ContextFlags& flags) {
   VLOG(3) << "Spacing between " << verilog_symbol_name(left.TokenEnum())
           << " and " << verilog_symbol_name(right.TokenEnum());
   // Higher precedence rules should be handled earlier in this function.
@@ -127,16 +268,16 @@ static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
     return {1, "Escaped identifiers must end with whitespace."};
   }
 
-  if (left.format_token_enum == FormatTokenType::open_group ||
-      right.format_token_enum == FormatTokenType::close_group) {
+  const TokenPairTraits& pair = GetTokenPairTraits(left, right);
+
+  if (pair.binds_group) {
     return {0,
             "Prefer \"(foo)\" over \"( foo )\", \"[x]\" over \"[ x ]\", "
             "and \"{y}\" over \"{ y }\"."};
   }
 
   // For now, leave everything inside [dimensions] alone.
-  if (context.IsInsideFirst(
-          {NodeEnum::kDimensionRange, NodeEnum::kDimensionScalar}, {})) {
+  if (flags.in_dimensions) {
     // ... except for the spacing before '[', which is covered elsewhere.
     if (right.TokenEnum() != '[') {
       return {kUnhandledSpacesRequired,
@@ -146,7 +287,7 @@ static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
   }
 
   // Unary operators (context-sensitive)
-  if (IsUnaryPrefixExpressionOperand(left, context) &&
+  if (IsUnaryPrefixExpressionOperand(left, flags) &&
       (left.format_token_enum != FormatTokenType::binary_operator ||
        !IsUnaryOperator(static_cast<yytokentype>(right.TokenEnum())))) {
     // TODO: There are _some_ unary operators on the right that could
@@ -155,7 +296,7 @@ static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
     return {0, "Bind unary prefix operator close to its operand."};
   }
 
-  if (IsComment(FormatTokenType(right.format_token_enum))) {
+  if (pair.precedes_comment) {
     return {2, "Style: require 2+ spaces before comments"};
     // TODO(fangism): Take this from FormatStyle.
   }
@@ -179,8 +320,7 @@ static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
   // Add missing space around either side of all types of assignment operator.
   // "assign foo = bar;"  instead of "assign foo =bar;"
   // Consider assignment operators in the same class as binary operators.
-  if (left.format_token_enum == FormatTokenType::binary_operator ||
-      right.format_token_enum == FormatTokenType::binary_operator) {
+  if (pair.around_binary_operator) {
     return {1, "Space around binary and assignment operators"};
   }
 
@@ -193,15 +333,14 @@ static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
 
   // Remove any extra spaces between numeric literals' width, base and digits.
   // "16'h123, 'h123" instead of "16 'h123", "16'h 123, 'h 123"
-  if (IsInsideNumericLiteral(left, right)) {
+  if (pair.inside_numeric_literal) {
     return {0, "No space inside based numeric literals"};
   }
 
   // TODO(fangism): Never insert trailing spaces before a newline.
 
   // Hierarchy examples: "a.b", "a::b"
-  if (left.format_token_enum == FormatTokenType::hierarchy ||
-      right.format_token_enum == FormatTokenType::hierarchy)
+  if (pair.around_hierarchy)
     return {0,
             "No space separating hierarchy components "
             "(separated by . or ::)"};
@@ -228,14 +367,14 @@ static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
     // General handling of ID '(' spacing:
     if (left.format_token_enum == FormatTokenType::identifier ||
         IsKeywordCallable(yytokentype(left.TokenEnum()))) {
-      if (context.IsInside(NodeEnum::kModuleHeader)) {
+      if (flags.in_module_header) {
         return {1,
                 "Module/interface declarations: want space between ID and '('"};
       }
-      if (context.IsInside(NodeEnum::kActualNamedPort)) {
+      if (flags.in_actual_named_port) {
         return {0, "Named port: no space between ID and '('"};
       }
-      if (context.IsInside(NodeEnum::kGateInstance)) {
+      if (flags.in_gate_instance) {
         return {1, "Module instance: want space between ID and '('"};
       }
 
@@ -248,8 +387,7 @@ static WithReason<int> SpacesRequiredBetween(const PreFormatToken& left,
   if ((left.format_token_enum == FormatTokenType::keyword ||
        left.format_token_enum == FormatTokenType::identifier) &&
       right.TokenEnum() == '[') {
-    if (context.IsInsideFirst({NodeEnum::kPackedDimensions},
-                              {NodeEnum::kExpression})) {
+    if (flags.in_packed_dimensions) {
       // "type [packed...]" (space between type and packed dimensions)
       // avoid touching any expressions inside the packed dimensions
       return {1, "spacing before [packed dimensions] of declarations"};
@@ -372,7 +510,8 @@ struct SpacePolicy {
 static SpacePolicy SpacesRequiredBetween(const FormatStyle& style,
                                          const PreFormatToken& left,
                                          const PreFormatToken& right,
-                                         const SyntaxTreeContext& context) {
+                                         const SyntaxTreeContext& context,
+                                         const ContextFlags& flags) {
   // Default for unhandled cases, 1 space to be conservative.
   // TODO(fangism): return a strange value like 3 once we have covered the vast
   // majority of cases above -- then omissions will stand out clearly.
@@ -381,7 +520,7 @@ static SpacePolicy SpacesRequiredBetween(const FormatStyle& style,
   // but this is intentional; we do not actually want to reach this this final
   // return statement most of the time (in the long run).
   constexpr int kUnhandledSpacesDefault = 1;
-  const auto spaces = SpacesRequiredBetween(left, right, context);
+  const auto spaces = SpacesRequiredBetween(left, right, context, flags);
   VLOG(1) << "spaces: " << spaces.value << ", reason: " << spaces.reason;
 
   // We switch on style.preserve_horizontal_spaces even though there may be
@@ -417,10 +556,8 @@ static int BreakPenaltyBetween(const verible::PreFormatToken& left,
   // TODO(fangism): populate this.
 
   // Hierarchy examples: "a.b", "a::b"
-  // TODO(fangism): '.' is not always hierarchy, differentiate by context.
-  if (left.format_token_enum == FormatTokenType::hierarchy) return 50;
-  if (right.format_token_enum == FormatTokenType::hierarchy)
-    return 45;  // slightly prefer to break on the left
+  const TokenPairTraits& pair = GetTokenPairTraits(left, right);
+  if (pair.hierarchy_break_penalty != 0) return pair.hierarchy_break_penalty;
 
   // Prefer to split after commas than before them.
   if (right.TokenEnum() == ',') return 10;
@@ -452,10 +589,9 @@ static int BreakPenaltyBetween(const verible::PreFormatToken& left,
 // Returns decision whether to break, not break, or evaluate both choices.
 static WithReason<SpacingOptions> BreakDecisionBetween(
     const FormatStyle& style, const PreFormatToken& left,
-    const PreFormatToken& right, const SyntaxTreeContext& context) {
+    const PreFormatToken& right, const ContextFlags& flags) {
   // For now, leave everything inside [dimensions] alone.
-  if (context.IsInsideFirst(
-          {NodeEnum::kDimensionRange, NodeEnum::kDimensionScalar}, {})) {
+  if (flags.in_dimensions) {
     // ... except for the spacing immediately around '[' and ']',
     // which is covered by other rules.
     if (left.TokenEnum() != '[' && left.TokenEnum() != ']' &&
@@ -477,12 +613,12 @@ static WithReason<SpacingOptions> BreakDecisionBetween(
 
   // Unary operators (context-sensitive)
   // For now, never separate unary prefix operators from their operands.
-  if (IsUnaryPrefixExpressionOperand(left, context)) {
+  if (IsUnaryPrefixExpressionOperand(left, flags)) {
     return {SpacingOptions::MustAppend,
             "Never separate unary prefix operator from its operand"};
   }
 
-  if (IsInsideNumericLiteral(left, right)) {
+  if (GetTokenPairTraits(left, right).inside_numeric_literal) {
     return {SpacingOptions::MustAppend,
             "Never separate numeric width, base, and digits"};
   }
@@ -537,14 +673,13 @@ static void AnnotateOriginalSpacing(
   // This does not cover the spacing between the last token and EOF.
 }
 
-// Extern linkage for sake of direct testing, though not exposed in public
-// headers.
-// TODO(fangism): could move this to a -internal.h header.
-void AnnotateFormatToken(const FormatStyle& style,
-                         const PreFormatToken& prev_token,
-                         PreFormatToken* curr_token,
-                         const SyntaxTreeContext& context) {
-  const auto p = SpacesRequiredBetween(style, prev_token, *curr_token, context);
+static void AnnotateFormatToken(const FormatStyle& style,
+                                const PreFormatToken& prev_token,
+                                PreFormatToken* curr_token,
+                                const SyntaxTreeContext& context,
+                                const ContextFlags& flags) {
+  const auto p =
+      SpacesRequiredBetween(style, prev_token, *curr_token, context, flags);
   curr_token->before.spaces_required = p.spaces_required;
   if (p.force_preserve_spaces) {
     // forego all inter-token calculations
@@ -555,12 +690,23 @@ void AnnotateFormatToken(const FormatStyle& style,
     curr_token->before.break_penalty =
         BreakPenaltyBetween(prev_token, *curr_token);
     const auto breaker =
-        BreakDecisionBetween(style, prev_token, *curr_token, context);
+        BreakDecisionBetween(style, prev_token, *curr_token, flags);
     curr_token->before.break_decision = breaker.value;
     VLOG(3) << "line break constraint: " << breaker.reason;
   }
 }
 
+// Extern linkage for sake of direct testing, though not exposed in public
+// headers.
+// TODO(fangism): could move this to a -internal.h header.
+void AnnotateFormatToken(const FormatStyle& style,
+                         const PreFormatToken& prev_token,
+                         PreFormatToken* curr_token,
+                         const SyntaxTreeContext& context) {
+  AnnotateFormatToken(style, prev_token, curr_token, context,
+                      ContextFlags::FromContext(context));
+}
+
 void AnnotateFormattingInformation(
     const FormatStyle& style, const verible::TextStructureView& text_structure,
     std::vector<verible::PreFormatToken>::iterator tokens_begin,
@@ -589,13 +735,18 @@ void AnnotateFormattingInformation(
   }
 
   // Annotate inter-token information using the syntax tree for context.
+  ContextFlagsTracker context_flags;
   AnnotateFormatTokensUsingSyntaxContext(
       syntax_tree_root, eof_token, tokens_begin, tokens_end,
-      // lambda: bind the FormatStyle, forwarding all other arguments
-      [&style](const PreFormatToken& prev_token, PreFormatToken* curr_token,
-               const SyntaxTreeContext& context) {
-        AnnotateFormatToken(style, prev_token, curr_token, context);
-      });
+      // lambda: bind the FormatStyle and context flags, forwarding all other
+      // arguments
+      [&style, &context_flags](const PreFormatToken& prev_token,
+                               PreFormatToken* curr_token,
+                               const SyntaxTreeContext& context) {
+        AnnotateFormatToken(style, prev_token, curr_token, context,
+                            context_flags.Current());
+      },
+      &context_flags);
 }
 
 }  // namespace formatter
@@ -15,6 +15,8 @@
 #ifndef VERIBLE_VERILOG_FORMATTING_VERILOG_TOKEN_H_
 #define VERIBLE_VERILOG_FORMATTING_VERILOG_TOKEN_H_
 
+#include <array>
+
 #include "verilog/parser/verilog_token_enum.h"
 
 namespace verilog {
@@ -38,25 +40,66 @@ enum FormatTokenType {
   eol_comment,    // // comment
 };
 
+// Returns true if the FormatTokenType is a comment
+constexpr bool IsComment(FormatTokenType token_type) {
+  return (token_type == FormatTokenType::eol_comment ||
+          token_type == FormatTokenType::comment_block);
+}
+
+namespace internal {
+
+// Classification of a token enum, precomputed for every token enum.
+struct TokenClassification {
+  FormatTokenType format_type = FormatTokenType::unknown;
+  bool is_comment = false;
+  bool is_unary_operator = false;
+  bool is_preprocessor_control_flow = false;
+  bool is_end_keyword = false;
+};
+
+// All token enums are less than this.  (Checked in verilog_token.cc.)
+constexpr int kTokenClassificationTableSize = 1024;
+
+// Classifications indexed by token enum, built at compile time from the
+// lists in verilog_token.cc.
+extern const std::array<TokenClassification, kTokenClassificationTableSize>
+    kTokenClassifications;
+
+inline const TokenClassification& ClassifyToken(yytokentype e) {
+  static constexpr TokenClassification kUnclassified{};
+  return static_cast<unsigned>(e) < kTokenClassificationTableSize
+             ? kTokenClassifications[e]
+             : kUnclassified;
+}
+
+}  // namespace internal
+
 // Converts a leaf token enum into a FormatTokenType enum for categorizing
 // FormatTokens. This is used for determining spaces between tokens.
 // An unknown return value is an error condition the caller should handle.
-FormatTokenType GetFormatTokenType(yytokentype e);
-
-// Returns true if the FormatTokenType is a comment
-bool IsComment(FormatTokenType token_type);
+inline FormatTokenType GetFormatTokenType(yytokentype e) {
+  return internal::ClassifyToken(e).format_type;
+}
 
 // Returns true if the yytokentype is a comment
-bool IsComment(yytokentype token_type);
+inline bool IsComment(yytokentype token_type) {
+  return internal::ClassifyToken(token_type).is_comment;
+}
 
 // Returns true if token enum *can* be a unary operator.
-bool IsUnaryOperator(yytokentype);
+inline bool IsUnaryOperator(yytokentype token_type) {
+  return internal::ClassifyToken(token_type).is_unary_operator;
+}
 
 // Returns true for `ifdef, `else, etc.
-bool IsPreprocessorControlFlow(yytokentype);
+inline bool IsPreprocessorControlFlow(yytokentype token_type) {
+  return internal::ClassifyToken(token_type).is_preprocessor_control_flow;
+}
 
 // Returns true if token enum is 'end', 'endmodule', or 'end*'
-bool IsEndKeyword(yytokentype);
+inline bool IsEndKeyword(yytokentype token_type) {
+  return internal::ClassifyToken(token_type).is_end_keyword;
+}
 
 // TODO(fangism): Identify specially lexed tokens that require a newline after.
 // e.g. MacroIdItem, TK_EOL_COMMENT, ...
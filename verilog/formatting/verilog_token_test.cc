@@ -125,6 +125,19 @@ TEST(VerilogTokenTest, IsUnaryOperatorTest) {
   EXPECT_FALSE(IsUnaryOperator(yytokentype('#')));
 }
 
+// Enums outside of the classification table are never classified.
+TEST(VerilogTokenTest, OutOfRangeEnumsAreUnclassified) {
+  for (const int e : {-1, internal::kTokenClassificationTableSize,
+                      internal::kTokenClassificationTableSize + 1}) {
+    const auto token_enum = static_cast<yytokentype>(e);
+    EXPECT_EQ(GetFormatTokenType(token_enum), FTT::unknown);
+    EXPECT_FALSE(IsComment(token_enum));
+    EXPECT_FALSE(IsUnaryOperator(token_enum));
+    EXPECT_FALSE(IsPreprocessorControlFlow(token_enum));
+    EXPECT_FALSE(IsEndKeyword(token_enum));
+  }
+}
+
 }  // namespace
 }  // namespace formatter
 }  // namespace verilog
@@ -705,6 +705,13 @@ is not locally defined, so the grammar here uses only generic identifiers.
  */
 %token SemicolonEndOfAssertionVariableDeclarations ";(after-assertion-variable-decls)"
 
+/* Never produced by the lexer.  When passed as the first token, the parser
+   accepts a single expression instead of source text.
+   This lets callers parse an excerpt (e.g. a macro call argument) as an
+   expression without wrapping it in other code.
+ */
+%token ExpressionEntryPoint "<<expression-entry-point>>"
+
 // right-associative modify-assignment operators
 %right TK_PLUS_EQ
 %right TK_MINUS_EQ
@@ -755,6 +762,8 @@ is not locally defined, so the grammar here uses only generic identifiers.
 source_text
   : description_list
     { param->SetRoot(move($1)); }
+  | ExpressionEntryPoint expression
+    { param->SetRoot(move($2)); }
   | /* empty */
     { param->SetRoot(MakeNode()); }
   ;
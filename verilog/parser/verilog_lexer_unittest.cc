@@ -16,6 +16,7 @@
 #include "verilog/parser/verilog_lexer.h"
 
 #include <initializer_list>
+#include <string>
 #include <utility>
 
 #include "gtest/gtest.h"
@@ -1686,5 +1687,27 @@ TEST(VerilogLexerTest, DirectivesUnfiltered) {
   TestLexer(kUnfilteredDirectiveTests);
 }
 
+// Input that is larger than flex's read buffer must be fed in multiple chunks,
+// and tokens must still point into the original text, also across Restart().
+TEST(VerilogLexerTest, InputLargerThanReadBuffer) {
+  constexpr int kRepeat = 10000;
+  std::string code;
+  for (int i = 0; i < kRepeat; ++i) code += "wire w;\n";
+  VerilogLexer lexer(code);
+  for (int pass = 0; pass < 2; ++pass) {
+    int wire_count = 0;
+    int expected_offset = 0;
+    for (auto token = lexer.DoNextToken(); !token.isEOF();
+         token = lexer.DoNextToken()) {
+      EXPECT_EQ(token.left(code), expected_offset);
+      expected_offset = token.right(code);
+      if (token.token_enum == TK_wire) ++wire_count;
+    }
+    EXPECT_EQ(expected_offset, static_cast<int>(code.length()));
+    EXPECT_EQ(wire_count, kRepeat);
+    lexer.Restart(code);
+  }
+}
+
 }  // namespace
 }  // namespace verilog
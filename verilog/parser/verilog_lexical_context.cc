@@ -665,6 +665,22 @@ int LexicalContext::_InterpretToken(int token_enum) const {
   return token_enum;
 }
 
+int LexicalContext::LexedTokenEnum(int token_enum) {
+  // This must undo every transformation done by _InterpretToken() and the
+  // state machines in _AdvanceToken().
+  switch (token_enum) {
+    case TK_TRIGGER:            // fall-through
+    case TK_LOGICAL_IMPLIES:    // fall-through
+    case TK_CONSTRAINT_IMPLIES:
+      return _TK_RARROW;
+    case SemicolonEndOfAssertionVariableDeclarations:
+      return ';';
+    default:
+      break;
+  }
+  return token_enum;
+}
+
 bool LexicalContext::InFlowControlHeader() const {
   if (flow_control_stack_.empty()) return false;
   return !flow_control_stack_.back().in_body;
@@ -244,6 +244,11 @@ class LexicalContext {
     }
   }
 
+  // Returns the enum that the lexer gave a token before it was re-written by
+  // TransformVerilogSymbols(), so that the token can be re-interpreted in a
+  // different context.
+  static int LexedTokenEnum(int token_enum);
+
  protected:  // Allow direct testing of some methods.
   // Reads a single token, and may alter it depending on internal state.
   void _AdvanceToken(verible::TokenInfo*);
@@ -2157,5 +2157,21 @@ endfunction : rat
   ExpectTokenSequence({TK_endfunction, ':', SymbolIdentifier});
 }
 
+// Tests that transformed tokens can be restored to their lexed enums.
+TEST(LexicalContextLexedTokenEnumTest, UndoesTransformations) {
+  constexpr int kTransformedTokens[] = {
+      TK_TRIGGER, TK_LOGICAL_IMPLIES, TK_CONSTRAINT_IMPLIES,
+      SemicolonEndOfAssertionVariableDeclarations};
+  constexpr int kLexedTokens[] = {_TK_RARROW, _TK_RARROW, _TK_RARROW, ';'};
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(LexicalContext::LexedTokenEnum(kTransformedTokens[i]),
+              kLexedTokens[i]);
+  }
+  for (const int token_enum :
+       {int(TK_module), int(SymbolIdentifier), int(';'), int(_TK_RARROW)}) {
+    EXPECT_EQ(LexicalContext::LexedTokenEnum(token_enum), token_enum);
+  }
+}
+
 }  // namespace
 }  // namespace verilog
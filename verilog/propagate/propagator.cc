@@ -1,7 +1,8 @@
 #include "verilog/propagate/propagator.h"
 
 #include <iostream>
-#include <chrono> 
+#include <memory>
+#include <utility>
 
 #include "verilog/CST/verilog_tree_print.h"
 #include "verilog/CST/verilog_nonterminals.h"
@@ -27,10 +28,11 @@ verible::SyntaxTreeLeaf *convert2Leaf(verible::SymbolPtr*& symbol) {
 	return verible::down_cast<verible::SyntaxTreeLeaf*>(symbol->get()); 
 }
 
-int Propagator::parse(const std::string &_content) {
+int Propagator::parse(std::string _content) {
 	if(_content.size() == 0) return 0;
-	content = _content;
+	content = std::make_shared<verible::StringMemBlock>(std::move(_content));
 	analyzer = verilog::VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
+	stats = analyzer->Stats();
 	const auto lex_status = analyzer->LexStatus();
 	const auto parse_status = analyzer->ParseStatus();
 
@@ -62,21 +64,23 @@ void Propagator::DependencyVisitor::Visit(const verible::SyntaxTreeNode& node) {
 }
 
 void Propagator::propagate() {
-	ResolveDependencyVisitor resolve_dependency_visitor(this);
-	analyzer->Data().SyntaxTree()->Accept(
-		&resolve_dependency_visitor,
-		&analyzer->MutableData().MutableSyntaxTree()); 
+	{
+		const auto phase = stats.Measure("resolve-dependencies");
+		ResolveDependencyVisitor resolve_dependency_visitor(this);
+		analyzer->Data().SyntaxTree()->Accept(
+			&resolve_dependency_visitor,
+			&analyzer->MutableData().MutableSyntaxTree()); 
+	}
 
 	// verilog::PrettyPrintVerilogTree(*analyzer->Data().SyntaxTree(), analyzer->Data().Contents(),
 	// 	&std::cout);	
 
-	ConstantVisitor constant_visitor;
-	// auto start = std::chrono::high_resolution_clock::now(); 
-	analyzer->Data().SyntaxTree()->Accept(
-		&constant_visitor, &analyzer->MutableData().MutableSyntaxTree()); 
-	// auto stop = std::chrono::high_resolution_clock::now(); 
-	// auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start); 
-	// std::cout << "Took: " << duration.count() << std::endl;
+	{
+		const auto phase = stats.Measure("propagate-constants");
+		ConstantVisitor constant_visitor;
+		analyzer->Data().SyntaxTree()->Accept(
+			&constant_visitor, &analyzer->MutableData().MutableSyntaxTree()); 
+	}
 }
 
 class PropagatorNode : public verible::SyntaxTreeLeaf {
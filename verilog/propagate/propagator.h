@@ -1,15 +1,18 @@
 #ifndef VERIBLE_VERILOG_PROPAGATE_PROPAGATOR_H_
 #define VERIBLE_VERILOG_PROPAGATE_PROPAGATOR_H_
 
+#include <memory>
 #include <set>
 #include <string>
 #include <iostream>
 
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/visitors.h"
 #include "common/text/text_structure.h"
+#include "common/util/phase_stats.h"
 #include "verilog/analysis/verilog_analyzer.h"
 
 namespace verilog {
@@ -51,13 +54,15 @@ public:
 		content(_propagator.getContent()),
 		dependencies(_propagator.getResolvedDependencies()) {}
 	const std::string& getFilename() const { return filename; }
-	const std::string& getContent() const { return content; }
+	const std::shared_ptr<verible::MemBlock>& getContent() const {
+		return content;
+	}
 	Propagator *clone() {
 		Propagator *_propagator = new Propagator(*this);
 		_propagator->parse();
 		return _propagator;
 	}
-	int parse(const std::string& _content="");
+	int parse(std::string _content="");
 	std::set<std::string> getDependencies() { 
 		if(got_dependencies) return dependency_visitor.getDependencies();
 		analyzer->Data().SyntaxTree()->Accept(&dependency_visitor); 
@@ -74,11 +79,15 @@ public:
 		return dependencies;
 	}
 	void propagate();
+	// Time spent analyzing and propagating, see parse() and propagate().
+	const verible::PhaseStats& getStats() const { return stats; }
 	void dump(const std::string& destination) {}
 protected:
 	std::string filename;
-	std::string content;
+	// Shared with analyzer (and clones) rather than copied.
+	std::shared_ptr<verible::MemBlock> content;
 	std::unique_ptr<verilog::VerilogAnalyzer> analyzer;
+	verible::PhaseStats stats;
 protected:
 	// Dependencies
 	bool got_dependencies = false;
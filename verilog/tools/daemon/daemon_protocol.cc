@@ -0,0 +1,140 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/daemon/daemon_protocol.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <string>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/util/status.h"
+
+namespace verilog {
+
+using verible::util::InvalidArgumentError;
+using verible::util::Status;
+using verible::util::StatusCode;
+
+Status ParseDaemonRequestHeader(absl::string_view header,
+                                DaemonRequest* request, size_t* content_size) {
+  // Split off the leading tokens, the filename is the remainder of the line.
+  request->options.clear();
+  int field = 0;
+  while (true) {
+    const size_t space = header.find(' ');
+    if (space == absl::string_view::npos) {
+      return InvalidArgumentError(
+          absl::StrCat("Incomplete request header: ", header));
+    }
+    const absl::string_view token = header.substr(0, space);
+    header.remove_prefix(space + 1);
+    if (field == 0) {
+      request->id = std::string(token);
+    } else if (field == 1) {
+      request->command = std::string(token);
+    } else {
+      const size_t equals = token.find('=');
+      if (equals != absl::string_view::npos) {
+        request->options[std::string(token.substr(0, equals))] =
+            std::string(token.substr(equals + 1));
+        continue;
+      }
+      // The first token without '=' after the command is the size.
+      request->has_content = token != "-";
+      if (request->has_content && !absl::SimpleAtoi(token, content_size)) {
+        return InvalidArgumentError(
+            absl::StrCat("Invalid request size: ", token));
+      }
+      break;
+    }
+    ++field;
+  }
+  if (header.empty()) return InvalidArgumentError("Missing request filename");
+  request->filename = std::string(header);
+  return verible::util::OkStatus();
+}
+
+bool DaemonRequestReader::Fill() {
+  // Discard consumed input.
+  buffer_.erase(0, position_);
+  position_ = 0;
+  char chunk[64 * 1024];
+  ssize_t count;
+  do {
+    count = read(fd_, chunk, sizeof(chunk));
+  } while (count < 0 && errno == EINTR);
+  if (count <= 0) return false;
+  buffer_.append(chunk, count);
+  return true;
+}
+
+Status DaemonRequestReader::Read(DaemonRequest* request) {
+  size_t newline;
+  while ((newline = buffer_.find('\n', position_)) == std::string::npos) {
+    if (!Fill()) {
+      if (position_ == buffer_.size()) {
+        return Status(StatusCode::kOutOfRange, "End of input");
+      }
+      return InvalidArgumentError("Truncated request header");
+    }
+  }
+  const absl::string_view header(buffer_.data() + position_,
+                                 newline - position_);
+  size_t content_size = 0;
+  const auto status =
+      ParseDaemonRequestHeader(header, request, &content_size);
+  position_ = newline + 1;
+  if (!status.ok()) return status;
+  if (!request->has_content) {
+    request->content.clear();
+    return status;
+  }
+  while (buffer_.size() - position_ < content_size) {
+    if (!Fill()) return InvalidArgumentError("Truncated request contents");
+  }
+  request->content = buffer_.substr(position_, content_size);
+  position_ += content_size;
+  return status;
+}
+
+// Writes all of 'data', retrying after partial writes.
+static bool WriteAll(int fd, absl::string_view data) {
+  while (!data.empty()) {
+    const ssize_t count = write(fd, data.data(), data.size());
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) return false;
+    data.remove_prefix(count);
+  }
+  return true;
+}
+
+bool WriteDaemonResponse(int fd, absl::string_view id, int status,
+                         absl::string_view output) {
+  // One write for small responses, which are the common case.
+  if (output.size() < 4096) {
+    return WriteAll(fd,
+                    absl::StrCat(id, " ", status, " ", output.size(), "\n",
+                                 output));
+  }
+  return WriteAll(fd,
+                  absl::StrCat(id, " ", status, " ", output.size(), "\n")) &&
+         WriteAll(fd, output);
+}
+
+}  // namespace verilog
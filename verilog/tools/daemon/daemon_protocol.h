@@ -0,0 +1,87 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Framing of requests and responses exchanged with verilog_daemon.
+//
+// A request is a header line, optionally followed by a buffer:
+//
+//   <id> <command> [<option>=<value> ...] <size> <filename>\n
+//   <size bytes of file contents>
+//
+// <id> is any token chosen by the client, echoed in the response, so that
+// responses to concurrent requests can be told apart.  If <size> is '-',
+// no buffer follows, and the file is read from <filename> instead.
+// <filename> extends to the end of the line, and may contain spaces.
+//
+// A response is:
+//
+//   <id> <exit status> <size>\n
+//   <size bytes of output>
+
+#ifndef VERIBLE_VERILOG_TOOLS_DAEMON_DAEMON_PROTOCOL_H_
+#define VERIBLE_VERILOG_TOOLS_DAEMON_DAEMON_PROTOCOL_H_
+
+#include <map>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/util/status.h"
+
+namespace verilog {
+
+struct DaemonRequest {
+  std::string id;
+  std::string command;
+  std::map<std::string, std::string> options;
+  std::string filename;
+
+  // If true, 'content' holds the file contents sent with the request.
+  bool has_content = false;
+  std::string content;
+};
+
+// Reads requests from a file descriptor (pipe, socket, ...), with buffering.
+class DaemonRequestReader {
+ public:
+  explicit DaemonRequestReader(int fd) : fd_(fd) {}
+
+  // Reads the next request.  Returns kOutOfRange at the end of input,
+  // and kInvalidArgument for malformed requests, after which the stream
+  // cannot be resynchronized.
+  verible::util::Status Read(DaemonRequest* request);
+
+ private:
+  // Reads more input into buffer_.  Returns false at end of input.
+  bool Fill();
+
+  const int fd_;
+
+  // Input that was read, but not yet consumed (from position_ on).
+  std::string buffer_;
+  size_t position_ = 0;
+};
+
+// Parses a request header line (without the newline).
+verible::util::Status ParseDaemonRequestHeader(absl::string_view header,
+                                               DaemonRequest* request,
+                                               size_t* content_size);
+
+// Writes one complete response to 'fd'.  Returns false on write errors.
+// Responses to one file descriptor must not be written concurrently.
+bool WriteDaemonResponse(int fd, absl::string_view id, int status,
+                         absl::string_view output);
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_TOOLS_DAEMON_DAEMON_PROTOCOL_H_
@@ -0,0 +1,174 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/daemon/daemon_protocol.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "common/util/status.h"
+
+namespace verilog {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+using verible::util::StatusCode;
+
+// Pipe that is closed on destruction.
+class TestPipe {
+ public:
+  TestPipe() { EXPECT_EQ(pipe(fds_), 0); }
+  ~TestPipe() {
+    CloseWriteEnd();
+    close(fds_[0]);
+  }
+
+  int ReadEnd() const { return fds_[0]; }
+  int WriteEnd() const { return fds_[1]; }
+
+  void Write(absl::string_view data) {
+    EXPECT_EQ(write(fds_[1], data.data(), data.size()), data.size());
+  }
+
+  void CloseWriteEnd() {
+    if (fds_[1] >= 0) close(fds_[1]);
+    fds_[1] = -1;
+  }
+
+ private:
+  int fds_[2];
+};
+
+TEST(ParseDaemonRequestHeaderTest, FileRequest) {
+  DaemonRequest request;
+  size_t size = 0;
+  EXPECT_TRUE(
+      ParseDaemonRequestHeader("7 lint - dir/a file.sv", &request, &size).ok());
+  EXPECT_EQ(request.id, "7");
+  EXPECT_EQ(request.command, "lint");
+  EXPECT_TRUE(request.options.empty());
+  EXPECT_FALSE(request.has_content);
+  EXPECT_EQ(request.filename, "dir/a file.sv");
+}
+
+TEST(ParseDaemonRequestHeaderTest, InlineRequestWithOptions) {
+  DaemonRequest request;
+  size_t size = 0;
+  EXPECT_TRUE(ParseDaemonRequestHeader(
+                  "x format column_limit=80 rules=a,-b 12 f.sv", &request,
+                  &size)
+                  .ok());
+  EXPECT_EQ(request.id, "x");
+  EXPECT_EQ(request.command, "format");
+  EXPECT_THAT(request.options,
+              ElementsAre(Pair("column_limit", "80"), Pair("rules", "a,-b")));
+  EXPECT_TRUE(request.has_content);
+  EXPECT_EQ(size, 12);
+  EXPECT_EQ(request.filename, "f.sv");
+}
+
+TEST(ParseDaemonRequestHeaderTest, Malformed) {
+  DaemonRequest request;
+  size_t size = 0;
+  for (const char* header :
+       {"", "1", "1 lint", "1 lint -", "1 lint - ", "1 lint size f.sv"}) {
+    EXPECT_EQ(ParseDaemonRequestHeader(header, &request, &size).code(),
+              StatusCode::kInvalidArgument)
+        << header;
+  }
+}
+
+TEST(DaemonRequestReaderTest, ReadsSequenceOfRequests) {
+  TestPipe pipe;
+  pipe.Write("1 syntax 5 a.sv\nhello2 lint - b.sv\n3 lint 0 c.sv\n");
+  pipe.CloseWriteEnd();
+  DaemonRequestReader reader(pipe.ReadEnd());
+  DaemonRequest request;
+
+  ASSERT_TRUE(reader.Read(&request).ok());
+  EXPECT_EQ(request.id, "1");
+  EXPECT_EQ(request.command, "syntax");
+  EXPECT_EQ(request.filename, "a.sv");
+  EXPECT_TRUE(request.has_content);
+  EXPECT_EQ(request.content, "hello");
+
+  ASSERT_TRUE(reader.Read(&request).ok());
+  EXPECT_EQ(request.id, "2");
+  EXPECT_EQ(request.filename, "b.sv");
+  EXPECT_FALSE(request.has_content);
+
+  ASSERT_TRUE(reader.Read(&request).ok());
+  EXPECT_EQ(request.id, "3");
+  EXPECT_TRUE(request.has_content);
+  EXPECT_EQ(request.content, "");
+
+  EXPECT_EQ(reader.Read(&request).code(), StatusCode::kOutOfRange);
+}
+
+TEST(DaemonRequestReaderTest, ContentMayContainNewlines) {
+  TestPipe pipe;
+  pipe.Write("1 lint 4 a.sv\n\n\n\n\n");
+  pipe.CloseWriteEnd();
+  DaemonRequestReader reader(pipe.ReadEnd());
+  DaemonRequest request;
+  ASSERT_TRUE(reader.Read(&request).ok());
+  EXPECT_EQ(request.content, "\n\n\n\n");
+  EXPECT_EQ(reader.Read(&request).code(), StatusCode::kOutOfRange);
+}
+
+TEST(DaemonRequestReaderTest, TruncatedRequests) {
+  for (const char* input : {"1 lint 4 a.sv\nabc", "1 lint - a.sv"}) {
+    TestPipe pipe;
+    pipe.Write(input);
+    pipe.CloseWriteEnd();
+    DaemonRequestReader reader(pipe.ReadEnd());
+    DaemonRequest request;
+    EXPECT_EQ(reader.Read(&request).code(), StatusCode::kInvalidArgument)
+        << input;
+  }
+}
+
+TEST(DaemonRequestReaderTest, LargeContent) {
+  // Larger than a pipe's buffer, so it has to be written concurrently.
+  const std::string content(1 << 20, 'x');
+  TestPipe pipe;
+  std::thread writer([&] {
+    pipe.Write("1 lint 1048576 a.sv\n");
+    pipe.Write(content);
+    pipe.CloseWriteEnd();
+  });
+  DaemonRequestReader reader(pipe.ReadEnd());
+  DaemonRequest request;
+  ASSERT_TRUE(reader.Read(&request).ok());
+  EXPECT_EQ(request.content, content);
+  writer.join();
+}
+
+TEST(WriteDaemonResponseTest, Framing) {
+  TestPipe pipe;
+  EXPECT_TRUE(WriteDaemonResponse(pipe.WriteEnd(), "id", 1, "out\n"));
+  pipe.CloseWriteEnd();
+  char buffer[64];
+  const ssize_t count = read(pipe.ReadEnd(), buffer, sizeof(buffer));
+  EXPECT_EQ(absl::string_view(buffer, count), "id 1 4\nout\n");
+}
+
+}  // namespace
+}  // namespace verilog
@@ -0,0 +1,216 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/daemon/daemon_server.h"
+
+#include <unistd.h>
+
+#include <memory>
+#include <mutex>  // IWYU pragma: keep
+#include <sstream>  // IWYU pragma: keep  // for ostringstream
+#include <string>
+#include <utility>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/strings/mem_block.h"
+#include "common/util/file_util.h"
+#include "common/util/logging.h"
+#include "common/util/status.h"
+#include "common/util/thread_pool.h"
+#include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/analysis/verilog_linter.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/formatting/format_style.h"
+#include "verilog/formatting/formatter.h"
+#include "verilog/tools/daemon/daemon_protocol.h"
+
+namespace verilog {
+
+using formatter::FormatStyle;
+using formatter::Formatter;
+using verible::util::StatusCode;
+
+// Returns the diagnostic for an option of 'request' that is unknown, or
+// whose value is invalid.
+static std::string InvalidOption(const DaemonRequest& request,
+                                 const std::string& name,
+                                 absl::string_view error = "") {
+  return absl::StrCat("Invalid option ", name, " of ", request.command, ". ",
+                      error, "\n");
+}
+
+static int Lint(const DaemonRequest& request, const DaemonServerConfig& config,
+                std::shared_ptr<verible::MemBlock> content,
+                std::string* output) {
+  bool parse_fatal = false;
+  bool lint_fatal = false;
+  RuleBundle rules;
+  for (const auto& option : request.options) {
+    std::string error;
+    bool valid = false;
+    if (option.first == "parse_fatal") {
+      valid = absl::SimpleAtob(option.second, &parse_fatal);
+    } else if (option.first == "lint_fatal") {
+      valid = absl::SimpleAtob(option.second, &lint_fatal);
+    } else if (option.first == "rules") {
+      valid = AbslParseFlag(option.second, &rules, &error);
+    }
+    if (!valid) {
+      *output = InvalidOption(request, option.first, error);
+      return 2;
+    }
+  }
+  LinterConfiguration lint_config(config.lint_config);
+  lint_config.UseRuleBundle(rules);
+  std::ostringstream stream;
+  const int status = LintOneFile(&stream, request.filename, std::move(content),
+                                 lint_config, parse_fatal, lint_fatal);
+  *output = stream.str();
+  return status;
+}
+
+static int Format(const DaemonRequest& request,
+                  const DaemonServerConfig& config,
+                  std::shared_ptr<verible::MemBlock> content,
+                  std::string* output) {
+  FormatStyle style(config.format_style);
+  Formatter::ExecutionControl control(config.format_control);
+  for (const auto& option : request.options) {
+    std::string error;
+    bool valid = false;
+    if (option.first == "max_search_states") {
+      valid = absl::SimpleAtoi(option.second, &control.max_search_states);
+    } else if (option.first == "verify") {
+      valid = formatter::AbslParseFlag(option.second, &control.verify, &error);
+    } else {
+      valid = style.SetField(option.first, option.second, &error);
+    }
+    if (!valid) {
+      *output = InvalidOption(request, option.first, error);
+      return 2;
+    }
+  }
+  std::ostringstream stream;
+  const auto status = formatter::FormatVerilog(
+      std::move(content), request.filename, style, stream, control);
+  if (!status.ok()) {
+    *output = absl::StrCat(status.message(), "\n");
+    return 1;
+  }
+  *output = stream.str();
+  return 0;
+}
+
+static int Syntax(const DaemonRequest& request,
+                  std::shared_ptr<verible::MemBlock> content,
+                  std::string* output) {
+  if (!request.options.empty()) {
+    *output = InvalidOption(request, request.options.begin()->first);
+    return 2;
+  }
+  const auto analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(
+      std::move(content), request.filename);
+  if (ABSL_DIE_IF_NULL(analyzer)->LexStatus().ok() &&
+      analyzer->ParseStatus().ok()) {
+    return 0;
+  }
+  for (const auto& message : analyzer->LinterTokenErrorMessages()) {
+    absl::StrAppend(output, message, "\n");
+  }
+  return 1;
+}
+
+int HandleDaemonRequest(DaemonRequest* request,
+                        const DaemonServerConfig& config,
+                        std::string* output) {
+  std::shared_ptr<verible::MemBlock> content;
+  if (request->has_content) {
+    content =
+        std::make_shared<verible::StringMemBlock>(std::move(request->content));
+  } else {
+    content = verible::file::GetContentAsMemBlock(request->filename);
+    if (content == nullptr) {
+      *output = absl::StrCat("Cannot read ", request->filename, "\n");
+      return 2;
+    }
+  }
+  if (request->command == "lint") {
+    return Lint(*request, config, std::move(content), output);
+  }
+  if (request->command == "format") {
+    return Format(*request, config, std::move(content), output);
+  }
+  if (request->command == "syntax") {
+    return Syntax(*request, std::move(content), output);
+  }
+  *output = absl::StrCat("Unknown command: ", request->command, "\n");
+  return 2;
+}
+
+namespace {
+
+// A client's input and output.  Shared by the requests in flight, so that
+// responses can still be written after the client closed its input.
+class Connection {
+ public:
+  Connection(int in_fd, int out_fd, bool owns_fds)
+      : in_fd_(in_fd), out_fd_(out_fd), owns_fds_(owns_fds) {}
+
+  ~Connection() {
+    if (!owns_fds_) return;
+    close(in_fd_);
+    if (out_fd_ != in_fd_) close(out_fd_);
+  }
+
+  // Writes a response.  Safe to call from any thread.
+  void Respond(absl::string_view id, int status, absl::string_view output) {
+    const std::lock_guard<std::mutex> lock(write_mutex_);
+    // The client may have gone away, which is its business.
+    WriteDaemonResponse(out_fd_, id, status, output);
+  }
+
+ private:
+  const int in_fd_;
+  const int out_fd_;
+  const bool owns_fds_;
+  std::mutex write_mutex_;
+};
+
+}  // namespace
+
+void ServeDaemonClient(int in_fd, int out_fd, bool owns_fds,
+                       const DaemonServerConfig& config,
+                       verible::ThreadPool* pool) {
+  const auto connection = std::make_shared<Connection>(in_fd, out_fd, owns_fds);
+  DaemonRequestReader reader(in_fd);
+  while (true) {
+    auto request = std::make_shared<DaemonRequest>();
+    const auto status = reader.Read(request.get());
+    if (status.code() == StatusCode::kOutOfRange) return;
+    if (!status.ok()) {
+      connection->Respond("-", 2, absl::StrCat(status.message(), "\n"));
+      return;
+    }
+    pool->Schedule([connection, request, &config] {
+      std::string output;
+      const int exit_status =
+          HandleDaemonRequest(request.get(), config, &output);
+      connection->Respond(request->id, exit_status, output);
+    });
+  }
+}
+
+}  // namespace verilog
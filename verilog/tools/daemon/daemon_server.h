@@ -0,0 +1,68 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Request handling of verilog_daemon, independent of how clients connect.
+//
+// Commands and their per-request options are:
+//   lint    parse_fatal=BOOL lint_fatal=BOOL rules=RULES
+//           (like the verilog_lint flags of the same name, where 'rules'
+//           applies on top of the configuration from flags at start-up)
+//   format  indentation_spaces=N wrap_spaces=N column_limit=N
+//           over_column_limit_penalty=N max_search_states=N
+//           preserve_hspaces=MODE preserve_vspaces=MODE verify=MODE
+//           (style options are the fields of FormatStyle::ForEachField();
+//           the output is the formatted code, if the status is 0)
+//   syntax  (no options)
+// Exit status of a request is 0 on success, 1 if problems were found (like
+// the corresponding tool), and 2 for invalid requests.
+
+#ifndef VERIBLE_VERILOG_TOOLS_DAEMON_DAEMON_SERVER_H_
+#define VERIBLE_VERILOG_TOOLS_DAEMON_DAEMON_SERVER_H_
+
+#include <string>
+
+#include "common/util/thread_pool.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/formatting/format_style.h"
+#include "verilog/formatting/formatter.h"
+#include "verilog/tools/daemon/daemon_protocol.h"
+
+namespace verilog {
+
+// Settings established once at start-up, shared by all requests.
+struct DaemonServerConfig {
+  LinterConfiguration lint_config;
+  formatter::FormatStyle format_style;
+  formatter::Formatter::ExecutionControl format_control;
+};
+
+// Processes one request, and returns its exit status.
+// Diagnostics (or formatted code) are returned in 'output'.
+int HandleDaemonRequest(DaemonRequest* request,
+                        const DaemonServerConfig& config,
+                        std::string* output);
+
+// Reads requests from 'in_fd' until its end, and schedules them on 'pool'.
+// Responses are written to 'out_fd' as requests complete, so they may arrive
+// in a different order.  A malformed request is answered with id '-', and
+// ends reading.  If 'owns_fds', the descriptors are closed once the last
+// request in flight has been answered.
+// 'config' and 'pool' must outlive all scheduled requests.
+void ServeDaemonClient(int in_fd, int out_fd, bool owns_fds,
+                       const DaemonServerConfig& config,
+                       verible::ThreadPool* pool);
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_TOOLS_DAEMON_DAEMON_SERVER_H_
@@ -0,0 +1,210 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/tools/daemon/daemon_server.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "common/util/file_util.h"
+#include "common/util/thread_pool.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/tools/daemon/daemon_protocol.h"
+
+namespace verilog {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+using verible::file::testing::ScopedTestFile;
+
+struct Response {
+  int status = -1;
+  std::string output;
+};
+
+// Serves 'requests' (the raw byte stream a client would send) over a
+// socketpair, and returns the responses, keyed by request id.
+std::map<std::string, Response> Serve(absl::string_view requests) {
+  int fds[2];
+  EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  const int client_fd = fds[0];
+  const int server_fd = fds[1];
+  // Small requests fit in the socket buffer, so the client can send all
+  // of them up front, without a thread of its own.
+  EXPECT_EQ(write(client_fd, requests.data(), requests.size()),
+            requests.size());
+  EXPECT_EQ(shutdown(client_fd, SHUT_WR), 0);
+
+  DaemonServerConfig config;
+  config.lint_config.UseRuleSet(RuleSet::kDefault);
+  {
+    verible::ThreadPool pool(2);
+    // Takes ownership of 'server_fd', which is closed after the last
+    // response, so that the client sees the end of output.
+    ServeDaemonClient(server_fd, server_fd, true, config, &pool);
+  }  // Waits for all requests.
+
+  std::string received;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read(client_fd, buffer, sizeof(buffer))) > 0) {
+    received.append(buffer, n);
+  }
+  close(client_fd);
+
+  // Each response is "<id> <status> <size>\n<output>".
+  std::map<std::string, Response> responses;
+  absl::string_view rest(received);
+  while (!rest.empty()) {
+    const size_t newline = rest.find('\n');
+    if (newline == absl::string_view::npos) {
+      ADD_FAILURE() << "Truncated response: " << rest;
+      break;
+    }
+    const std::vector<absl::string_view> fields =
+        absl::StrSplit(rest.substr(0, newline), ' ');
+    rest.remove_prefix(newline + 1);
+    size_t size = 0;
+    Response response;
+    if (fields.size() != 3 || !absl::SimpleAtoi(fields[1], &response.status) ||
+        !absl::SimpleAtoi(fields[2], &size) || size > rest.size()) {
+      ADD_FAILURE() << "Malformed response: " << received;
+      break;
+    }
+    response.output = std::string(rest.substr(0, size));
+    rest.remove_prefix(size);
+    EXPECT_TRUE(responses.emplace(std::string(fields[0]), response).second)
+        << "Duplicate response id: " << fields[0];
+  }
+  return responses;
+}
+
+// Returns a request that sends 'content' along with the header.
+std::string InlineRequest(absl::string_view header_prefix,
+                          absl::string_view content) {
+  return absl::StrCat(header_prefix, " ", content.size(), " t.sv\n", content);
+}
+
+TEST(DaemonServerTest, NoRequests) { EXPECT_TRUE(Serve("").empty()); }
+
+TEST(DaemonServerTest, Lint) {
+  constexpr absl::string_view kClean = "class foo;\nendclass : foo\n";
+  constexpr absl::string_view kForbidden =
+      "task automatic foo;\n"
+      "  $psprintf(\"blah\");\n"  // forbidden function
+      "endtask\n";
+  const auto responses = Serve(absl::StrCat(
+      InlineRequest("clean lint lint_fatal=true", kClean),
+      InlineRequest("tolerated lint", kForbidden),
+      InlineRequest("fatal lint lint_fatal=true", kForbidden),
+      InlineRequest("disabled lint lint_fatal=true "
+                    "rules=-invalid-system-task-function",
+                    kForbidden),
+      InlineRequest("bad lint lint_fatal=maybe", kClean)));
+  ASSERT_EQ(responses.size(), 5);
+  EXPECT_EQ(responses.at("clean").status, 0);
+  EXPECT_EQ(responses.at("clean").output, "");
+  EXPECT_EQ(responses.at("tolerated").status, 0);
+  EXPECT_THAT(responses.at("tolerated").output, StartsWith("t.sv:2:"));
+  EXPECT_EQ(responses.at("fatal").status, 1);
+  EXPECT_THAT(responses.at("fatal").output, StartsWith("t.sv:2:"));
+  EXPECT_EQ(responses.at("disabled").status, 0);
+  EXPECT_EQ(responses.at("disabled").output, "");
+  EXPECT_EQ(responses.at("bad").status, 2);
+  EXPECT_THAT(responses.at("bad").output,
+              HasSubstr("Invalid option lint_fatal"));
+}
+
+TEST(DaemonServerTest, Format) {
+  const auto responses = Serve(absl::StrCat(
+      InlineRequest("plain format", "module foo;endmodule:foo\n"),
+      InlineRequest("verified format verify=full",
+                    "module foo;endmodule:foo\n"),
+      InlineRequest("invalid format", "module foo(;\n"),
+      InlineRequest("bad format column_limit=wide", "module foo;\n")));
+  ASSERT_EQ(responses.size(), 4);
+  EXPECT_EQ(responses.at("plain").status, 0);
+  EXPECT_EQ(responses.at("plain").output, "module foo;\nendmodule : foo\n");
+  EXPECT_EQ(responses.at("verified").status, 0);
+  EXPECT_EQ(responses.at("verified").output,
+            "module foo;\nendmodule : foo\n");
+  EXPECT_EQ(responses.at("invalid").status, 1);
+  EXPECT_NE(responses.at("invalid").output, "");
+  EXPECT_EQ(responses.at("bad").status, 2);
+  EXPECT_THAT(responses.at("bad").output,
+              HasSubstr("Invalid option column_limit"));
+}
+
+TEST(DaemonServerTest, Syntax) {
+  const auto responses = Serve(
+      absl::StrCat(InlineRequest("valid syntax", "module foo;\nendmodule\n"),
+                   InlineRequest("invalid syntax", "module foo(;\n"),
+                   InlineRequest("bad syntax strict=1", "")));
+  ASSERT_EQ(responses.size(), 3);
+  EXPECT_EQ(responses.at("valid").status, 0);
+  EXPECT_EQ(responses.at("valid").output, "");
+  EXPECT_EQ(responses.at("invalid").status, 1);
+  EXPECT_THAT(responses.at("invalid").output, StartsWith("t.sv:1:"));
+  EXPECT_EQ(responses.at("bad").status, 2);
+  EXPECT_THAT(responses.at("bad").output, HasSubstr("Invalid option strict"));
+}
+
+// Files named in requests are read by the server.
+TEST(DaemonServerTest, ReadsFiles) {
+  const ScopedTestFile file(testing::TempDir(), "module foo;endmodule:foo\n");
+  const std::string missing = absl::StrCat(file.filename(), ".missing");
+  const auto responses =
+      Serve(absl::StrCat("found format - ", file.filename(), "\n",
+                         "missing syntax - ", missing, "\n"));
+  ASSERT_EQ(responses.size(), 2);
+  EXPECT_EQ(responses.at("found").status, 0);
+  EXPECT_EQ(responses.at("found").output, "module foo;\nendmodule : foo\n");
+  EXPECT_EQ(responses.at("missing").status, 2);
+  EXPECT_EQ(responses.at("missing").output,
+            absl::StrCat("Cannot read ", missing, "\n"));
+}
+
+TEST(DaemonServerTest, UnknownCommand) {
+  const auto responses = Serve(InlineRequest("7 compile", "module foo;\n"));
+  ASSERT_EQ(responses.size(), 1);
+  EXPECT_EQ(responses.at("7").status, 2);
+  EXPECT_EQ(responses.at("7").output, "Unknown command: compile\n");
+}
+
+// A malformed request is answered with id '-', while the requests before it
+// are still processed, and ends the session.
+TEST(DaemonServerTest, MalformedRequest) {
+  const auto responses =
+      Serve(absl::StrCat(InlineRequest("1 syntax", "module foo;\nendmodule\n"),
+                         "2 syntax\n",  // no size and filename
+                         InlineRequest("3 syntax", "")));
+  ASSERT_EQ(responses.size(), 2);
+  EXPECT_EQ(responses.at("1").status, 0);
+  EXPECT_EQ(responses.at("-").status, 2);
+  EXPECT_NE(responses.at("-").output, "");
+}
+
+}  // namespace
+}  // namespace verilog
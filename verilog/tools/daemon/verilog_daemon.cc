@@ -0,0 +1,163 @@
+// Copyright 2017-2019 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// verilog_daemon is a long-lived server that lints, formats and checks
+// syntax of Verilog files on request, to avoid the start-up cost of running
+// verilog_lint, verilog_format or verilog_syntax for every file, e.g. from
+// editor integrations.
+//
+// Example usage:
+// verilog_daemon  # serve requests on stdin, respond on stdout
+// verilog_daemon --socket=/tmp/verilog.sock  # serve clients of a socket
+//
+// See daemon_protocol.h for the request and response format.
+// Commands, their options and exit statuses are listed in daemon_server.h.
+// Requests are processed concurrently, so responses may arrive in a
+// different order.  A malformed request is answered with id '-', and the
+// connection is closed.
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/strings/str_cat.h"
+#include "common/util/logging.h"
+#include "common/util/thread_pool.h"
+#include "verilog/analysis/verilog_linter.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/formatting/format_style.h"
+#include "verilog/tools/daemon/daemon_server.h"
+
+ABSL_FLAG(std::string, socket, "",
+          "If non-empty, path of a Unix domain socket to listen on for "
+          "clients.  A socket left there by a server that is gone is "
+          "replaced; any other existing file is an error.  Otherwise, "
+          "requests are read from stdin, and responses are written to "
+          "stdout.");
+ABSL_FLAG(int, jobs, 0,
+          "Number of requests to process concurrently.  0 means one per "
+          "hardware thread.");
+
+using verilog::DaemonServerConfig;
+
+// Removes a socket at 'path' left behind by a server that is gone, so that
+// it can be bound again.  Returns false (after logging why) if 'path' is
+// anything but a socket, or if a server still accepts connections on it.
+static bool RemoveStaleSocket(const std::string& path,
+                              const sockaddr_un& address) {
+  struct stat path_stat;
+  if (lstat(path.c_str(), &path_stat) != 0) {
+    if (errno == ENOENT) return true;
+    LOG(ERROR) << "Cannot access " << path << ": " << strerror(errno);
+    return false;
+  }
+  if (!S_ISSOCK(path_stat.st_mode)) {
+    LOG(ERROR) << path << " exists, and is not a socket.";
+    return false;
+  }
+  const int probe_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (probe_fd < 0) {
+    LOG(ERROR) << "Cannot create socket: " << strerror(errno);
+    return false;
+  }
+  const bool in_use =
+      connect(probe_fd, reinterpret_cast<const sockaddr*>(&address),
+              sizeof(address)) == 0;
+  close(probe_fd);
+  if (in_use) {
+    LOG(ERROR) << "Another server is listening on " << path;
+    return false;
+  }
+  if (unlink(path.c_str()) != 0) {
+    LOG(ERROR) << "Cannot remove stale socket " << path << ": "
+               << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+// Accepts clients on a Unix domain socket at 'path', forever.
+// Returns only if the socket cannot be set up.
+static int ServeSocket(const std::string& path,
+                       const DaemonServerConfig& config,
+                       verible::ThreadPool* pool) {
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    LOG(ERROR) << "Socket path is too long: " << path;
+    return 1;
+  }
+  strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  if (!RemoveStaleSocket(path, address)) return 1;
+  const int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0 ||
+      bind(listen_fd, reinterpret_cast<const sockaddr*>(&address),
+           sizeof(address)) != 0 ||
+      listen(listen_fd, SOMAXCONN) != 0) {
+    LOG(ERROR) << "Cannot listen on " << path << ": " << strerror(errno);
+    return 1;
+  }
+  while (true) {
+    const int client_fd = accept(listen_fd, nullptr, nullptr);
+    if (client_fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      LOG(ERROR) << "Cannot accept clients: " << strerror(errno);
+      close(listen_fd);
+      return 1;
+    }
+    // Each client's requests are read by a thread of its own, because
+    // reading blocks; the requests themselves are processed by the pool.
+    std::thread([client_fd, &config, pool] {
+      verilog::ServeDaemonClient(client_fd, client_fd, true, config, pool);
+    }).detach();
+  }
+}
+
+int main(int argc, char** argv) {
+  absl::SetProgramUsageMessage(
+      absl::StrCat("usage: ", argv[0], " [options]"));
+  absl::ParseCommandLine(argc, argv);
+
+  // Writing to a client that went away must not terminate the server.
+  signal(SIGPIPE, SIG_IGN);
+
+  // Lint rules are registered, and flags are parsed only once, here.
+  DaemonServerConfig config;
+  config.lint_config = verilog::LinterConfigurationFromFlags();
+  // Same defaults as verilog_format's flags.
+  config.format_style.preserve_vertical_spaces =
+      verilog::formatter::PreserveSpaces::UnhandledCasesOnly;
+  config.format_control.max_search_states = 100000;
+
+  int jobs = absl::GetFlag(FLAGS_jobs);
+  if (jobs <= 0) jobs = verible::ThreadPool::HardwareConcurrency();
+  // Declared after 'config', so that all requests finish before it goes away.
+  verible::ThreadPool pool(jobs);
+
+  const std::string socket_path = absl::GetFlag(FLAGS_socket);
+  if (!socket_path.empty()) return ServeSocket(socket_path, config, &pool);
+
+  verilog::ServeDaemonClient(STDIN_FILENO, STDOUT_FILENO, false, config, &pool);
+  return 0;
+}
@@ -13,16 +13,24 @@
 // limitations under the License.
 
 // verilog_format is a command-line utility to format verilog source code
-// for a given file.
+// for the given files.
 //
 // Example usage:
 // verilog_format original-file > new-file
+// verilog_format --inplace --jobs=0 files-or-dirs...  # format in parallel
+// verilog_format --check files-or-dirs...  # list files that would change
+// verilog_format --cache_dir=DIR --inplace file  # skip unchanged files
+//
+// Directories are searched recursively for Verilog source files.
 //
 // Exit code:
 //   0: stdout output can be used to replace original file
+//      (with --check: no file would change)
 //   nonzero: stdout output (if any) should be discarded
+//      (with --check: some file would change, or could not be formatted)
 
-#include <fstream>
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
@@ -32,25 +40,38 @@
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
-#include "common/text/text_structure.h"
+#include "absl/synchronization/notification.h"
+#include "common/strings/mem_block.h"
 #include "common/util/file_util.h"
 #include "common/util/logging.h"  // for operator<<, LOG, LogMessage, etc
+#include "common/util/phase_stats.h"
+#include "common/util/result_cache.h"
 #include "common/util/status.h"
-#include "verilog/analysis/verilog_analyzer.h"
+#include "common/util/thread_pool.h"
 #include "verilog/formatting/format_style.h"
 #include "verilog/formatting/formatter.h"
 
 using verible::util::StatusCode;
-using verilog::VerilogAnalyzer;
 using verilog::formatter::FormatStyle;
 using verilog::formatter::Formatter;
 using verilog::formatter::PreserveSpaces;
+using verilog::formatter::VerifyMode;
 
 // TODO(fangism): Provide -i alias, as it is canonical to many formatters
 ABSL_FLAG(bool, inplace, false,
-          "If true, overwrite the input file on successful conditions.");
+          "If true, overwrite the input files on successful conditions.  "
+          "Files are only rewritten if their formatting changes.");
+ABSL_FLAG(bool, check, false,
+          "If true, do not write any formatted output, but print the names "
+          "of files whose formatting would change, and exit nonzero if there "
+          "are any.");
+ABSL_FLAG(int, jobs, 1,
+          "Number of files to format concurrently.  0 means one per hardware "
+          "thread.  Output is always printed in command-line order.");
 
 ABSL_FLAG(int, show_largest_token_partitions, 0,
           "If > 0, print token partitioning and then "
@@ -64,6 +85,25 @@ ABSL_FLAG(bool, show_equally_optimal_wrappings, false,
 ABSL_FLAG(int, max_search_states, 100000,
           "Limits the number of search states explored during "
           "line wrap optimization.");
+ABSL_FLAG(int, wrap_search_threads, 1,
+          "Number of threads used for line wrap optimization.  0 means one "
+          "per hardware thread.  Output does not depend on this value.");
+ABSL_FLAG(VerifyMode, verify, VerifyMode::kFast,
+          "How formatted output is verified before it is written.  "
+          "'fast' compares the lexed tokens of the original and the output, "
+          "and only fully analyzes the output if they differ.  'full' always "
+          "analyzes the output fully.");
+ABSL_FLAG(verible::StatsFormat, stats, verible::StatsFormat::kNone,
+          "If not 'none', print the time spent in each phase of analysis and "
+          "formatting to stderr, as 'text' or 'json'.");
+ABSL_FLAG(std::string, cache_dir, "",
+          "If non-empty, directory of a persistent cache of formatted "
+          "output, keyed by file contents, style and formatter build.  "
+          "Cached files are not analyzed or formatted again.  "
+          "The directory may be shared by concurrent invocations.");
+ABSL_FLAG(int64_t, cache_max_bytes, verible::ResultCache::kDefaultMaxBytes,
+          "Approximate size limit of --cache_dir.  Least recently used "
+          "results are evicted first.");
 
 ABSL_FLAG(
     PreserveSpaces, preserve_hspaces, PreserveSpaces::UnhandledCasesOnly,
@@ -79,29 +119,202 @@ This only takes any effect when preserve_hspaces != all.
   all: keep original vertical spacing (newlines only, no spaces/tabs)
   unhandled: same as 'all' (for now).)");
 
-int main(int argc, char** argv) {
-  absl::SetProgramUsageMessage(
-      absl::StrCat("usage: ", argv[0], " [options] <file>"));
+// File name extensions of Verilog sources that are formatted when searching
+// directories.  Keep in sync with verilog/tools/lint/verilog_style_lint.bzl.
+static constexpr absl::string_view kVerilogExtensions[] = {".v", ".sv", ".vh",
+                                                           ".svh"};
 
-  auto file_args = absl::ParseCommandLine(argc, argv);
+static bool HasVerilogExtension(absl::string_view filename) {
+  return std::any_of(std::begin(kVerilogExtensions),
+                     std::end(kVerilogExtensions),
+                     [=](absl::string_view extension) {
+                       return absl::EndsWith(filename, extension);
+                     });
+}
 
-  // Currently accepts only one file positional argument.
-  // TODO(fangism): Support multiple file names.
-  QCHECK_GT(file_args.size(), 1)
-      << "Missing required positional argument (filename).";
-  const absl::string_view filename = file_args[1];
+// Replaces directories among 'args' with the Verilog source files found below
+// them.  Other arguments are taken as file names, regardless of extension.
+// Returns false if any directory could not be searched.
+static bool ExpandFileArguments(const std::vector<absl::string_view>& args,
+                                std::vector<std::string>* filenames) {
+  bool success = true;
+  for (const absl::string_view arg : args) {
+    if (!verible::file::IsDirectory(arg)) {
+      filenames->emplace_back(arg);
+      continue;
+    }
+    std::vector<std::string> dir_files;
+    if (!verible::file::ListFilesRecursively(arg, &dir_files)) {
+      std::cerr << "Error searching directory " << arg << std::endl;
+      success = false;
+    }
+    for (auto& dir_file : dir_files) {
+      if (HasVerilogExtension(dir_file)) {
+        filenames->push_back(std::move(dir_file));
+      }
+    }
+  }
+  return success;
+}
+
+// Settings that apply to every file.
+struct FormatFileOptions {
+  FormatStyle style;
+  Formatter::ExecutionControl control;
+  bool inplace = false;
+  bool check = false;
+  verible::ResultCache* cache = nullptr;  // optional, not owned
+};
+
+// Captures the output and exit status of formatting one file,
+// so that results from concurrent workers can be printed in order.
+struct FormatFileResult {
+  std::ostringstream output;  // destined for stdout
+  std::ostringstream errors;  // destined for stderr
+  int status = 0;
+  verible::PhaseStats stats;
+  absl::Notification done;
+};
+
+// Returns the key under which formatted output of 'content' is cached.
+// Output does not depend on the file name or number of threads.
+static std::string FormatCacheKey(absl::string_view content,
+                                  const FormatFileOptions& options) {
+  return verible::ResultCache::Key(
+      {content, options.style.Serialize(),
+       absl::StrCat(options.control.max_search_states),
+       verible::ResultCache::ToolBuildId()});
+}
+
+// Writes successfully formatted output to the result's output, or back to the
+// file, or only reports whether the file would change (--check).
+static void WriteFormattedOutput(absl::string_view filename,
+                                 absl::string_view original,
+                                 absl::string_view formatted_output,
+                                 const FormatFileOptions& options,
+                                 FormatFileResult* result) {
+  const bool changed = formatted_output != original;
+  if (options.check) {
+    if (changed) {
+      result->output << filename << std::endl;
+      result->status = 1;
+    }
+  } else if (options.inplace) {
+    // The original content may still be mapped, so the file is replaced,
+    // rather than truncated and rewritten.
+    if (changed &&
+        !verible::file::SetContentsAtomically(filename, formatted_output)) {
+      result->errors << "Error writing " << filename << std::endl;
+      result->status = 1;
+    }
+  } else {
+    result->output << formatted_output;
+  }
+}
 
+// Reads, formats and verifies one file, and writes its output.
+static void FormatOneFile(absl::string_view filename,
+                          const FormatFileOptions& options,
+                          FormatFileResult* result) {
   // Read contents into memory first.
-  std::string content;
-  if (!verible::file::GetContents(filename, &content)) return 1;
+  // The file is memory-mapped where possible, and shared with the analyzer.
+  const std::shared_ptr<verible::MemBlock> content =
+      verible::file::GetContentAsMemBlock(filename);
+  if (content == nullptr) {
+    result->errors << "Error reading " << filename << std::endl;
+    result->status = 1;
+    return;
+  }
+  const absl::string_view original = content->AsStringView();
+
+  // Only verified output of normal (non-diagnostic) runs is cached.
+  std::string cache_key;
+  if (options.cache != nullptr && !options.control.AnyStop()) {
+    cache_key = FormatCacheKey(original, options);
+    std::string cached_output;
+    bool hit;
+    {
+      const auto phase = result->stats.Measure("cache");
+      hit = options.cache->Lookup(cache_key, &cached_output);
+    }
+    if (hit) {
+      WriteFormattedOutput(filename, original, cached_output, options, result);
+      return;
+    }
+  }
+
+  // Diagnostics of this file are kept together with its output.
+  Formatter::ExecutionControl control(options.control);
+  control.stream = &result->output;
 
-  // TODO(fangism): When requesting --inplace, verify that file
-  // is write-able, and fail-early if it is not.
+  std::ostringstream stream;
+  const auto format_status = verilog::formatter::FormatVerilog(
+      content, filename, options.style, stream, control, &result->stats);
+  if (format_status.code() == StatusCode::kInvalidArgument) {
+    // Syntax errors.  Don't bother printing original code.
+    result->errors << format_status.message() << std::endl;
+    result->status = 1;
+    return;
+  }
+
+  // In any diagnostic mode, proceed no further.
+  if (control.AnyStop()) {
+    result->output << "Halting for diagnostic operation." << std::endl;
+    return;
+  }
+
+  const std::string formatted_output(stream.str());
+  if (!format_status.ok()) {
+    // Do not write back to file, leave original untouched.
+    // Print original code to stdout (in case user is redirecting output
+    // to a file, possibly the original), and rejected output to stderr.
+    result->errors << format_status.message() << std::endl;
+    result->errors << "Problematic formatter output is:\n"
+                   << formatted_output << "<<EOF>>" << std::endl;
+    if (!options.inplace && !options.check) result->output << original;
+    result->status = 1;
+    return;
+  }
+
+  // Safe to write out result, having passed verification.
+  WriteFormattedOutput(filename, original, formatted_output, options, result);
+  // Storing may fail, e.g. for lack of disk space, which is not an error.
+  if (!cache_key.empty()) options.cache->Store(cache_key, formatted_output);
+}
+
+// Prints the result of one file, and returns its exit status.
+static int PrintFormatFileResult(absl::string_view filename,
+                                 const FormatFileResult& result) {
+  std::cout << result.output.str() << std::flush;
+  std::cerr << result.errors.str() << std::flush;
+  verible::PrintPhaseStats(std::cerr, filename, result.stats,
+                           FLAGS_stats.Get());
+  return result.status;
+}
+
+int main(int argc, char** argv) {
+  absl::SetProgramUsageMessage(absl::StrCat(
+      "usage: ", argv[0], " [options] <file-or-dir> [<file-or-dir>...]"));
+
+  const auto args = absl::ParseCommandLine(argc, argv);
+  QCHECK_GT(args.size(), 1)
+      << "Missing required positional argument (filename).";
+
+  // All positional arguments are files or directories.  Exclude program name.
+  const std::vector<absl::string_view> file_args(args.begin() + 1, args.end());
+  std::vector<std::string> filenames;
+  int exit_status = ExpandFileArguments(file_args, &filenames) ? 0 : 1;
+
+  FormatFileOptions options;
+  options.inplace = FLAGS_inplace.Get();
+  options.check = FLAGS_check.Get();
+  // Formatted output of several files cannot be told apart on stdout.
+  QCHECK(filenames.size() <= 1 || options.inplace || options.check)
+      << "Formatting multiple files requires --inplace or --check.";
 
   // Handle special debugging modes.
-  Formatter::ExecutionControl formatter_control;
+  Formatter::ExecutionControl& formatter_control = options.control;
   {
-    formatter_control.stream = &std::cout;  // for diagnostics only
     formatter_control.show_largest_token_partitions =
         FLAGS_show_largest_token_partitions.Get();
     formatter_control.show_token_partition_tree =
@@ -109,118 +322,57 @@ int main(int argc, char** argv) {
     formatter_control.show_equally_optimal_wrappings =
         FLAGS_show_equally_optimal_wrappings.Get();
     formatter_control.max_search_states = FLAGS_max_search_states.Get();
+    formatter_control.num_threads = FLAGS_wrap_search_threads.Get();
+    formatter_control.verify = FLAGS_verify.Get();
   }
 
-  const std::string filename_str(filename);
-  const auto analyzer =
-      VerilogAnalyzer::AnalyzeAutomaticMode(content, filename_str);
-  {
-    // Lex and parse code.  Exit on failure.
-    const auto lex_status = ABSL_DIE_IF_NULL(analyzer)->LexStatus();
-    const auto parse_status = analyzer->ParseStatus();
-    if (!lex_status.ok() || !parse_status.ok()) {
-      const std::vector<std::string> syntax_error_messages(
-          analyzer->LinterTokenErrorMessages());
-      for (const auto& message : syntax_error_messages) {
-        std::cerr << message << std::endl;
-      }
-      // Don't bother printing original code
-      return 1;
-    }
-  }
-
-  int exit_code = 0;
-  const verible::TextStructureView& text_structure = analyzer->Data();
-  std::ostringstream stream;
+  FormatStyle& format_style = options.style;
   {
     // TODO(fangism) support style customization
-    FormatStyle format_style;
-    {
-      format_style.preserve_horizontal_spaces = FLAGS_preserve_hspaces.Get();
-      format_style.preserve_vertical_spaces = FLAGS_preserve_vspaces.Get();
-    }
-    Formatter formatter(text_structure, format_style);
-
-    // Format code.
-    verible::util::Status format_status = formatter.Format(formatter_control);
-    if (!format_status.ok()) {
-      if (format_status.code() == StatusCode::kResourceExhausted) {
-        // Allow remainder of this function to execute, and print partially
-        // formatted code, but force a non-zero exit status.
-        std::cerr << format_status.message();
-        exit_code = 1;
-      }
-    }
-
-    // In any diagnostic mode, proceed no further.
-    if (formatter_control.AnyStop()) {
-      std::cout << "Halting for diagnostic operation." << std::endl;
-      return 0;
-    }
-
-    // Render formatted result.
-    formatter.Emit(stream);
+    format_style.preserve_horizontal_spaces = FLAGS_preserve_hspaces.Get();
+    format_style.preserve_vertical_spaces = FLAGS_preserve_vspaces.Get();
   }
-  const std::string& formatted_output(stream.str());
-
-  {
-    // Verify that the formatted output creates the same lexical
-    // stream (filtered) as the original.  If any tokens were lost, fall back to
-    // printing the original source unformatted.
-    // Note: We cannot just Tokenize() and compare because Analyze()
-    // performs additional transformations like expanding MacroArgs to
-    // expression subtrees.
-    const auto reanalyzer =
-        VerilogAnalyzer::AnalyzeAutomaticMode(formatted_output, filename_str);
-    const auto relex_status = ABSL_DIE_IF_NULL(reanalyzer)->LexStatus();
-    const auto reparse_status = reanalyzer->ParseStatus();
-
-    {
-      const auto& original_tokens = text_structure.TokenStream();
-      const auto& formatted_tokens = reanalyzer->Data().TokenStream();
-      // Filter out only whitespaces and compare.
-      // First difference will be printed to cerr for debugging.
-      if (!verilog::LexicallyEquivalent(original_tokens, formatted_tokens,
-                                        &std::cerr)) {
-        std::cerr << "Formatted output is lexically different from the input.  "
-                  << "Please file a bug." << std::endl;
-        exit_code = 1;
-      }
-    }
-
-    if (!relex_status.ok() || !reparse_status.ok()) {
-      std::cerr << "Error lex/parsing-ing formatted output.  "
-                << "Please file a bug." << std::endl;
-      const auto& token_errors = reanalyzer->TokenErrorMessages();
-      // Only print the first error.
-      if (!token_errors.empty()) {
-        std::cerr << "First error: " << token_errors.front() << std::endl;
-      }
-      exit_code = 1;
-    }
 
-    // TODO(b/138868051): Verify output stability/convergence.
+  std::unique_ptr<verible::ResultCache> cache;
+  if (!FLAGS_cache_dir.Get().empty()) {
+    cache = absl::make_unique<verible::ResultCache>(
+        FLAGS_cache_dir.Get(), FLAGS_cache_max_bytes.Get());
+    options.cache = cache.get();
   }
 
-  if (exit_code != 0) {
-    // Do not write back to file, leave original untouched.
-    // Print original code to stdout (in case user is redirecting output
-    // to a file, possibly the original), and rejected output to stderr.
-    std::cerr << "Problematic formatter output is:\n"
-              << formatted_output << "<<EOF>>" << std::endl;
-    std::cout << content;
+  int jobs = FLAGS_jobs.Get();
+  if (jobs <= 0) jobs = verible::ThreadPool::HardwareConcurrency();
+  jobs = std::min(jobs, static_cast<int>(filenames.size()));
+  if (jobs <= 1) {
+    for (const auto& filename : filenames) {
+      FormatFileResult result;
+      FormatOneFile(filename, options, &result);
+      exit_status =
+          std::max(PrintFormatFileResult(filename, result), exit_status);
+    }
   } else {
-    // Safe to write out result, having passed above verification.
-    std::ostream* output_stream = &std::cout;
-    std::ofstream inplace_file;
-    if (FLAGS_inplace.Get()) {
-      inplace_file.open(filename.data());
-      if (inplace_file.good()) {
-        output_stream = &inplace_file;
-      }
+    // Each file is read, formatted and written by whichever worker claims it.
+    // vector(size) constructor requires only default constructibility.
+    std::vector<FormatFileResult> results(filenames.size());
+    verible::ThreadPool pool(jobs);
+    for (size_t i = 0; i < results.size(); ++i) {
+      const absl::string_view filename(filenames[i]);
+      FormatFileResult* result = &results[i];
+      pool.Schedule([=, &options] {
+        FormatOneFile(filename, options, result);
+        result->done.Notify();
+      });
+    }
+    // Print each file's output as soon as it and all files before it are
+    // done, to keep output deterministic.
+    for (size_t i = 0; i < results.size(); ++i) {
+      auto& result = results[i];
+      result.done.WaitForNotification();
+      exit_status =
+          std::max(PrintFormatFileResult(filenames[i], result), exit_status);
+      // Release the output of files that have been printed.
+      result.output.str(std::string());
     }
-    *output_stream << formatted_output;
   }
-
-  return exit_code;
+  return exit_status;
 }
@@ -17,7 +17,11 @@
 //
 // Example usage:
 // verilog_lint files...
+// verilog_lint --jobs=0 files...  # lint files concurrently
+// verilog_lint --cache_dir=DIR files...  # reuse results of unchanged files
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
@@ -27,11 +31,18 @@
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/notification.h"
 #include "absl/types/span.h"  // for MakeArraySlice
+#include "common/strings/mem_block.h"
+#include "common/util/file_util.h"
 #include "common/util/logging.h"  // for operator<<, LOG, LogMessage, etc
+#include "common/util/phase_stats.h"
+#include "common/util/result_cache.h"
 #include "common/util/status.h"
+#include "common/util/thread_pool.h"
 #include "verilog/analysis/verilog_linter.h"
 #include "verilog/analysis/verilog_linter_configuration.h"
 
@@ -51,9 +62,77 @@ ABSL_FLAG(
     "If true, print the description of every rule formatted for the "
     "markdown and exit immediately. Intended for the output to be written "
     "to a snippet of markdown.");
+ABSL_FLAG(int, jobs, 1,
+          "Number of files to lint concurrently.  0 means one per hardware "
+          "thread.  Diagnostics are always printed in command-line order.");
+ABSL_FLAG(verible::StatsFormat, stats, verible::StatsFormat::kNone,
+          "If not 'none', print the time spent in each phase of analysis and "
+          "linting of each file to stderr, as 'text' or 'json'.");
+ABSL_FLAG(std::string, cache_dir, "",
+          "If non-empty, directory of a persistent cache of lint results, "
+          "keyed by file contents, lint configuration and linter build.  "
+          "Files whose results are cached are not analyzed again.  "
+          "The directory may be shared by concurrent invocations.");
+ABSL_FLAG(int64_t, cache_max_bytes, verible::ResultCache::kDefaultMaxBytes,
+          "Approximate size limit of --cache_dir.  Least recently used "
+          "results are evicted first.");
 
 using verilog::LinterConfiguration;
 
+// Captures the diagnostics and exit status of linting one file,
+// so that results from concurrent workers can be printed in order.
+struct LintResult {
+  std::ostringstream output;
+  int status = 0;
+  verible::PhaseStats stats;
+  absl::Notification done;
+};
+
+// Lints one file like verilog::LintOneFile(), but reuses the cached result
+// of an earlier run on the same contents with the same settings, if any.
+static int LintOneFileCached(std::ostream* stream, absl::string_view filename,
+                             const LinterConfiguration& config,
+                             bool parse_fatal, bool lint_fatal,
+                             verible::ResultCache* cache,
+                             verible::PhaseStats* stats) {
+  if (cache == nullptr) {
+    return verilog::LintOneFile(stream, filename, config, parse_fatal,
+                                lint_fatal, stats);
+  }
+  std::shared_ptr<verible::MemBlock> content =
+      verible::file::GetContentAsMemBlock(filename);
+  if (content == nullptr) return 2;
+
+  // Diagnostics mention the file name, so it is part of the key, too.
+  std::ostringstream config_string;
+  config_string << config << parse_fatal << lint_fatal;
+  const std::string key = verible::ResultCache::Key(
+      {content->AsStringView(), config_string.str(), filename,
+       verible::ResultCache::ToolBuildId()});
+
+  // A cached result is the exit status digit, followed by the diagnostics.
+  std::string cached;
+  {
+    const auto phase = stats->Measure("cache");
+    if (cache->Lookup(key, &cached) && !cached.empty()) {
+      *stream << absl::string_view(cached).substr(1);
+      return cached[0] - '0';
+    }
+  }
+
+  std::ostringstream output;
+  const int status =
+      verilog::LintOneFile(&output, filename, std::move(content), config,
+                           parse_fatal, lint_fatal, stats);
+  *stream << output.str();
+  // Fatal errors, like failing to run the linter, are not results.
+  if (status <= 1) {
+    // Storing may fail, e.g. for lack of disk space, which is not an error.
+    cache->Store(key, absl::StrCat(status, output.str()));
+  }
+  return status;
+}
+
 int main(int argc, char** argv) {
   absl::SetProgramUsageMessage(
       absl::StrCat("usage: ", argv[0], " [options] <file> [<file>...]"));
@@ -75,18 +154,64 @@ int main(int argc, char** argv) {
   const LinterConfiguration baseline_config(
       verilog::LinterConfigurationFromFlags());
 
-  int exit_status = 0;
+  const bool parse_fatal = absl::GetFlag(FLAGS_parse_fatal);
+  const bool lint_fatal = absl::GetFlag(FLAGS_lint_fatal);
+  const verible::StatsFormat stats_format = absl::GetFlag(FLAGS_stats);
   // All positional arguments are file names.  Exclude program name.
-  for (const auto filename :
-       verible::make_range(args.begin() + 1, args.end())) {
-    // Copy configuration, so that it can be locally modified per file.
-    LinterConfiguration config(baseline_config);
-
-    const int lint_status = verilog::LintOneFile(
-        &std::cout, filename, config, absl::GetFlag(FLAGS_parse_fatal),
-        absl::GetFlag(FLAGS_lint_fatal));
-    exit_status = std::max(lint_status, exit_status);
-  }  // for each file
+  const std::vector<absl::string_view> filenames(args.begin() + 1, args.end());
+
+  std::unique_ptr<verible::ResultCache> cache;
+  const std::string cache_dir = absl::GetFlag(FLAGS_cache_dir);
+  if (!cache_dir.empty()) {
+    cache = absl::make_unique<verible::ResultCache>(
+        cache_dir, absl::GetFlag(FLAGS_cache_max_bytes));
+  }
+
+  int exit_status = 0;
+  int jobs = absl::GetFlag(FLAGS_jobs);
+  if (jobs <= 0) jobs = verible::ThreadPool::HardwareConcurrency();
+  jobs = std::min(jobs, static_cast<int>(filenames.size()));
+  if (jobs <= 1) {
+    for (const auto filename : filenames) {
+      // Copy configuration, so that it can be locally modified per file.
+      LinterConfiguration config(baseline_config);
+
+      verible::PhaseStats stats;
+      const int lint_status =
+          LintOneFileCached(&std::cout, filename, config, parse_fatal,
+                            lint_fatal, cache.get(), &stats);
+      verible::PrintPhaseStats(std::cerr, filename, stats, stats_format);
+      exit_status = std::max(lint_status, exit_status);
+    }  // for each file
+  } else {
+    // Each file is read, analyzed and linted by whichever worker claims it.
+    // vector(size) constructor requires only default constructibility.
+    std::vector<LintResult> results(filenames.size());
+    verible::ResultCache* const shared_cache = cache.get();
+    verible::ThreadPool pool(jobs);
+    for (size_t i = 0; i < results.size(); ++i) {
+      const absl::string_view filename(filenames[i]);
+      LintResult* result = &results[i];
+      pool.Schedule([=, &baseline_config] {
+        // Copy configuration, so that it can be locally modified per file.
+        LinterConfiguration config(baseline_config);
+        result->status =
+            LintOneFileCached(&result->output, filename, config, parse_fatal,
+                              lint_fatal, shared_cache, &result->stats);
+        result->done.Notify();
+      });
+    }
+    // Print each file's diagnostics as soon as it and all files before it
+    // are done, to keep output deterministic.
+    for (size_t i = 0; i < results.size(); ++i) {
+      auto& result = results[i];
+      result.done.WaitForNotification();
+      std::cout << result.output.str() << std::flush;
+      verible::PrintPhaseStats(std::cerr, filenames[i], result.stats,
+                               stats_format);
+      exit_status = std::max(result.status, exit_status);
+    }
+  }
 
   // Linter service must return 0 if it ran successfully, regardless of
   // findings.
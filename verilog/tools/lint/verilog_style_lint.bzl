@@ -38,6 +38,8 @@ _syntax_tool = "//verilog/tools/syntax:verilog_syntax"
 
 _linter_tool = "//verilog/tools/lint:verilog_lint"
 
+# Keep in sync with kVerilogExtensions in
+# verilog/tools/formatter/verilog_format.cc.
 _verilog_extensions = [
     ".v",
     ".sv",
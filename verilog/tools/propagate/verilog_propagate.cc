@@ -25,6 +25,7 @@
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
 #include <string>   // for string, allocator, etc
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "common/text/concrete_syntax_tree.h"
@@ -33,6 +34,7 @@
 #include "common/text/token_info.h"
 #include "common/util/file_util.h"
 #include "common/util/logging.h"  // for operator<<, LOG, LogMessage, etc
+#include "common/util/phase_stats.h"
 #include "common/util/status.h"
 #include "verilog/analysis/verilog_analyzer.h"
 #include "verilog/parser/verilog_parser.h"
@@ -42,6 +44,7 @@ struct args_t {
 	std::string output;
 	std::map<std::string, std::string> macros;
 	std::vector<std::string> files;
+	verible::StatsFormat stats = verible::StatsFormat::kNone;
 };
 
 std::pair<std::string, std::string> parseMacro(const std::string &macro) {
@@ -69,6 +72,13 @@ args_t parseArgs(int argc, char** argv) {
 			}
 		} else if(token.substr(0, 2).compare("-o") == 0) {
 			args.output = argv[++i];		
+		} else if(token.compare("--stats") == 0) {
+			args.stats = verible::StatsFormat::kText;
+		} else if(token.substr(0, 8).compare("--stats=") == 0) {
+			std::string error;
+			if(!verible::AbslParseFlag(token.substr(8), &args.stats, &error)) {
+				std::cerr << "Invalid --stats: " << error << std::endl;
+			}
 		} else {
 			args.files.push_back(token);
 		}
@@ -106,7 +116,7 @@ int main(int argc, char** argv) {
 		content.insert(0, macros);
 		parsed.insert(std::make_pair(filename, 
 			new verilog::propagate::Propagator(filename)));
-		if(parsed[filename]->parse(content) != 0) {
+		if(parsed[filename]->parse(std::move(content)) != 0) {
 			return 1;
 		}
 		order.push_back(filename);
@@ -137,5 +147,10 @@ int main(int argc, char** argv) {
 		std::cout << "-----------------------------" << std::endl;
 	}
 
+	for(const std::string& filename : order) {
+		verible::PrintPhaseStats(std::cerr, filename, 
+			parsed[filename]->getStats(), args.stats);
+	}
+
 	return 0;
 }
@@ -24,6 +24,7 @@
 #include <memory>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
 #include <string>   // for string, allocator, etc
+#include <utility>
 #include <vector>
 
 #include "absl/flags/flag.h"
@@ -32,12 +33,14 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"  // for MakeArraySlice
+#include "common/strings/mem_block.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/parser_verifier.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 #include "common/util/file_util.h"
 #include "common/util/logging.h"  // for operator<<, LOG, LogMessage, etc
+#include "common/util/phase_stats.h"
 #include "common/util/status.h"
 #include "verilog/CST/verilog_tree_print.h"
 #include "verilog/analysis/verilog_analyzer.h"
@@ -50,6 +53,9 @@ ABSL_FLAG(bool, printrawtokens, false,
 ABSL_FLAG(
     bool, verifytree, false,
     "Verifies that all tokens are parsed into tree, prints unmatched tokens");
+ABSL_FLAG(verible::StatsFormat, stats, verible::StatsFormat::kNone,
+          "If not 'none', print the time spent in each phase of analysis of "
+          "each file to stderr, as 'text' or 'json'.");
 
 using verible::ConcreteSyntaxTree;
 using verible::ParserVerifier;
@@ -73,12 +79,15 @@ static void VerifyParseTree(const TextStructureView& text_structure) {
   }
 }
 
-static int AnalyzeOneFile(absl::string_view content,
+static int AnalyzeOneFile(std::shared_ptr<verible::MemBlock> content,
                           absl::string_view filename) {
   int exit_status = 0;
-  const auto analyzer =
-      verilog::VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
-  const auto lex_status = ABSL_DIE_IF_NULL(analyzer)->LexStatus();
+  const auto analyzer = verilog::VerilogAnalyzer::AnalyzeAutomaticMode(
+      std::move(content), filename);
+  verible::PrintPhaseStats(std::cerr, filename,
+                           ABSL_DIE_IF_NULL(analyzer)->Stats(),
+                           absl::GetFlag(FLAGS_stats));
+  const auto lex_status = analyzer->LexStatus();
   const auto parse_status = analyzer->ParseStatus();
   if (!lex_status.ok() || !parse_status.ok()) {
     const std::vector<std::string> syntax_error_messages(
@@ -146,13 +155,14 @@ int main(int argc, char** argv) {
   // All positional arguments are file names.  Exclude program name.
   for (const auto filename :
        verible::make_range(args.begin() + 1, args.end())) {
-    std::string content;
-    if (!verible::file::GetContents(filename, &content)) {
+    std::unique_ptr<verible::MemBlock> content =
+        verible::file::GetContentAsMemBlock(filename);
+    if (content == nullptr) {
       exit_status = 1;
       continue;
     }
 
-    int file_status = AnalyzeOneFile(content, filename);
+    int file_status = AnalyzeOneFile(std::move(content), filename);
     exit_status = std::max(exit_status, file_status);
   }
   return exit_status;